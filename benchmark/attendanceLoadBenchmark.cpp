@@ -0,0 +1,232 @@
+﻿/**
+ * @file attendanceLoadBenchmark.cpp
+ * @brief Chương trình đo tốc độ tải file chấm công (số dòng/giây) của các cách tải trong AttendanceManager.
+ *
+ * Cách dùng:
+ *   attendanceLoadBenchmark [file.csv] [so_lan_lap] [so_luong_toi_da]
+ *   attendanceLoadBenchmark --generate <so_dong> <file.csv>   (sinh file giả lập cùng định dạng attendance.csv)
+ *
+ * Biên dịch cùng các file trong thư mục source/, ví dụ:
+ *   cl /O2 /std:c++17 /EHsc /I..\source attendanceLoadBenchmark.cpp ..\source\attendanceManager.cpp ..\source\attendanceParser.cpp
+ *      ..\source\attendanceCache.cpp ..\source\attendancePartitions.cpp ..\source\ingestDiagnostics.cpp ..\source\attendanceConflictIndex.cpp
+ *      ..\source\monotonicArena.cpp ..\source\employeeIdPool.cpp ..\source\mappedFile.cpp ..\source\threadPool.cpp ..\source\utils.cpp
+ */
+
+#include "../source/attendanceManager.h"
+#include "../source/attendanceCache.h"
+#include "../source/attendanceParser.h"
+#include "../source/threadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+    std::size_t g_allocationCount = 0; ///< Số lần cấp phát heap (đếm qua operator new bên dưới).
+    std::size_t g_allocatedBytes = 0;  ///< Tổng số byte đã cấp phát heap.
+
+    /**
+     * @brief Sinh file chấm công giả lập theo đúng định dạng data/attendance.csv.
+     */
+    bool generateAttendanceFile(const std::string& path, long long rows) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        static const char* prefixes[] = { "FT", "CT", "IT" };
+        static const char* dayTypes[] = { "normal", "overtime", "holiday", "leave", "leave_unpaid" };
+        static const char* shifts[][2] = { { "9:00:00", "17:00:00" }, { "17:00:00", "19:00:00" }, { "17:00:00", "23:00:00" } };
+        out << "EmployeeID,WorkDate,CheckInTime,CheckOutTime,DayType\n";
+        unsigned long long seed = 88172645463325252ULL;
+        for (long long i = 0; i < rows; ++i) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; // xorshift64
+            int emp = static_cast<int>(seed % 1000) + 1;
+            int month = static_cast<int>((seed >> 10) % 12) + 1;
+            int day = static_cast<int>((seed >> 20) % 28) + 1;
+            int shift = static_cast<int>((seed >> 30) % 3);
+            int type = static_cast<int>((seed >> 40) % 5);
+            out << prefixes[emp % 3] << std::setw(3) << std::setfill('0') << emp << ","
+                << "2025-" << std::setw(2) << month << "-" << std::setw(2) << day << ","
+                << shifts[shift][0] << "," << shifts[shift][1] << "," << dayTypes[type] << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Chạy một cách tải nhiều lần, in thời gian tốt nhất và số dòng/giây.
+     */
+    double runCase(const std::string& name, int repeat, AttendanceManager& manager, const std::function<void()>& load) {
+        double best = 1e100;
+        for (int i = 0; i < repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            load();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() < best) best = elapsed.count();
+        }
+        double rows = static_cast<double>(manager.isAggregateOnly() ? manager.getAggregatedRecordCount()
+                                                                    : manager.getRecords().size());
+        std::cout << std::left << std::setw(22) << name
+                  << std::right << std::setw(12) << static_cast<long long>(rows) << " dong"
+                  << std::setw(12) << std::fixed << std::setprecision(2) << best * 1000.0 << " ms"
+                  << std::setw(16) << std::setprecision(0) << (best > 0 ? rows / best : 0.0) << " dong/giay\n";
+        return best;
+    }
+
+    /**
+     * @brief Kiểm tra hai kho chấm công có cùng các bản ghi theo cùng thứ tự.
+     */
+    bool sameRecords(const AttendanceManager& lhs, const AttendanceManager& rhs) {
+        const auto& a = lhs.getRecords();
+        const auto& b = rhs.getRecords();
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].employeeId != b[i].employeeId || a[i].workDate != b[i].workDate
+                || a[i].checkInTime != b[i].checkInTime || a[i].checkOutTime != b[i].checkOutTime
+                || a[i].dayType != b[i].dayType) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Kiểm tra số liệu tổng hợp của kho chỉ-tổng-hợp khớp với kho đầy đủ ở mọi (nhân viên, kỳ lương).
+     */
+    bool sameSummaries(const AttendanceManager& full, const AttendanceManager& aggregate) {
+        const auto& records = full.getPackedRecords();
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            // Bản ghi đã được sắp xếp theo (nhân viên, kỳ lương): chỉ so sánh ở bản ghi đầu mỗi nhóm
+            int year = 0, month = 0, day = 0;
+            AttendanceParser::civilFromDays(records[i].workDay, year, month, day);
+            std::int32_t period = AttendanceParser::periodOf(year, month);
+            if (i > 0 && records[i - 1].employeeKey == records[i].employeeKey
+                && AttendanceParser::periodOfDay(records[i - 1].workDay) == period) {
+                continue;
+            }
+            const std::string id(full.getEmployeeIds().idOf(records[i].employeeKey));
+            AttendanceSummary a = full.summarize(id, month, year);
+            AttendanceSummary b = aggregate.summarize(id, month, year);
+            if (std::memcmp(&a, &b, sizeof(AttendanceSummary)) != 0) return false;
+        }
+        return full.getEmployeeIds().size() == aggregate.getEmployeeIds().size();
+    }
+
+    /**
+     * @brief In báo cáo bộ nhớ của kho chấm công.
+     */
+    void printMemoryReport(const std::string& title, const AttendanceMemoryReport& report) {
+        auto line = [](const char* name, std::size_t bytes) {
+            std::cout << "  " << std::left << std::setw(24) << name << std::right << std::setw(14) << bytes << " byte\n";
+        };
+        std::cout << title << " (" << report.recordCount << " ban ghi, " << report.employeeIdCount << " ma NV, "
+                  << report.employeeIdCharBytes << " byte ky tu ma NV):\n";
+        line("ban ghi nen", report.recordBytes);
+        line("bang ma nhan vien", report.employeeIdBytes);
+        line("chi muc ky luong", report.periodIndexBytes);
+        line("bang trung lap", report.conflictIndexBytes);
+        line("danh sach dang chuoi", report.recordViewBytes);
+        line("so lieu tong hop", report.summaryBytes);
+        line("tong", report.totalBytes());
+    }
+
+} // namespace
+
+// Đếm số lần cấp phát heap để thấy các lần tải lại dùng lại bộ nhớ thay vì cấp phát mới
+void* operator new(std::size_t size) {
+    ++g_allocationCount;
+    g_allocatedBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--generate") {
+        if (argc < 4) {
+            std::cerr << "Cach dung: " << argv[0] << " --generate <so_dong> <file.csv>\n";
+            return 1;
+        }
+        if (!generateAttendanceFile(argv[3], std::atoll(argv[2]))) {
+            std::cerr << "Loi: Khong the ghi file " << argv[3] << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    std::string filename = (argc >= 2) ? argv[1] : "attendance.csv";
+    int repeat = (argc >= 3) ? std::atoi(argv[2]) : 5;
+    if (repeat < 1) repeat = 1;
+    unsigned maxThreads = (argc >= 4) ? static_cast<unsigned>(std::atoi(argv[3])) : ThreadPool::resolveThreadCount(0);
+    if (maxThreads < 1) maxThreads = 1;
+
+    AttendanceManager streamManager;
+    AttendanceManager mappedManager;
+    double streamTime = runCase("getline/stringstream", repeat, streamManager, [&] { streamManager.loadFromFile(filename); });
+    double mappedTime = runCase("memory-map", repeat, mappedManager, [&] { mappedManager.loadFromFileMapped(filename); });
+
+    bool identical = sameRecords(streamManager, mappedManager);
+    std::cout << "Tang toc: " << std::setprecision(2) << (mappedTime > 0 ? streamTime / mappedTime : 0.0) << "x, "
+              << "ket qua " << (identical ? "giong nhau" : "KHAC NHAU") << "\n";
+
+    // Tải song song với số luồng tăng dần 1, 2, 4, ... đến maxThreads
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+    for (unsigned threads : threadCounts) {
+        AttendanceManager parallelManager;
+        double parallelTime = runCase("song song x" + std::to_string(threads), repeat, parallelManager,
+                                      [&] { parallelManager.loadFromFileParallel(filename, threads); });
+        bool same = sameRecords(mappedManager, parallelManager);
+        identical = identical && same;
+        std::cout << "Tang toc: " << std::setprecision(2) << (parallelTime > 0 ? streamTime / parallelTime : 0.0) << "x, "
+                  << "ket qua " << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+    }
+
+    // Cache nhị phân: lần đầu phân tích CSV và ghi cache, các lần sau đọc từ cache
+    std::remove(AttendanceCache::cachePathFor(filename).c_str());
+    AttendanceManager firstManager;
+    double firstTime = runCase("cache (lan dau)", 1, firstManager, [&] { firstManager.loadFromFileCached(filename); });
+    AttendanceManager cachedManager;
+    double cachedTime = runCase("cache (doc lai)", repeat, cachedManager, [&] { cachedManager.loadFromFileCached(filename); });
+    bool same = sameRecords(mappedManager, firstManager) && sameRecords(mappedManager, cachedManager);
+    identical = identical && same;
+    std::cout << "Tang toc: " << std::setprecision(2) << (cachedTime > 0 ? streamTime / cachedTime : 0.0) << "x"
+              << " (lan dau " << (firstTime > 0 ? streamTime / firstTime : 0.0) << "x), "
+              << "ket qua " << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+
+    // Chế độ chỉ-tổng-hợp: đọc tuần tự theo khối, không giữ bản ghi gốc
+    AttendanceManager aggregateManager;
+    double aggregateTime = runCase("chi tong hop", repeat, aggregateManager, [&] { aggregateManager.loadAggregatesFromFile(filename); });
+    same = sameSummaries(mappedManager, aggregateManager);
+    identical = identical && same;
+    std::cout << "Tang toc: " << std::setprecision(2) << (aggregateTime > 0 ? streamTime / aggregateTime : 0.0) << "x, "
+              << "so lieu tong hop " << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+
+    // Tải lại nhiều lần trong cùng một đối tượng: bộ nhớ phải được dùng lại, không tăng dần
+    AttendanceManager reloadManager;
+    reloadManager.loadFromFileMapped(filename);
+    reloadManager.getRecords();
+    printMemoryReport("Bo nho sau lan tai dau", reloadManager.memoryReport());
+    const std::size_t allocationsBefore = g_allocationCount, bytesBefore = g_allocatedBytes;
+    for (int i = 0; i < repeat; ++i) {
+        reloadManager.loadFromFileMapped(filename);
+        reloadManager.getRecords();
+    }
+    printMemoryReport("Bo nho sau " + std::to_string(repeat) + " lan tai lai", reloadManager.memoryReport());
+    std::cout << "Cap phat heap moi lan tai lai: " << (g_allocationCount - allocationsBefore) / repeat << " lan, "
+              << (g_allocatedBytes - bytesBefore) / repeat << " byte\n";
+    return identical ? 0 : 2;
+}
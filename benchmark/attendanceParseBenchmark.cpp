@@ -0,0 +1,157 @@
+﻿/**
+ * @file attendanceParseBenchmark.cpp
+ * @brief Chương trình đo tốc độ và đối chiếu kết quả của các hàm chuyển đổi cột ngày/giờ
+ * trong AttendanceParser: nhánh SWAR (parseTimes/parseDates) so với nhánh vô hướng
+ * (parseTimesScalar/parseDatesScalar) và cách đọc giờ cũ bằng std::stringstream.
+ *
+ * Cách dùng:
+ *   attendanceParseBenchmark [so_phan_tu] [so_lan_lap]
+ *
+ * Chương trình trả về 0 nếu mọi nhánh cho cùng kết quả và cùng mặt nạ phần tử không hợp lệ,
+ * 2 nếu có khác biệt.
+ *
+ * Biên dịch cùng các file trong thư mục source/, ví dụ:
+ *   cl /O2 /std:c++17 /EHsc /I..\source attendanceParseBenchmark.cpp ..\source\attendanceParser.cpp
+ */
+
+#include "../source/attendanceParser.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Cách đọc giờ cũ của AttendanceManager::timeToSeconds (dùng làm chuẩn đối chiếu).
+     */
+    std::int32_t legacyTimeToSeconds(const std::string& timeStr) {
+        if (timeStr.empty() || timeStr.find(':') == std::string::npos) {
+            return 0;
+        }
+        std::stringstream ss(timeStr);
+        int hours = 0, minutes = 0, seconds = 0;
+        char colon;
+        ss >> hours >> colon >> minutes >> colon >> seconds;
+        return hours * 3600 + minutes * 60 + seconds;
+    }
+
+    /**
+     * @brief Sinh dữ liệu giờ/ngày: phần lớn đúng định dạng, xen lẫn các giá trị biên và sai định dạng.
+     */
+    void generateSamples(std::size_t count, std::vector<std::string>& times, std::vector<std::string>& dates) {
+        static const char* oddTimes[] = { "", "24:00:00", "9:60:00", "09:00:60", "9:00", "09:00:0", " 9:00:00",
+                                          "a9:00:00", "9-00-00", "099:00:00", "-9:00:00", "23:59:59", "0:00:00",
+                                          "00:00:00", "9:0:0", "19:5:30", "\x80" "9:00:00", "9:00:00 " };
+        static const char* oddDates[] = { "", "2025-02-30", "2025-00-10", "2025-13-01", "2025-1-01", "2025/01/01",
+                                          "2025-01-32", "2025-01-00", "0000-01-01", "9999-12-31", "2025-01-0a",
+                                          "20250-1-01", "2025-01-01 ", "\xff" "025-01-01" };
+        const std::size_t oddTimeCount = sizeof(oddTimes) / sizeof(oddTimes[0]);
+        const std::size_t oddDateCount = sizeof(oddDates) / sizeof(oddDates[0]);
+
+        times.clear();
+        dates.clear();
+        unsigned long long seed = 88172645463325252ULL;
+        char buffer[32];
+        for (std::size_t i = 0; i < count; ++i) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; // xorshift64
+            if (seed % 50 == 0) {
+                times.push_back(oddTimes[(seed >> 8) % oddTimeCount]);
+                dates.push_back(oddDates[(seed >> 16) % oddDateCount]);
+                continue;
+            }
+            int hours = static_cast<int>((seed >> 8) % 24);
+            int minutes = static_cast<int>((seed >> 16) % 60);
+            int seconds = static_cast<int>((seed >> 24) % 60);
+            // Giờ có một chữ số được ghi như "9:00:00" (giống attendance.csv) hoặc "09:00:00"
+            std::snprintf(buffer, sizeof(buffer), ((seed >> 32) & 1) ? "%d:%02d:%02d" : "%02d:%02d:%02d",
+                          hours, minutes, seconds);
+            times.push_back(buffer);
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", 2000 + static_cast<int>((seed >> 36) % 50),
+                          1 + static_cast<int>((seed >> 44) % 12), 1 + static_cast<int>((seed >> 52) % 28));
+            dates.push_back(buffer);
+        }
+    }
+
+    /**
+     * @brief Chạy một hàm nhiều lần, in thời gian tốt nhất và số phần tử/giây.
+     */
+    double runCase(const std::string& name, int repeat, std::size_t count, const std::function<void()>& work) {
+        double best = 1e100;
+        for (int i = 0; i < repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            work();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() < best) best = elapsed.count();
+        }
+        std::cout << std::left << std::setw(26) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(2) << best * 1000.0 << " ms"
+                  << std::setw(16) << std::setprecision(0) << (best > 0 ? count / best : 0.0) << " phan tu/giay\n";
+        return best;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = (argc >= 2) ? static_cast<std::size_t>(std::atoll(argv[1])) : 1000000;
+    int repeat = (argc >= 3) ? std::atoi(argv[2]) : 5;
+    if (repeat < 1) repeat = 1;
+
+    std::vector<std::string> timeStrings, dateStrings;
+    generateSamples(count, timeStrings, dateStrings);
+    std::vector<std::string_view> times(timeStrings.begin(), timeStrings.end());
+    std::vector<std::string_view> dates(dateStrings.begin(), dateStrings.end());
+
+    const std::size_t words = AttendanceParser::maskWords(count);
+    std::vector<std::int32_t> swarSeconds(count), scalarSeconds(count), legacySeconds(count);
+    std::vector<AttendanceParser::CivilDate> swarDates(count), scalarDates(count);
+    std::vector<std::uint64_t> swarTimeMask(words), scalarTimeMask(words), swarDateMask(words), scalarDateMask(words);
+    std::size_t invalidTimes = 0, invalidDates = 0;
+
+    runCase("gio: stringstream (cu)", repeat, count, [&] {
+        for (std::size_t i = 0; i < count; ++i) legacySeconds[i] = legacyTimeToSeconds(timeStrings[i]);
+    });
+    runCase("gio: vo huong", repeat, count, [&] {
+        AttendanceParser::parseTimesScalar(times.data(), count, scalarSeconds.data(), scalarTimeMask.data());
+    });
+    runCase("gio: SWAR", repeat, count, [&] {
+        invalidTimes = AttendanceParser::parseTimes(times.data(), count, swarSeconds.data(), swarTimeMask.data());
+    });
+    runCase("ngay: vo huong", repeat, count, [&] {
+        AttendanceParser::parseDatesScalar(dates.data(), count, scalarDates.data(), scalarDateMask.data());
+    });
+    runCase("ngay: SWAR", repeat, count, [&] {
+        invalidDates = AttendanceParser::parseDates(dates.data(), count, swarDates.data(), swarDateMask.data());
+    });
+
+    // Đối chiếu: SWAR và vô hướng phải giống hệt (kể cả mặt nạ); phần tử hợp lệ phải khớp cách đọc cũ,
+    // phần tử không hợp lệ đọc bằng parseTime() cũng phải khớp cách đọc cũ.
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        bool timeMarked = AttendanceParser::isMarked(swarTimeMask.data(), i);
+        bool dateMarked = AttendanceParser::isMarked(swarDateMask.data(), i);
+        std::int32_t resolved = timeMarked ? AttendanceParser::parseTime(times[i]) : swarSeconds[i];
+        bool ok = swarSeconds[i] == scalarSeconds[i]
+               && timeMarked == AttendanceParser::isMarked(scalarTimeMask.data(), i)
+               && resolved == legacySeconds[i]
+               && swarDates[i].year == scalarDates[i].year && swarDates[i].month == scalarDates[i].month
+               && swarDates[i].day == scalarDates[i].day
+               && dateMarked == AttendanceParser::isMarked(scalarDateMask.data(), i);
+        if (!ok) {
+            if (mismatches < 10) {
+                std::cout << "KHAC NHAU tai " << i << ": gio \"" << timeStrings[i] << "\", ngay \"" << dateStrings[i] << "\"\n";
+            }
+            ++mismatches;
+        }
+    }
+    std::cout << "Phan tu khong hop le: gio " << invalidTimes << ", ngay " << invalidDates
+              << "; ket qua " << (mismatches == 0 ? "giong nhau" : "KHAC NHAU") << "\n";
+    return mismatches == 0 ? 0 : 2;
+}
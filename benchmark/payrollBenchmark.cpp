@@ -0,0 +1,443 @@
+﻿/**
+ * @file payrollBenchmark.cpp
+ * @brief Chương trình đo thời gian tính bảng lương cả công ty: từng nhân viên (cách cũ) so với PayrollEngine.
+ *
+ * Cách dùng:
+ *   payrollBenchmark [file.csv] [thang] [nam] [so_lan_lap] [so_luong_toi_da]
+ *   payrollBenchmark --generate <so_nhan_vien> <file.csv>   (sinh file chấm công tháng 05/2025 cho nhiều nhân viên)
+ * Danh sách nhân viên được dựng từ mọi mã nhân viên có trong file (luân phiên chính thức / hợp đồng / thực tập).
+ * Chương trình kiểm tra hai cách cho kết quả giống hệt từng bit, ở cả chế độ tải đầy đủ và chỉ-tổng-hợp,
+ * rồi đo khả năng mở rộng của PayrollEngine với số luồng 1, 2, 4, ... đến tham số thứ năm
+ * (bảng lương phải giống hệt khi tính tuần tự), và cuối cùng so sánh bảng lương cả năm
+ * (PayrollEngine::calculateYear()) với 12 lần calculateAll() theo từng tháng, đo PayrollSimulator
+ * với 256 kịch bản đơn giá (kịch bản hiện hành phải cho đúng tổng bảng lương của PayrollEngine), và đo
+ * RetroPayEngine trên lịch sử chi trả cả năm có 1% số dòng cần điều chỉnh, và xét điều kiện thưởng
+ * (BonusWelfare) từng nhân viên so với BonusWelfare::evaluateEligibility() cho cả kỳ.
+ *
+ * Biên dịch cùng các file trong thư mục source/, ví dụ:
+ *   cl /O2 /std:c++17 /EHsc /I..\source payrollBenchmark.cpp ..\source\payrollEngine.cpp ..\source\welfareManager.cpp
+ *      ..\source\bonusWelfare.cpp ..\source\socialinsuranceWelfare.cpp ..\source\transportationWelfare.cpp ..\source\IWelfare.cpp
+ *      ..\source\IEmployee.cpp ..\source\fulltimeemployee.cpp ..\source\contractualemployee.cpp ..\source\intern.cpp
+ *      ..\source\attendanceManager.cpp ..\source\attendanceParser.cpp ..\source\attendanceCache.cpp
+ *      ..\source\attendancePartitions.cpp ..\source\ingestDiagnostics.cpp ..\source\attendanceConflictIndex.cpp
+ *      ..\source\monotonicArena.cpp ..\source\employeeIdPool.cpp ..\source\mappedFile.cpp ..\source\threadPool.cpp
+ *      ..\source\payrollSimulator.cpp ..\source\salaryKernel.cpp ..\source\payRateTable.cpp ..\source\payrollHistory.cpp
+ *      ..\source\retroPayEngine.cpp ..\source\utils.cpp
+ */
+
+#include "../source/payrollEngine.h"
+#include "../source/payrollSimulator.h"
+#include "../source/payrollHistory.h"
+#include "../source/payRateTable.h"
+#include "../source/retroPayEngine.h"
+#include "../source/attendanceManager.h"
+#include "../source/welfareManager.h"
+#include "../source/bonusWelfare.h"
+#include "../source/socialinsuranceWelfare.h"
+#include "../source/transportationWelfare.h"
+#include "../source/fulltimeemployee.h"
+#include "../source/contractualemployee.h"
+#include "../source/intern.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using PayrollData = std::vector<PayrollEngine::PayrollEntry>;
+
+    /**
+     * @brief Sinh file chấm công tháng 05/2025 cho `employees` nhân viên (mỗi người khoảng 22 ngày).
+     */
+    bool generateAttendanceFile(const std::string& path, long long employees) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        static const char* prefixes[] = { "FT", "CT", "IT" };
+        out << "EmployeeID,WorkDate,CheckInTime,CheckOutTime,DayType\n";
+        for (long long emp = 1; emp <= employees; ++emp) {
+            for (int day = 1; day <= 26; ++day) {
+                if ((day + emp) % 7 == 0) continue; // Ngày nghỉ
+                const char* dayType = (day == 1) ? "holiday" : ((day + emp) % 5 == 0 ? "overtime" : "normal");
+                const char* checkIn = (dayType[0] == 'o') ? "17:00:00" : "8:00:00";
+                const char* checkOut = (dayType[0] == 'o') ? "20:30:00" : "17:00:00";
+                out << prefixes[emp % 3] << std::setw(6) << std::setfill('0') << emp << ","
+                    << "2025-05-" << std::setw(2) << day << "," << checkIn << "," << checkOut << "," << dayType << "\n";
+            }
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Dựng danh sách nhân viên từ các mã nhân viên có trong dữ liệu chấm công.
+     */
+    std::vector<std::shared_ptr<IEmployee>> makeEmployees(const AttendanceManager& attendance) {
+        static const char* districts[] = { "Quan 1 TP.HCM", "Quan 3 TP.HCM", "Quan 7 TP.HCM" };
+        std::vector<std::shared_ptr<IEmployee>> employees;
+        const EmployeeIdPool& ids = attendance.getEmployeeIds();
+        for (std::uint32_t key = 0; key < ids.size(); ++key) {
+            const std::string id(ids.idOf(key));
+            const std::string address = districts[key % 3];
+            switch (key % 3) {
+                case 0:
+                    employees.push_back(std::make_shared<FulltimeEmployee>(id, "NV " + id, address, "0900000000", "nv@cty.vn",
+                                                                           "3 nam", "31/12/2026", 8000000.0, static_cast<int>(key % 12)));
+                    break;
+                case 1:
+                    employees.push_back(std::make_shared<ContractualEmployee>(id, "NV " + id, address, "0900000000", "nv@cty.vn",
+                                                                              "Du an", "31/12/2026", 6000000.0, static_cast<int>(key % 12)));
+                    break;
+                default:
+                    employees.push_back(std::make_shared<Intern>(id, "NV " + id, address, "0900000000", "nv@cty.vn",
+                                                                 "DH", "31/12/2026", 3000000.0, static_cast<int>(key % 12)));
+                    break;
+            }
+        }
+        return employees;
+    }
+
+    /**
+     * @brief Tính bảng lương theo cách cũ: mỗi nhân viên tự tra cứu dữ liệu chấm công.
+     */
+    void perEmployeePayroll(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+                            const WelfareManager& welfareManager, int month, int year, PayrollData& payrollData) {
+        payrollData.clear();
+        for (const auto& emp : employees) {
+            Money bonuses, allowances, deductions;
+            welfareManager.calculateAllWelfareForEmployee(*emp, attendance, month, year, bonuses, allowances, deductions);
+            payrollData.push_back({ emp, emp->calculateSalary(attendance, month, year, bonuses, allowances, deductions) });
+        }
+    }
+
+    /**
+     * @brief So sánh hai bảng lương từng bit.
+     */
+    bool samePayroll(const PayrollData& a, const PayrollData& b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].first != b[i].first || std::memcmp(&a[i].second, &b[i].second, sizeof(SalaryDetails)) != 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Chạy một cách tính nhiều lần, trả về thời gian tốt nhất (giây).
+     */
+    double bestTime(int repeat, const std::function<void()>& run) {
+        double best = 1e100;
+        for (int i = 0; i < repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() < best) best = elapsed.count();
+        }
+        return best;
+    }
+
+    /**
+     * @brief So sánh hai cách tính trên một AttendanceManager đã tải.
+     * @return true nếu kết quả giống hệt.
+     */
+    bool runCase(const std::string& name, const AttendanceManager& attendance, int month, int year, int repeat) {
+        WelfareManager welfareManager;
+        welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(0.105));
+        welfareManager.addWelfare(std::make_unique<BonusWelfare>(2000000.0));
+        welfareManager.addWelfare(std::make_unique<TransportationWelfare>(4000.0));
+        const auto employees = makeEmployees(attendance);
+
+        PayrollData oldData;
+        PayrollData newData;
+        PayrollEngine engine;
+        double oldTime = bestTime(repeat, [&] { perEmployeePayroll(employees, attendance, welfareManager, month, year, oldData); });
+        double newTime = bestTime(repeat, [&] { engine.calculateAll(employees, attendance, welfareManager, month, year, newData); });
+        bool same = samePayroll(oldData, newData);
+
+        std::cout << name << ": " << employees.size() << " nhan vien\n"
+                  << std::fixed << std::setprecision(3)
+                  << "  tung nhan vien: " << std::setw(10) << oldTime * 1000.0 << " ms\n"
+                  << "  PayrollEngine:  " << std::setw(10) << newTime * 1000.0 << " ms"
+                  << "  (tang toc " << std::setprecision(2) << (newTime > 0 ? oldTime / newTime : 0.0) << "x), "
+                  << "ket qua " << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+        return same;
+    }
+
+    /**
+     * @brief Đo PayrollEngine với số luồng tăng dần và so sánh với kết quả tính tuần tự.
+     * @return true nếu mọi số luồng cho bảng lương giống hệt.
+     */
+    bool runScaling(const AttendanceManager& attendance, int month, int year, int repeat, unsigned maxThreads) {
+        WelfareManager welfareManager;
+        welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(0.105));
+        welfareManager.addWelfare(std::make_unique<BonusWelfare>(2000000.0));
+        welfareManager.addWelfare(std::make_unique<TransportationWelfare>(4000.0));
+        const auto employees = makeEmployees(attendance);
+
+        std::vector<unsigned> threadCounts;
+        for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+        threadCounts.push_back(maxThreads);
+
+        std::cout << "Mo rong theo so luong (" << employees.size() << " nhan vien"
+                  << (employees.size() < PayrollEngine::PARALLEL_MIN_EMPLOYEES ? ", it hon nguong song song" : "") << "):\n";
+        PayrollData sequential;
+        double sequentialTime = 0.0;
+        bool identical = true;
+        for (unsigned threads : threadCounts) {
+            PayrollEngine engine;
+            engine.setThreadCount(threads);
+            PayrollData data;
+            double time = bestTime(repeat, [&] { engine.calculateAll(employees, attendance, welfareManager, month, year, data); });
+            if (threads == 1) {
+                sequential = data;
+                sequentialTime = time;
+            }
+            bool same = samePayroll(sequential, data);
+            identical = identical && same;
+            std::cout << "  " << std::setw(3) << threads << " luong: " << std::fixed << std::setprecision(3) << std::setw(10)
+                      << time * 1000.0 << " ms  (tang toc " << std::setprecision(2) << (time > 0 ? sequentialTime / time : 0.0)
+                      << "x), ket qua " << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+        }
+        return identical;
+    }
+
+    /**
+     * @brief Đo bảng lương cả năm bằng một lần calculateYear() so với 12 lần calculateAll().
+     * @return true nếu mọi ô của ma trận giống hệt kết quả theo tháng.
+     */
+    bool runYear(const AttendanceManager& attendance, int year, int repeat) {
+        WelfareManager welfareManager;
+        welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(0.105));
+        welfareManager.addWelfare(std::make_unique<BonusWelfare>(2000000.0));
+        welfareManager.addWelfare(std::make_unique<TransportationWelfare>(4000.0));
+        const auto employees = makeEmployees(attendance);
+
+        PayrollEngine engine;
+        std::vector<PayrollData> months(PayrollYear::MONTHS);
+        PayrollYear payrollYear;
+        double monthlyTime = bestTime(repeat, [&] {
+            for (int month = 1; month <= 12; ++month) {
+                engine.calculateAll(employees, attendance, welfareManager, month, year, months[month - 1]);
+            }
+        });
+        double yearTime = bestTime(repeat, [&] { engine.calculateYear(employees, attendance, welfareManager, year, payrollYear); });
+
+        bool same = true;
+        for (int month = 1; month <= 12 && same; ++month) {
+            const PayrollData& data = months[month - 1];
+            same = data.size() == payrollYear.employees.size();
+            for (std::size_t row = 0; same && row < data.size(); ++row) {
+                same = data[row].first == payrollYear.employees[row]
+                    && std::memcmp(&data[row].second, &payrollYear.at(row, month), sizeof(SalaryDetails)) == 0;
+            }
+        }
+
+        std::cout << "Bang luong ca nam " << year << " (" << employees.size() << " nhan vien x 12 thang):\n"
+                  << std::fixed << std::setprecision(3)
+                  << "  12 lan calculateAll: " << std::setw(10) << monthlyTime * 1000.0 << " ms\n"
+                  << "  calculateYear:       " << std::setw(10) << yearTime * 1000.0 << " ms"
+                  << "  (tang toc " << std::setprecision(2) << (yearTime > 0 ? monthlyTime / yearTime : 0.0) << "x), "
+                  << "ket qua " << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+        return same;
+    }
+
+    /**
+     * @brief Đo PayrollSimulator: kịch bản hiện hành so với tổng bảng lương của PayrollEngine,
+     * rồi thời gian đánh giá 256 kịch bản (hệ số tăng ca, đơn giá giờ, tỷ lệ BHXH thay đổi dần).
+     * @return true nếu kịch bản hiện hành cho đúng tổng của PayrollEngine.
+     */
+    bool runSimulation(const AttendanceManager& attendance, int month, int year, int repeat) {
+        WelfareManager welfareManager;
+        welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(0.105));
+        welfareManager.addWelfare(std::make_unique<BonusWelfare>(2000000.0));
+        welfareManager.addWelfare(std::make_unique<TransportationWelfare>(4000.0));
+        const auto employees = makeEmployees(attendance);
+
+        PayrollData data;
+        PayrollEngine engine;
+        engine.calculateAll(employees, attendance, welfareManager, month, year, data);
+        SalaryDetails expected;
+        for (const auto& entry : data) {
+            expected.basicSalary += entry.second.basicSalary;
+            expected.overtimeSalary += entry.second.overtimeSalary;
+            expected.holidaySalary += entry.second.holidaySalary;
+            expected.bonuses += entry.second.bonuses;
+            expected.allowances += entry.second.allowances;
+            expected.deductions += entry.second.deductions;
+            expected.totalSalary += entry.second.totalSalary;
+        }
+
+        PayrollSimulator simulator;
+        double loadTime = bestTime(repeat, [&] { simulator.load(employees, attendance, welfareManager, month, year); });
+        std::vector<PayScenario> scenarios(256, simulator.baseline());
+        for (std::size_t s = 1; s < scenarios.size(); ++s) {
+            for (PayRates& rates : scenarios[s].rates) {
+                rates.hourlyRate *= 1.0 + 0.002 * static_cast<double>(s % 16);
+                if (rates.overtimeMultiplier > 0.0) rates.overtimeMultiplier += 0.05 * static_cast<double>(s / 16);
+            }
+            scenarios[s].socialInsuranceRate += 0.001 * static_cast<double>(s % 8);
+        }
+        std::vector<ScenarioResult> results;
+        double evaluateTime = bestTime(repeat, [&] { simulator.evaluate(scenarios, results); });
+        bool same = std::memcmp(&results.front().total, &expected, sizeof(SalaryDetails)) == 0;
+
+        std::cout << "Mo phong " << scenarios.size() << " kich ban (" << simulator.getEmployeeCount() << " nhan vien):\n"
+                  << std::fixed << std::setprecision(3)
+                  << "  tong hop theo cot: " << std::setw(10) << loadTime * 1000.0 << " ms\n"
+                  << "  danh gia:          " << std::setw(10) << evaluateTime * 1000.0 << " ms  ("
+                  << std::setprecision(1) << evaluateTime * 1e9 / (static_cast<double>(scenarios.size()) * simulator.getEmployeeCount())
+                  << " ns/nhan vien/kich ban), kich ban hien hanh "
+                  << (same ? "giong PayrollEngine" : "KHAC PayrollEngine") << "\n";
+        return same;
+    }
+
+    /**
+     * @brief Đo RetroPayEngine: lịch sử chi trả cả năm (từ calculateYear()) được ghi ra file và đọc lại,
+     * 1% số dòng bị sửa như thể đã trả theo dữ liệu cũ (trả thiếu 1.000 đồng, dấu vân tay khác).
+     * @return true nếu đúng các dòng bị sửa được tính lại, với chênh lệch đúng 1.000 đồng mỗi dòng.
+     */
+    bool runRetro(const AttendanceManager& attendance, int year, int repeat) {
+        WelfareManager welfareManager;
+        welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(0.105));
+        welfareManager.addWelfare(std::make_unique<BonusWelfare>(2000000.0));
+        welfareManager.addWelfare(std::make_unique<TransportationWelfare>(4000.0));
+        const auto employees = makeEmployees(attendance);
+
+        // 1. Lịch sử chi trả của cả năm, 1% số dòng bị sửa
+        PayrollEngine engine;
+        PayrollYear payrollYear;
+        engine.calculateYear(employees, attendance, welfareManager, year, payrollYear);
+        std::vector<AttendanceSummary> summaries;
+        attendance.summarizeYear(year, summaries);
+        const EmployeeIdPool& ids = attendance.getEmployeeIds();
+        const AttendanceSummary empty;
+        const std::uint64_t rateFingerprint = PayrollHistory::rateFingerprint(PayRateTable::active());
+        PayrollHistory history;
+        std::size_t modified = 0;
+        for (int month = 1; month <= 12; ++month) {
+            std::vector<PaidPayroll> paid(payrollYear.employees.size());
+            for (std::size_t row = 0; row < paid.size(); ++row) {
+                const IEmployee& emp = *payrollYear.employees[row];
+                const std::uint32_t key = ids.find(emp.getEmployeeId());
+                paid[row].employeeId = emp.getEmployeeId();
+                paid[row].attendanceFingerprint = PayrollHistory::attendanceFingerprint(
+                    key != EmployeeIdPool::npos ? summaries[(month - 1) * ids.size() + key] : empty);
+                paid[row].recordFingerprint = PayrollHistory::recordFingerprint(emp);
+                paid[row].rateFingerprint = rateFingerprint;
+                paid[row].details = payrollYear.at(row, month);
+                if ((row + static_cast<std::size_t>(month)) % 100 == 0) {
+                    paid[row].attendanceFingerprint ^= 1;
+                    paid[row].details.basicSalary -= Money::fromDong(1000);
+                    paid[row].details.totalSalary -= Money::fromDong(1000);
+                    ++modified;
+                }
+            }
+            history.recordPeriod(month, year, std::move(paid));
+        }
+
+        // 2. Ghi/đọc file lịch sử và tính chênh lệch
+        const std::string historyFile = "payroll_history_benchmark.csv";
+        double saveTime = bestTime(1, [&] { history.saveToFile(historyFile); });
+        PayrollHistory loaded;
+        double loadTime = bestTime(1, [&] { loaded.loadFromFile(historyFile); });
+        std::remove(historyFile.c_str());
+
+        RetroPayEngine retro;
+        std::vector<PayAdjustment> adjustments;
+        RetroPayStats stats;
+        double retroTime = bestTime(repeat, [&] { stats = retro.calculate(loaded, employees, attendance, welfareManager, year, adjustments); });
+
+        bool same = loaded.size() == history.size() && stats.checked == history.size() && stats.recalculated == modified
+                 && stats.adjusted == modified && stats.totalDifference.totalSalary == Money::fromDong(1000 * static_cast<std::int64_t>(modified));
+        for (std::size_t i = 0; same && i < adjustments.size(); ++i) {
+            const PayAdjustment& a = adjustments[i];
+            same = std::memcmp(&a.recalculated, &payrollYear.at(a.historyIndex, a.month), sizeof(SalaryDetails)) == 0;
+        }
+
+        std::cout << "Chenh lech ky da tra " << year << " (" << history.size() << " dong, " << modified << " dong can dieu chinh):\n"
+                  << std::fixed << std::setprecision(3)
+                  << "  ghi/doc lich su:   " << std::setw(10) << saveTime * 1000.0 << " / " << loadTime * 1000.0 << " ms\n"
+                  << "  RetroPayEngine:    " << std::setw(10) << retroTime * 1000.0 << " ms, tinh lai " << stats.recalculated
+                  << " dong, ket qua " << (same ? "dung" : "SAI") << "\n";
+        return same;
+    }
+
+    /**
+     * @brief Đo xét điều kiện thưởng: từng nhân viên qua isEligible() so với evaluateEligibility() cho cả kỳ.
+     * @return true nếu hai cách cho cùng kết quả với mọi nhân viên.
+     */
+    bool runBonusEligibility(const AttendanceManager& attendance, int month, int year, int repeat) {
+        const BonusWelfare bonus(2000000.0);
+        const auto employees = makeEmployees(attendance);
+        const EmployeeIdPool& ids = attendance.getEmployeeIds();
+
+        std::vector<std::uint8_t> oldData(employees.size());
+        double oldTime = bestTime(repeat, [&] {
+            for (std::size_t i = 0; i < employees.size(); ++i) {
+                oldData[i] = bonus.isEligible(*employees[i], attendance, month, year) ? 1 : 0;
+            }
+        });
+        std::vector<std::uint8_t> newData;
+        std::size_t eligibleCount = 0;
+        double newTime = bestTime(repeat, [&] { eligibleCount = bonus.evaluateEligibility(attendance, month, year, newData); });
+
+        bool same = newData.size() == ids.size();
+        for (std::size_t i = 0; same && i < employees.size(); ++i) {
+            const std::uint32_t key = ids.find(employees[i]->getEmployeeId());
+            same = key != EmployeeIdPool::npos && newData[key] == oldData[i];
+        }
+
+        std::cout << "Dieu kien thuong thang " << month << "/" << year << " (" << employees.size() << " nhan vien, "
+                  << eligibleCount << " du dieu kien):\n"
+                  << std::fixed << std::setprecision(3)
+                  << "  tung nhan vien:      " << std::setw(10) << oldTime * 1000.0 << " ms\n"
+                  << "  evaluateEligibility: " << std::setw(10) << newTime * 1000.0 << " ms  (tang toc "
+                  << std::setprecision(2) << (newTime > 0 ? oldTime / newTime : 0.0) << "x), ket qua "
+                  << (same ? "giong nhau" : "KHAC NHAU") << "\n";
+        return same;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--generate") {
+        if (argc < 4) {
+            std::cerr << "Cach dung: " << argv[0] << " --generate <so_nhan_vien> <file.csv>\n";
+            return 1;
+        }
+        if (!generateAttendanceFile(argv[3], std::atoll(argv[2]))) {
+            std::cerr << "Loi: Khong the ghi file " << argv[3] << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    std::string filename = (argc >= 2) ? argv[1] : "attendance.csv";
+    int month = (argc >= 3) ? std::atoi(argv[2]) : 5;
+    int year = (argc >= 4) ? std::atoi(argv[3]) : 2025;
+    int repeat = (argc >= 5) ? std::atoi(argv[4]) : 5;
+    if (repeat < 1) repeat = 1;
+    unsigned maxThreads = (argc >= 6) ? static_cast<unsigned>(std::atoi(argv[5])) : ThreadPool::resolveThreadCount(0);
+    if (maxThreads < 1) maxThreads = 1;
+
+    AttendanceManager fullManager;
+    fullManager.loadFromFileMapped(filename);
+    bool identical = runCase("Tai day du", fullManager, month, year, repeat);
+
+    AttendanceManager aggregateManager;
+    aggregateManager.loadAggregatesFromFile(filename);
+    identical = runCase("Chi tong hop", aggregateManager, month, year, repeat) && identical;
+
+    identical = runScaling(fullManager, month, year, repeat, maxThreads) && identical;
+    identical = runYear(fullManager, year, repeat) && identical;
+    identical = runSimulation(fullManager, month, year, repeat) && identical;
+    identical = runRetro(fullManager, year, repeat) && identical;
+    identical = runBonusEligibility(fullManager, month, year, repeat) && identical;
+
+    return identical ? 0 : 1;
+}
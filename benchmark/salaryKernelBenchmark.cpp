@@ -0,0 +1,228 @@
+﻿/**
+ * @file salaryKernelBenchmark.cpp
+ * @brief Chương trình đối chiếu và đo tốc độ SalaryKernel: nhánh AVX2 so với nhánh vô hướng
+ * (computeScalar) và so với cách làm tròn của Money (Money::forSeconds, Money::fromDouble).
+ *
+ * Cách dùng:
+ *   salaryKernelBenchmark [so_nhan_vien] [so_lan_lap]
+ *
+ * Dữ liệu được sinh ngẫu nhiên (cố định hạt giống) với giá trị nguyên như dữ liệu thật, gồm cả các
+ * trường hợp làm tròn đúng nửa đồng. Mọi kích thước từ 0 đến 9 nhân viên (phần dư của vòng lặp AVX2)
+ * và kích thước đầy đủ được kiểm tra với cả nhóm trả/không trả theo giờ, có/không ghi kết quả theo cột.
+ * Chương trình trả về 0 nếu mọi nhánh cho kết quả giống hệt từng bit, 2 nếu có khác biệt.
+ *
+ * Biên dịch cùng các file trong thư mục source/, ví dụ:
+ *   cl /O2 /std:c++17 /EHsc /I..\source salaryKernelBenchmark.cpp ..\source\salaryKernel.cpp
+ */
+
+#include "../source/salaryKernel.h"
+#include "../source/money.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Các cột dữ liệu đầu vào và kết quả của một lần chạy.
+     */
+    struct Columns {
+        std::vector<double> normalSeconds, overtimeSeconds, holidaySeconds, basePay, bonusEligible,
+                            fixedBonuses, distanceKm, fixedAllowances, insuranceBase, fixedDeductions;
+
+        SalaryKernelInput input() const {
+            SalaryKernelInput in;
+            in.normalSeconds = normalSeconds.data();
+            in.overtimeSeconds = overtimeSeconds.data();
+            in.holidaySeconds = holidaySeconds.data();
+            in.basePay = basePay.data();
+            in.bonusEligible = bonusEligible.data();
+            in.fixedBonuses = fixedBonuses.data();
+            in.distanceKm = distanceKm.data();
+            in.fixedAllowances = fixedAllowances.data();
+            in.insuranceBase = insuranceBase.data();
+            in.fixedDeductions = fixedDeductions.data();
+            return in;
+        }
+    };
+
+    /**
+     * @brief Vùng nhớ kết quả theo cột.
+     */
+    struct Output {
+        std::vector<double> values[7];
+
+        explicit Output(std::size_t count) {
+            for (auto& column : values) column.assign(count, -1.0);
+        }
+
+        SalaryKernelOutput view() {
+            SalaryKernelOutput out;
+            out.basicSalary = values[0].data();
+            out.overtimeSalary = values[1].data();
+            out.holidaySalary = values[2].data();
+            out.bonuses = values[3].data();
+            out.allowances = values[4].data();
+            out.deductions = values[5].data();
+            out.totalSalary = values[6].data();
+            return out;
+        }
+    };
+
+    /**
+     * @brief Sinh dữ liệu giống dữ liệu thật: số giây là bội của 60 (một số là bội của 1800 để
+     * lương rơi đúng nửa đồng), lương cơ bản và khoảng cách như trong danh sách nhân viên.
+     */
+    Columns generateColumns(std::size_t count) {
+        std::mt19937_64 random(20250517);
+        const double distances[] = { 0.0, 5.8, 8.0, 13.0, 15.0, 17.0, 19.8, 20.6, 42.6 };
+        Columns col;
+        for (std::size_t i = 0; i < count; ++i) {
+            const bool halfStep = random() % 4 == 0;
+            auto seconds = [&](std::uint64_t maxHours) {
+                return static_cast<double>(halfStep ? (random() % (maxHours * 2)) * 1800 : (random() % (maxHours * 60)) * 60);
+            };
+            col.normalSeconds.push_back(seconds(200));
+            col.overtimeSeconds.push_back(seconds(40));
+            col.holidaySeconds.push_back(seconds(24));
+            const double base = static_cast<double>(1500000 + random() % 30000000);
+            col.basePay.push_back(base);
+            col.bonusEligible.push_back(static_cast<double>(random() % 2));
+            col.fixedBonuses.push_back(random() % 8 == 0 ? static_cast<double>(random() % 1000000) : 0.0);
+            col.distanceKm.push_back(distances[random() % (sizeof(distances) / sizeof(distances[0]))]);
+            col.fixedAllowances.push_back(random() % 8 == 0 ? static_cast<double>(random() % 500000) : 0.0);
+            col.insuranceBase.push_back(random() % 3 == 0 ? 0.0 : base);
+            col.fixedDeductions.push_back(random() % 8 == 0 ? static_cast<double>(random() % 200000) : 0.0);
+        }
+        return col;
+    }
+
+    /**
+     * @brief Tham số của nhóm (đơn giá như chính sách nhân viên chính thức, hoặc tăng ca 1,75).
+     */
+    SalaryKernelRates makeRates(bool paysHours, bool raisedOvertime) {
+        SalaryKernelRates rates;
+        rates.normalRate = 23800.0;
+        rates.overtimeRate = raisedOvertime ? 41650.0 : 35700.0;
+        rates.holidayRate = 71400.0;
+        rates.paysHours = paysHours;
+        rates.bonusAmount = 2000000.0;
+        rates.ratePerKm = 4000.0;
+        rates.insuranceRate = 0.105;
+        return rates;
+    }
+
+    /**
+     * @brief So sánh từng bit hai bộ tổng.
+     */
+    bool sameTotals(const SalaryKernelTotals& a, const SalaryKernelTotals& b) {
+        return std::memcmp(&a, &b, sizeof(SalaryKernelTotals)) == 0;
+    }
+
+    /**
+     * @brief Đối chiếu nhánh vô hướng với cách tính bằng Money của PayPolicy/phúc lợi.
+     * @return Số nhân viên có kết quả khác.
+     */
+    std::size_t checkAgainstMoney(const Columns& col, std::size_t count, const SalaryKernelRates& rates, const Output& out) {
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Money basic = Money::forSeconds(static_cast<std::int64_t>(col.normalSeconds[i]), Money::fromDouble(rates.normalRate));
+            const Money overtime = Money::forSeconds(static_cast<std::int64_t>(col.overtimeSeconds[i]), Money::fromDouble(rates.overtimeRate));
+            const Money holiday = Money::forSeconds(static_cast<std::int64_t>(col.holidaySeconds[i]), Money::fromDouble(rates.holidayRate));
+            const Money allowance = Money::fromDouble(rates.ratePerKm * col.distanceKm[i]) + Money::fromDouble(col.fixedAllowances[i]);
+            const Money deduction = Money::fromDouble(col.insuranceBase[i]).scaled(rates.insuranceRate) + Money::fromDouble(col.fixedDeductions[i]);
+            if (Money::fromDouble(out.values[0][i]) != basic || Money::fromDouble(out.values[1][i]) != overtime
+                || Money::fromDouble(out.values[2][i]) != holiday || Money::fromDouble(out.values[4][i]) != allowance
+                || Money::fromDouble(out.values[5][i]) != deduction) {
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+
+    /**
+     * @brief Chạy một hàm nhiều lần, in thời gian tốt nhất và số nhân viên/giây.
+     */
+    double runCase(const std::string& name, int repeat, std::size_t count, const std::function<void()>& work) {
+        double best = 1e100;
+        for (int i = 0; i < repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            work();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() < best) best = elapsed.count();
+        }
+        std::cout << std::left << std::setw(30) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(3) << best * 1000.0 << " ms"
+                  << std::setw(16) << std::setprecision(0) << (best > 0 ? count / best : 0.0) << " nhan vien/giay\n";
+        return best;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = (argc >= 2) ? static_cast<std::size_t>(std::atoll(argv[1])) : 50000;
+    int repeat = (argc >= 3) ? std::atoi(argv[2]) : 20;
+    if (repeat < 1) repeat = 1;
+
+    const bool avx2 = SalaryKernel::hasAvx2();
+    std::cout << "AVX2: " << (avx2 ? "co" : "khong (chi kiem tra nhanh vo huong)") << "\n";
+    const Columns col = generateColumns(count);
+    const SalaryKernelInput input = col.input();
+
+    // 1. Đối chiếu: mọi kích thước nhỏ (phần dư) và kích thước đầy đủ, mọi tổ hợp tham số
+    std::size_t failures = 0;
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 0; n <= 9 && n <= count; ++n) sizes.push_back(n);
+    if (count > 9) sizes.push_back(count);
+    for (std::size_t n : sizes) {
+        for (int variant = 0; variant < 4; ++variant) {
+            const SalaryKernelRates rates = makeRates(variant < 2, variant % 2 == 1);
+            Output scalarOut(n), fastOut(n);
+            SalaryKernelOutput scalarView = scalarOut.view(), fastView = fastOut.view();
+            SalaryKernelTotals scalarTotals, fastTotals, totalsOnly;
+            SalaryKernel::computeScalar(input, n, rates, &scalarView, scalarTotals);
+            SalaryKernel::compute(input, n, rates, &fastView, fastTotals);
+            SalaryKernel::compute(input, n, rates, nullptr, totalsOnly);
+
+            bool same = sameTotals(scalarTotals, fastTotals) && sameTotals(scalarTotals, totalsOnly);
+            for (int c = 0; c < 7 && same; ++c) {
+                same = n == 0 || std::memcmp(scalarOut.values[c].data(), fastOut.values[c].data(), n * sizeof(double)) == 0;
+            }
+            const std::size_t moneyMismatches = rates.paysHours ? checkAgainstMoney(col, n, rates, scalarOut) : 0;
+            if (!same || moneyMismatches > 0) {
+                ++failures;
+                std::cout << "KHAC NHAU: " << n << " nhan vien, bien the " << variant
+                          << (same ? "" : " (AVX2 khac vo huong)")
+                          << (moneyMismatches > 0 ? " (" + std::to_string(moneyMismatches) + " nhan vien khac Money)" : std::string()) << "\n";
+            }
+        }
+    }
+
+    // 2. Đo tốc độ trên kích thước đầy đủ (chỉ tính tổng, như PayrollSimulator)
+    const SalaryKernelRates rates = makeRates(true, false);
+    SalaryKernelTotals totals;
+    double scalarTime = runCase("vo huong (chi tong)", repeat, count, [&] {
+        SalaryKernel::computeScalar(input, count, rates, nullptr, totals);
+    });
+    if (avx2) {
+        double avx2Time = runCase("AVX2 (chi tong)", repeat, count, [&] {
+            SalaryKernel::computeAvx2(input, count, rates, nullptr, totals);
+        });
+        std::cout << "Tang toc AVX2: " << std::setprecision(2) << (avx2Time > 0 ? scalarTime / avx2Time : 0.0) << "x\n";
+    }
+    Output out(count);
+    SalaryKernelOutput view = out.view();
+    runCase("tu chon nhanh (ghi theo cot)", repeat, count, [&] {
+        SalaryKernel::compute(input, count, rates, &view, totals);
+    });
+
+    std::cout << "Ket qua " << (failures == 0 ? "giong nhau" : "KHAC NHAU") << "\n";
+    return failures == 0 ? 0 : 2;
+}
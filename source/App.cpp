@@ -55,6 +55,12 @@ void App::seedData() {
     } else {
         std::cout << "Du lieu nhan vien da duoc tai." << std::endl; // Thông báo tùy chọn
     }
+    // Bảng đơn giá: không có file thì dùng đơn giá mặc định
+    if (_empManager.reloadPayRates(PayRateTable::DEFAULT_FILE)) {
+        std::cout << "Bang don gia da duoc tai tu " << PayRateTable::DEFAULT_FILE << "." << std::endl;
+    } else {
+        std::cout << "Khong tim thay " << PayRateTable::DEFAULT_FILE << ", dung bang don gia mac dinh." << std::endl;
+    }
 }
 
 void App::saveData() {
@@ -88,6 +94,43 @@ void App::saveData() {
     outFile.close();
 }
 
+/**
+ * @brief Đọc lại một file văn bản và hiển thị từng trang trong khung nội dung.
+ */
+void App::showFileInFrame(const std::string& filename, int contentX, int firstLineY, int lastLineY, int contentWidth) const {
+    std::ifstream inFile(filename);
+    if (!inFile) {
+        gotoXY(contentX, firstLineY);
+        std::cout << "LOI: Khong the mo file " << filename << " de doc lai.";
+        return;
+    }
+
+    std::string fileLine;
+    int linesInFrame = lastLineY - firstLineY; // Số dòng còn lại trong khung
+    int linesDisplayed = 0;
+    while (std::getline(inFile, fileLine)) {
+        if (linesDisplayed >= linesInFrame) {
+            gotoXY(contentX, lastLineY); // Dòng cuối trong content
+            std::cout << "-- Nhan phim de xem tiep --";
+            getch();
+            // Xóa nội dung đã hiển thị để vẽ trang mới
+            for (int i=0; i<linesDisplayed; ++i) {
+                gotoXY(contentX, firstLineY + i);
+                std::cout << std::string(contentWidth, ' ');
+            }
+            linesDisplayed = 0;
+        }
+        gotoXY(contentX, firstLineY + linesDisplayed);
+        // Cắt bớt dòng nếu quá dài so với contentWidth
+        if (fileLine.length() > static_cast<size_t>(contentWidth-1)) {
+            std::cout << fileLine.substr(0, contentWidth - 4) << "...";
+        } else {
+            std::cout << fileLine;
+        }
+        linesDisplayed++;
+    }
+}
+
 /**
  * @brief Hiển thị menu chính.
  */
@@ -152,6 +195,10 @@ void App::showMenu() const {
     // Dòng "Tai du lieu cham cong" đã bị xóa
     gotoXY(menuStartX, menuY++); std::cout << "P. In phieu luong mot nhan vien";
     gotoXY(menuStartX, menuY++); std::cout << "A. In phieu luong toan bo nhan vien";
+    gotoXY(menuStartX, menuY++); std::cout << "Y. Bang luong ca nam (12 thang)";
+    gotoXY(menuStartX, menuY++); std::cout << "W. Mo phong chi phi khi doi don gia";
+    gotoXY(menuStartX, menuY++); std::cout << "T. Chenh lech luong cac ky da tra (truy linh)";
+    gotoXY(menuStartX, menuY++); std::cout << "R. Tai lai bang don gia (pay_rates.txt)";
     gotoXY(menuStartX, menuY++); std::cout << "Q. Thoat";
 
     gotoXY(menuStartX, menuY + 2); std::cout << "Chon chuc nang: ";
@@ -282,8 +329,18 @@ void App::run() {
             gotoXY(contentStartX + 18 + 25, inputY -1 ); std::cout << std::string(20, ' '); 
 
 
+            // Kỳ đã chi trả: chỉ ghi đè mốc chi trả khi người dùng xác nhận
+            bool replacePaid = false;
+            const bool alreadyPaid = _empManager.isPeriodPaid(month_val, year_val);
+            if (alreadyPaid) {
+                std::string confirm;
+                gotoXY(contentStartX, inputY++); std::cout << "Ky luong nay da duoc ghi nhan chi tra. Ghi de lich su chi tra? (y/N): ";
+                std::getline(std::cin, confirm);
+                replacePaid = !confirm.empty() && (confirm[0] == 'y' || confirm[0] == 'Y');
+            }
+
             filename_str = "payroll_export.txt";
-            _empManager.printAllPayrolls(filename_str, month_val, year_val); 
+            const bool exported = _empManager.printAllPayrolls(filename_str, month_val, year_val, replacePaid); 
 
             // Xóa các dòng nhập liệu để hiển thị nội dung file
             for(int i=0; i < 5; ++i) { // Xóa khoảng 5 dòng
@@ -292,49 +349,169 @@ void App::run() {
             }
 
             gotoXY(contentStartX, contentStartY); 
+            if (!exported) {
+                std::cout << "LOI: Du lieu cham cong bi tu choi (ban ghi trung lap/chong gio), khong xuat bang luong.";
+                break;
+            }
             std::cout << "Da xuat bang luong thang " << month_val << "/" << year_val 
                                               << " ra file: " << filename_str;
             gotoXY(contentStartX, contentStartY + 1); 
             std::cout << "Noi dung file " << filename_str << ":";
+            const PayrollCacheStats cacheStats = _empManager.getPayrollCacheStats();
+            gotoXY(contentStartX, contentStartY + 2);
+            std::cout << "(Bo nho dem bang luong: " << cacheStats.hits << " lan dung lai, "
+                      << cacheStats.misses << " lan tinh moi, " << cacheStats.entries << " ket qua dang luu)";
+            if (alreadyPaid && !replacePaid) {
+                std::cout << " Lich su chi tra giu nguyen, dung chuc nang T de tinh chenh lech.";
+            }
 
             // Đọc và hiển thị nội dung file
-            std::ifstream inFile(filename_str);
-            if (inFile) {
-                std::string fileLine;
-                int displayLineY = contentStartY + 3; // Bắt đầu hiển thị nội dung file
-                int linesInFrame = contentMaxY - displayLineY; // Số dòng còn lại trong khung
-                int linesDisplayed = 0;
-
-                while (std::getline(inFile, fileLine)) {
-                    if (linesDisplayed >= linesInFrame) {
-                        gotoXY(contentStartX, contentMaxY); // Dòng cuối trong content
-                        std::cout << "-- Nhan phim de xem tiep --";
-                        getch();
-                        // Xóa nội dung đã hiển thị để vẽ trang mới
-                        for (int i=0; i<linesDisplayed; ++i) {
-                            gotoXY(contentStartX, displayLineY + i);
-                            std::cout << std::string(contentInnerWidth, ' ');
-                        }
-                        linesDisplayed = 0;
-                    }
-                    gotoXY(contentStartX, displayLineY + linesDisplayed);
-                    // Cắt bớt dòng nếu quá dài so với contentInnerWidth
-                    if (fileLine.length() > static_cast<size_t>(contentInnerWidth-1)) {
-                        std::cout << fileLine.substr(0, contentInnerWidth - 4) << "...";
-                    } else {
-                        std::cout << fileLine;
-                    }
-                    linesDisplayed++;
-                }
-                inFile.close();
-            } else {
-                gotoXY(contentStartX, contentStartY + 3);
-                std::cout << "LOI: Khong the mo file " << filename_str << " de doc lai.";
-            }
+            showFileInFrame(filename_str, contentStartX, contentStartY + 3, contentMaxY, contentInnerWidth);
             break; // break của case 'A'
+        }
+            case 'Y': { // Bảng lương cả năm
+            printCenteredText("BANG LUONG CA NAM", frameY1 + FRAME_TITLE_Y_OFFSET, windowWidth);
+            int inputY = contentStartY;
+            gotoXY(contentStartX, inputY++); std::cout << "Nhap nam (YYYY): ";
+            while (!(std::cin >> year_val) || year_val < 2000 || year_val > 2100) { 
+                 gotoXY(contentStartX + 18, inputY - 1 ); std::cout << std::string(30, ' '); 
+                 gotoXY(contentStartX + 18, inputY - 1 ); std::cout << "Nam KL. Nhap lai: "; 
+                 std::cin.clear(); std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+            }
+            std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+
+            filename_str = "payroll_year_" + std::to_string(year_val) + ".txt";
+            const std::string summaryFilename = "payroll_year_" + std::to_string(year_val) + "_summary.txt";
+            const bool exported = _empManager.printYearPayroll(filename_str, summaryFilename, year_val);
+
+            for(int i=0; i < 3; ++i) {
+                gotoXY(contentStartX, contentStartY + i);
+                std::cout << std::string(contentInnerWidth, ' ');
+            }
+
+            gotoXY(contentStartX, contentStartY);
+            if (!exported) {
+                std::cout << "LOI: Du lieu cham cong bi tu choi (ban ghi trung lap/chong gio), khong xuat bang luong.";
+                break;
+            }
+            std::cout << "Da xuat bang luong 12 thang nam " << year_val << " ra file: " << filename_str;
+            gotoXY(contentStartX, contentStartY + 1);
+            std::cout << "Noi dung file tong hop " << summaryFilename << ":";
+
+            // Hiển thị file tổng hợp (ma trận đầy đủ nằm trong file kia)
+            showFileInFrame(summaryFilename, contentStartX, contentStartY + 3, contentMaxY, contentInnerWidth);
+            break; // break của case 'Y'
+        }
+            case 'W': { // Mô phỏng chi phí lương theo kịch bản đơn giá
+            printCenteredText("MO PHONG CHI PHI KHI DOI DON GIA", frameY1 + FRAME_TITLE_Y_OFFSET, windowWidth);
+            int inputY = contentStartY;
+            gotoXY(contentStartX, inputY++); std::cout << "Nhap thang (1-12): ";
+            while (!(std::cin >> month_val) || month_val < 1 || month_val > 12) { 
+                gotoXY(contentStartX + 20, inputY - 1 ); std::cout << std::string(30, ' '); 
+                gotoXY(contentStartX + 20, inputY - 1 ); std::cout << "Thang KL. Nhap lai: "; 
+                std::cin.clear(); std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+            }
+            std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+
+            gotoXY(contentStartX, inputY++); std::cout << "Nhap nam (YYYY): ";
+            while (!(std::cin >> year_val) || year_val < 2000 || year_val > 2100) { 
+                 gotoXY(contentStartX + 18, inputY - 1 ); std::cout << std::string(30, ' '); 
+                 gotoXY(contentStartX + 18, inputY - 1 ); std::cout << "Nam KL. Nhap lai: "; 
+                 std::cin.clear(); std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+            }
+            std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+
+            filename_str = "payroll_simulation.txt";
+            const std::size_t scenarioCount = _empManager.simulatePayRates("pay_scenarios.txt", filename_str, month_val, year_val);
+
+            for(int i=0; i < 3; ++i) {
+                gotoXY(contentStartX, contentStartY + i);
+                std::cout << std::string(contentInnerWidth, ' ');
+            }
+
+            gotoXY(contentStartX, contentStartY);
+            if (_empManager.isAttendanceRejected()) {
+                std::cout << "LOI: Du lieu cham cong bi tu choi (ban ghi trung lap/chong gio), khong mo phong.";
+                break;
+            }
+            if (scenarioCount == 0) {
+                std::cout << "LOI: Khong the mo file kich ban pay_scenarios.txt.";
+                break;
+            }
+            std::cout << "Da mo phong " << scenarioCount << " kich ban (thang " << month_val << "/" << year_val
+                      << "), ket qua: " << filename_str;
+            gotoXY(contentStartX, contentStartY + 1);
+            std::cout << "Noi dung file " << filename_str << ":";
+
+            showFileInFrame(filename_str, contentStartX, contentStartY + 3, contentMaxY, contentInnerWidth);
+            break; // break của case 'W'
+        }
+
+            case 'T': { // Chênh lệch lương của các kỳ đã chi trả
+            printCenteredText("CHENH LECH LUONG CAC KY DA TRA", frameY1 + FRAME_TITLE_Y_OFFSET, windowWidth);
+            int inputY = contentStartY;
+            gotoXY(contentStartX, inputY++); std::cout << "Nhap nam (YYYY): ";
+            while (!(std::cin >> year_val) || year_val < 2000 || year_val > 2100) { 
+                 gotoXY(contentStartX + 18, inputY - 1 ); std::cout << std::string(30, ' '); 
+                 gotoXY(contentStartX + 18, inputY - 1 ); std::cout << "Nam KL. Nhap lai: "; 
+                 std::cin.clear(); std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+            }
+            std::cin.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+
+            filename_str = "payroll_adjustments_" + std::to_string(year_val) + ".txt";
+            const RetroPayStats stats = _empManager.printRetroactiveAdjustments(filename_str, year_val);
+
+            for(int i=0; i < 3; ++i) {
+                gotoXY(contentStartX, contentStartY + i);
+                std::cout << std::string(contentInnerWidth, ' ');
+            }
+
+            gotoXY(contentStartX, contentStartY);
+            if (_empManager.isAttendanceRejected()) {
+                std::cout << "LOI: Du lieu cham cong bi tu choi (ban ghi trung lap/chong gio), khong tinh chenh lech.";
+                break;
+            }
+            if (stats.periods == 0) {
+                std::cout << "Chua co ky luong nao cua nam " << year_val << " duoc chi tra (xuat bang luong bang chuc nang A).";
+                break;
+            }
+            std::cout << "Da xet " << stats.checked << " dong cua " << stats.periods << " ky, tinh lai " << stats.recalculated
+                      << ", co chenh lech " << stats.adjusted << ". Ket qua: " << filename_str;
+            gotoXY(contentStartX, contentStartY + 1);
+            std::cout << "Noi dung file " << filename_str << ":";
+
+            showFileInFrame(filename_str, contentStartX, contentStartY + 3, contentMaxY, contentInnerWidth);
+            break; // break của case 'T'
+        }
+
+            case 'R': { // Tải lại bảng đơn giá, áp dụng ngay không cần khởi động lại
+            printCenteredText("TAI LAI BANG DON GIA", frameY1 + FRAME_TITLE_Y_OFFSET, windowWidth);
+            int infoY = contentStartY;
+            gotoXY(contentStartX, infoY++);
+            if (!_empManager.reloadPayRates(PayRateTable::DEFAULT_FILE)) {
+                std::cout << "LOI: Khong the mo file " << PayRateTable::DEFAULT_FILE << ", giu nguyen bang don gia hien hanh.";
+                break;
+            }
+            std::cout << "Da tai lai bang don gia tu " << PayRateTable::DEFAULT_FILE << ":";
+            infoY++;
+
+            const PayRateTable& rates = PayRateTable::active();
+            for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+                const CategoryPayRates& category = rates.categories[c];
+                gotoXY(contentStartX, infoY++);
+                std::cout << std::left << std::setw(12) << PayRateTable::categoryKey(c) << std::right
+                          << " gio thuong " << category.hourlyRate.dong()
+                          << ", tang ca " << category.overtimeRate.dong()
+                          << ", ngay le " << category.holidayRate.dong() << " (dong/gio)";
+            }
+            gotoXY(contentStartX, infoY++);
+            std::cout << "BHXH " << rates.socialInsuranceRate * 100.0 << "%, thuong " << Money::fromDouble(rates.revenueBonus).dong()
+                      << " dong, phu cap di lai " << rates.transportRatePerKm << " dong/km";
+            break; // break của case 'R'
         }
             case 'Q':
                 saveData();
+                _empManager.flushAttendanceCache();
                 clearScreen();
                 getConsoleWindowSize(windowWidth, windowHeight);
                 printCenteredText("Cam on da su dung chuong trinh!", windowHeight / 2, windowWidth);
@@ -882,6 +1059,9 @@ void App::handleEditEmployee(int contentX, int contentY, int contentWidth, int m
     if (userCancelledOperation) {
          gotoXY(labelX+tab+10, messageDisplayY-2); std::cout << "Da huy thao tac sua. Khong co thay doi nao duoc luu.";
     } else if (anyChangeMadeOverall) { 
+        // Kết quả lương đã lưu của nhân viên này (theo mã cũ và mã mới nếu đổi loại) phải được tính lại
+        _empManager.invalidateEmployee(empIdToEdit);
+        if (emp->getEmployeeId() != empIdToEdit) _empManager.invalidateEmployee(emp->getEmployeeId());
         saveData();
         gotoXY(labelX+tab+10, messageDisplayY-2); 
         std::cout << "Tat ca thay doi cho NV " << emp->getEmployeeId() << " da duoc luu!";
@@ -91,6 +91,17 @@ private:
      */
     std::string generateAndValidateNewEmployeeId(const std::string& prefix);
 
+    /**
+     * @brief Đọc lại một file văn bản (ví dụ file bảng lương vừa xuất) và hiển thị trong khung nội dung.
+     * Dòng quá dài được cắt bớt; nếu file dài hơn khung thì hiển thị từng trang, chờ nhấn phím giữa các trang.
+     * @param filename Tên file cần hiển thị.
+     * @param contentX Tọa độ X bắt đầu của vùng nội dung.
+     * @param firstLineY Dòng Y của dòng đầu tiên của file.
+     * @param lastLineY Dòng Y cuối cùng của vùng nội dung (dùng cho lời nhắc sang trang).
+     * @param contentWidth Chiều rộng của vùng nội dung.
+     */
+    void showFileInFrame(const std::string& filename, int contentX, int firstLineY, int lastLineY, int contentWidth) const;
+
 
 public:
     /**
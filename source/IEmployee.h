@@ -65,6 +65,13 @@ public:
      */
     virtual std::string getEmployeeType() const;
 
+    /**
+     * @brief Lấy nhóm tính lương của nhân viên (theo lớp con, không đổi khi đổi loại logic).
+     * PayrollEngine dùng giá trị này để gom nhân viên cùng nhóm và tính lương bằng chính sách tương ứng.
+     * @return Nhóm nhân viên.
+     */
+    virtual EmployeeCategory getCategory() const = 0;
+
     /**
      * @brief Lấy Tên Nhân Viên.
      * @return Chuỗi hằng tham chiếu đến tên nhân viên.
@@ -147,7 +154,19 @@ public:
      * @param deductions Tổng tiền khấu trừ đã được tính từ WelfareManager.
      * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
      */
-    virtual SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const = 0; // Thêm month, year
+    virtual SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, Money bonuses, Money allowances, Money deductions) const = 0; // Thêm month, year
+
+    /**
+     * @brief Tính toán chi tiết lương từ số liệu chấm công tổng hợp của kỳ lương.
+     * Dùng khi tính lương hàng loạt (PayrollEngine); phải cho kết quả giống hệt hàm trên
+     * với summary = attendance.summarize(getEmployeeId(), month, year).
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @param bonuses Tổng tiền thưởng đã được tính từ WelfareManager.
+     * @param allowances Tổng tiền phụ cấp đã được tính từ WelfareManager.
+     * @param deductions Tổng tiền khấu trừ đã được tính từ WelfareManager.
+     * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
+     */
+    virtual SalaryDetails calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const = 0;
 
     /**
      * @brief Lấy mức lương cơ bản/cố định của nhân viên.
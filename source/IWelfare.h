@@ -69,9 +69,9 @@ public:
      * Giá trị trả về có thể dương (cộng vào lương, ví dụ: thưởng, phụ cấp)
      * hoặc âm (trừ vào lương, ví dụ: các khoản khấu trừ như bảo hiểm).
      * @param employee Tham chiếu hằng đến đối tượng IEmployee mà phúc lợi này đang được tính toán.
-     * @return double Giá trị số biểu thị tác động của phúc lợi.
+     * @return Money Giá trị (số nguyên đồng, đã làm tròn theo quy tắc của Money) biểu thị tác động của phúc lợi.
      */
-    virtual double calculateImpact(const IEmployee& employee) const = 0; //
+    virtual Money calculateImpact(const IEmployee& employee) const = 0; //
 
     /**
      * @brief Kiểm tra xem một nhân viên cụ thể có đủ điều kiện nhận phúc lợi này hay không
@@ -84,6 +84,17 @@ public:
      * @return true nếu nhân viên đủ điều kiện, false nếu ngược lại.
      */
     virtual bool isEligible(const IEmployee& employee, const AttendanceManager& attendanceManager, int month, int year) const = 0; // Thêm month, year
+
+    /**
+     * @brief Kiểm tra điều kiện nhận phúc lợi từ số liệu chấm công tổng hợp của kỳ lương.
+     * Dùng khi tính lương hàng loạt (PayrollEngine): số liệu của mọi nhân viên đã được tổng hợp
+     * trong một lần quét, nên không cần tra cứu lại AttendanceManager.
+     * Phải cho cùng kết quả với isEligible(employee, attendanceManager, month, year).
+     * @param employee Tham chiếu hằng đến đối tượng IEmployee cần kiểm tra.
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương (xem AttendanceManager::summarize).
+     * @return true nếu nhân viên đủ điều kiện, false nếu ngược lại.
+     */
+    virtual bool isEligible(const IEmployee& employee, const AttendanceSummary& summary) const = 0;
 };
 
 
@@ -0,0 +1,254 @@
+﻿#include "AttendanceCache.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace {
+
+    const char CACHE_MAGIC[8] = { 'P', 'M', 'S', 'A', 'T', 'T', 'C', '\0' };
+
+    /**
+     * @brief Phần đầu của file cache (ghi nguyên khối, cùng thứ tự byte với máy).
+     */
+    struct CacheHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t sourceSize;
+        std::int64_t sourceModified;
+        std::uint64_t sourceChecksum;
+        std::uint64_t payloadChecksum;
+        std::uint32_t recordCount;
+        std::uint32_t idCount;
+        std::uint32_t idBytes;
+        std::uint32_t policy;       // DuplicatePolicy khi phân tích file nguồn
+    };
+    static_assert(sizeof(CacheHeader) == 64, "CacheHeader phai co kich thuoc co dinh");
+
+    /**
+     * @brief Kích thước phần dữ liệu (sau phần đầu) ứng với số bản ghi và từ điển cho trước.
+     */
+    std::uint64_t payloadSize(std::uint64_t records, std::uint64_t ids, std::uint64_t idBytes) {
+        return records * (4 + 4 + 4 + 2 + 1 + 1) + (ids + 1) * 4 + idBytes;
+    }
+
+    std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    /**
+     * @brief Nối nguyên khối một cột vào bộ đệm phần dữ liệu.
+     */
+    template <typename T>
+    void appendColumn(std::string& payload, const std::vector<T>& column) {
+        if (!column.empty()) {
+            payload.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Đọc phần tử thứ `index` của một cột trong vùng nhớ cache (memcpy để không phụ thuộc căn lề).
+     */
+    template <typename T>
+    T columnAt(const char* column, std::size_t index) {
+        T value;
+        std::memcpy(&value, column + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+} // namespace
+
+/**
+ * @brief Đường dẫn file cache của một file nguồn.
+ */
+std::string AttendanceCache::cachePathFor(const std::string& sourceFile) {
+    return sourceFile + ".cache";
+}
+
+/**
+ * @brief Lấy thời điểm sửa đổi cuối của một file.
+ */
+bool AttendanceCache::lastModified(const std::string& filename, std::int64_t& modified) {
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(std::filesystem::u8path(filename), error);
+    if (error) return false;
+    modified = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+/**
+ * @brief Checksum 64-bit: trộn từng khối 8 byte, phần dư được đệm 0.
+ */
+std::uint64_t AttendanceCache::checksum(const char* data, std::size_t size) {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ static_cast<std::uint64_t>(size);
+    std::size_t pos = 0;
+    for (; pos + 8 <= size; pos += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + pos, 8);
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash = rotateLeft(hash, 31) * 0x4CF5AD432745937FULL;
+    }
+    if (pos < size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + pos, size - pos);
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash = rotateLeft(hash, 31) * 0x4CF5AD432745937FULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @brief Đọc file cache nếu nó còn khớp với file nguồn.
+ */
+bool AttendanceCache::load(const std::string& cacheFile, std::string_view source, std::int64_t sourceModified,
+                           DuplicatePolicy policy, std::vector<PackedAttendanceRecord>& records, EmployeeIdPool& ids) {
+    records.clear();
+    ids.clear();
+
+    MappedFile file;
+    if (!file.open(cacheFile) || file.size() < sizeof(CacheHeader)) {
+        return false;
+    }
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+        || header.version != VERSION || header.headerSize != sizeof(CacheHeader)
+        || header.policy != static_cast<std::uint32_t>(policy)) {
+        return false;
+    }
+
+    // Kiểm tra độ mới: so kích thước và thời điểm sửa đổi trước, checksum nguồn sau cùng
+    if (header.sourceSize != source.size() || header.sourceModified != sourceModified
+        || header.sourceChecksum != checksum(source.data(), source.size())) {
+        return false;
+    }
+
+    // Kiểm tra phần dữ liệu còn nguyên vẹn
+    const char* payload = file.data() + sizeof(CacheHeader);
+    std::uint64_t size = file.size() - sizeof(CacheHeader);
+    if (size != payloadSize(header.recordCount, header.idCount, header.idBytes)
+        || header.payloadChecksum != checksum(payload, static_cast<std::size_t>(size))) {
+        return false;
+    }
+
+    // Vị trí các cột trong phần dữ liệu (cùng thứ tự với save())
+    const std::size_t count = header.recordCount;
+    const char* keys = payload;
+    const char* checkIns = keys + count * 4;
+    const char* checkOuts = checkIns + count * 4;
+    const char* idOffsets = checkOuts + count * 4;
+    const char* workDays = idOffsets + (header.idCount + std::size_t(1)) * 4;
+    const char* dayTypes = workDays + count * 2;
+    const char* flags = dayTypes + count;
+    const char* idChars = flags + count;
+
+    // Dựng lại từ điển mã nhân viên theo đúng thứ tự khóa
+    if (columnAt<std::uint32_t>(idOffsets, 0) != 0
+        || columnAt<std::uint32_t>(idOffsets, header.idCount) != header.idBytes) {
+        return false;
+    }
+    for (std::uint32_t key = 0; key < header.idCount; ++key) {
+        std::uint32_t first = columnAt<std::uint32_t>(idOffsets, key);
+        std::uint32_t last = columnAt<std::uint32_t>(idOffsets, key + std::size_t(1));
+        if (last < first || ids.intern(std::string_view(idChars + first, last - first)) != key) {
+            ids.clear();
+            return false;
+        }
+    }
+
+    records.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        PackedAttendanceRecord& record = records[i];
+        record.employeeKey = columnAt<std::uint32_t>(keys, i);
+        record.checkInSeconds = columnAt<std::int32_t>(checkIns, i);
+        record.checkOutSeconds = columnAt<std::int32_t>(checkOuts, i);
+        record.workDay = columnAt<std::uint16_t>(workDays, i);
+        std::uint8_t dayType = static_cast<std::uint8_t>(dayTypes[i]);
+        record.flags = static_cast<std::uint8_t>(flags[i]);
+        if (record.employeeKey >= header.idCount || dayType > static_cast<std::uint8_t>(AttendanceDayType::Unknown)) {
+            records.clear();
+            ids.clear();
+            return false;
+        }
+        record.dayType = static_cast<AttendanceDayType>(dayType);
+    }
+    return true;
+}
+
+/**
+ * @brief Ghi file cache (qua file tạm rồi đổi tên).
+ */
+bool AttendanceCache::save(const std::string& cacheFile, std::string_view source, std::int64_t sourceModified,
+                           DuplicatePolicy policy, const std::vector<PackedAttendanceRecord>& records, const EmployeeIdPool& ids) {
+    const std::size_t count = records.size();
+    std::vector<std::uint32_t> keys(count), idOffsets;
+    std::vector<std::int32_t> checkIns(count), checkOuts(count);
+    std::vector<std::uint16_t> workDays(count);
+    std::vector<std::uint8_t> dayTypes(count), flags(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = records[i].employeeKey;
+        checkIns[i] = records[i].checkInSeconds;
+        checkOuts[i] = records[i].checkOutSeconds;
+        workDays[i] = records[i].workDay;
+        dayTypes[i] = static_cast<std::uint8_t>(records[i].dayType);
+        flags[i] = records[i].flags;
+    }
+
+    std::string idChars;
+    idOffsets.reserve(ids.size() + 1);
+    idOffsets.push_back(0);
+    for (std::uint32_t key = 0; key < ids.size(); ++key) {
+        idChars += ids.idOf(key);
+        idOffsets.push_back(static_cast<std::uint32_t>(idChars.size()));
+    }
+
+    std::string payload;
+    payload.reserve(static_cast<std::size_t>(payloadSize(count, ids.size(), idChars.size())));
+    appendColumn(payload, keys);
+    appendColumn(payload, checkIns);
+    appendColumn(payload, checkOuts);
+    appendColumn(payload, idOffsets);
+    appendColumn(payload, workDays);
+    appendColumn(payload, dayTypes);
+    appendColumn(payload, flags);
+    payload += idChars;
+
+    CacheHeader header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(CacheHeader);
+    header.sourceSize = source.size();
+    header.sourceModified = sourceModified;
+    header.sourceChecksum = checksum(source.data(), source.size());
+    header.payloadChecksum = checksum(payload.data(), payload.size());
+    header.recordCount = static_cast<std::uint32_t>(count);
+    header.idCount = ids.size();
+    header.idBytes = static_cast<std::uint32_t>(idChars.size());
+    header.policy = static_cast<std::uint32_t>(policy);
+
+    const std::string tempFile = cacheFile + ".tmp";
+    {
+        std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!out) {
+            out.close();
+            std::remove(tempFile.c_str());
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(std::filesystem::u8path(tempFile), std::filesystem::u8path(cacheFile), error);
+    if (error) {
+        std::remove(tempFile.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+﻿#ifndef ATTENDANCE_CACHE_H
+#define ATTENDANCE_CACHE_H
+
+#include "globaldefinitions.h"
+#include "EmployeeIdPool.h"
+#include "AttendanceConflictIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file AttendanceCache.h
+ * @brief Định nghĩa lớp AttendanceCache, đọc/ghi file cache nhị phân dạng cột của dữ liệu chấm công.
+ */
+
+/**
+ * @class AttendanceCache
+ * @brief Các hàm tiện ích đọc/ghi file cache chấm công (dạng cột, có phiên bản).
+ *
+ * File cache nằm cạnh file CSV nguồn (ví dụ `attendance.csv.cache`) và gồm:
+ * phần đầu (magic, phiên bản, kích thước + thời điểm sửa đổi + checksum của file nguồn,
+ * checksum phần dữ liệu), tiếp theo là các cột: khóa nhân viên, giờ vào, giờ ra,
+ * bảng vị trí của từ điển mã nhân viên, ngày làm việc, loại ngày, cờ, và cuối cùng là
+ * các ký tự của từ điển mã nhân viên.
+ *
+ * Cache chỉ được dùng khi kích thước, thời điểm sửa đổi và checksum của file nguồn đều khớp,
+ * cache được ghi với cùng DuplicatePolicy (các bản ghi xung đột đã bị lọc theo chính sách đó)
+ * và phần dữ liệu của cache không bị hỏng; mọi trường hợp khác đều trả về false để nơi gọi
+ * quay lại phân tích file CSV.
+ */
+class AttendanceCache {
+public:
+    /** @brief Phiên bản định dạng file cache hiện tại. */
+    static constexpr std::uint32_t VERSION = 3;
+
+    /**
+     * @brief Lấy đường dẫn file cache tương ứng với một file CSV nguồn.
+     * @param sourceFile Đường dẫn file CSV.
+     * @return Đường dẫn file cache (đường dẫn nguồn + ".cache").
+     */
+    static std::string cachePathFor(const std::string& sourceFile);
+
+    /**
+     * @brief Lấy thời điểm sửa đổi cuối của một file.
+     * @param filename Đường dẫn file.
+     * @param modified Biến nhận thời điểm sửa đổi (đơn vị của std::filesystem::file_time_type).
+     * @return true nếu lấy được, false nếu file không tồn tại hoặc có lỗi.
+     */
+    static bool lastModified(const std::string& filename, std::int64_t& modified);
+
+    /**
+     * @brief Tính checksum 64-bit của một vùng dữ liệu (xử lý 8 byte mỗi bước).
+     */
+    static std::uint64_t checksum(const char* data, std::size_t size);
+
+    /**
+     * @brief Đọc file cache nếu nó còn khớp với nội dung file nguồn.
+     * @param cacheFile Đường dẫn file cache.
+     * @param source Nội dung file CSV nguồn (đã được ánh xạ vào bộ nhớ).
+     * @param sourceModified Thời điểm sửa đổi của file nguồn.
+     * @param policy Chính sách xử lý bản ghi xung đột đang dùng.
+     * @param records Vector nhận các bản ghi (theo đúng thứ tự đã lưu).
+     * @param ids Bảng mã nhân viên nhận từ điển (khóa giống như lúc lưu).
+     * @return true nếu đọc thành công; false nếu cache không tồn tại, cũ, hỏng hoặc khác chính sách.
+     */
+    static bool load(const std::string& cacheFile, std::string_view source, std::int64_t sourceModified,
+                     DuplicatePolicy policy, std::vector<PackedAttendanceRecord>& records, EmployeeIdPool& ids);
+
+    /**
+     * @brief Ghi file cache cho nội dung file nguồn và dữ liệu đã phân tích từ nó.
+     * File được ghi ra một file tạm rồi đổi tên, nên không để lại cache ghi dở.
+     * @param cacheFile Đường dẫn file cache.
+     * @param source Nội dung file CSV nguồn.
+     * @param sourceModified Thời điểm sửa đổi của file nguồn.
+     * @param policy Chính sách xử lý bản ghi xung đột đã dùng khi phân tích.
+     * @param records Các bản ghi đã phân tích.
+     * @param ids Bảng mã nhân viên tương ứng với khóa trong records.
+     * @return true nếu ghi thành công.
+     */
+    static bool save(const std::string& cacheFile, std::string_view source, std::int64_t sourceModified,
+                     DuplicatePolicy policy, const std::vector<PackedAttendanceRecord>& records, const EmployeeIdPool& ids);
+};
+
+#endif // ATTENDANCE_CACHE_H
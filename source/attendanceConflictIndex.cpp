@@ -0,0 +1,106 @@
+﻿#include "AttendanceConflictIndex.h"
+
+namespace {
+
+    /**
+     * @brief Bản ghi có đủ giờ vào/ra và giờ ra lớn hơn giờ vào (mới xét chồng giờ).
+     */
+    bool hasInterval(std::uint8_t flags, std::int32_t checkIn, std::int32_t checkOut) {
+        const std::uint8_t both = ATTENDANCE_HAS_CHECK_IN | ATTENDANCE_HAS_CHECK_OUT;
+        return (flags & both) == both && checkOut > checkIn;
+    }
+
+} // namespace
+
+/**
+ * @brief Vị trí bắt đầu dò (băm Fibonacci của nhân viên và ngày).
+ */
+std::size_t AttendanceConflictIndex::slotOf(std::uint32_t employeeKey, std::uint16_t workDay) const {
+    const std::uint64_t key = (static_cast<std::uint64_t>(employeeKey) << 16) | workDay;
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> _shift);
+}
+
+/**
+ * @brief Kiểm tra xung đột rồi thêm bản ghi vào bảng.
+ */
+AttendanceConflict AttendanceConflictIndex::insert(const PackedAttendanceRecord& record, DuplicatePolicy policy) {
+    if ((_size + 1) * 4 > _slots.size() * 3) {
+        rehash(_slots.empty() ? 1024 : _slots.size() * 2);
+    }
+
+    // Chỉ cờ giờ vào/ra được so sánh; cờ ngày lễ cố định suy ra từ ngày nên luôn giống nhau
+    const std::uint8_t flags = record.flags & (ATTENDANCE_HAS_CHECK_IN | ATTENDANCE_HAS_CHECK_OUT);
+    const std::uint8_t dayType = static_cast<std::uint8_t>(record.dayType);
+    const bool interval = hasInterval(flags, record.checkInSeconds, record.checkOutSeconds);
+    const std::size_t mask = _slots.size() - 1;
+
+    AttendanceConflict conflict = AttendanceConflict::None;
+    std::size_t pos = slotOf(record.employeeKey, record.workDay);
+    for (; _slots[pos].employeeKey != EMPTY_KEY; pos = (pos + 1) & mask) {
+        const Slot& slot = _slots[pos];
+        if (slot.employeeKey != record.employeeKey || slot.workDay != record.workDay) continue;
+        if (slot.flags == flags && slot.dayType == dayType
+            && slot.checkInSeconds == record.checkInSeconds && slot.checkOutSeconds == record.checkOutSeconds) {
+            conflict = AttendanceConflict::Duplicate;
+            break;
+        }
+        if (interval && hasInterval(slot.flags, slot.checkInSeconds, slot.checkOutSeconds)
+            && record.checkInSeconds < slot.checkOutSeconds && slot.checkInSeconds < record.checkOutSeconds) {
+            conflict = AttendanceConflict::Overlap; // Tiếp tục dò: có thể còn một bản ghi trùng hoàn toàn
+        }
+    }
+    if (!keepsConflict(policy, conflict)) {
+        return conflict;
+    }
+    if (conflict == AttendanceConflict::Duplicate) { // Dò tiếp tới ô trống để thêm bản ghi
+        while (_slots[pos].employeeKey != EMPTY_KEY) pos = (pos + 1) & mask;
+    }
+
+    Slot& slot = _slots[pos];
+    slot.employeeKey = record.employeeKey;
+    slot.workDay = record.workDay;
+    slot.dayType = dayType;
+    slot.flags = flags;
+    slot.checkInSeconds = record.checkInSeconds;
+    slot.checkOutSeconds = record.checkOutSeconds;
+    ++_size;
+    return conflict;
+}
+
+/**
+ * @brief Chuẩn bị chỗ cho `count` bản ghi.
+ */
+void AttendanceConflictIndex::reserve(std::size_t count) {
+    std::size_t slotCount = _slots.empty() ? 1024 : _slots.size();
+    while (count * 4 > slotCount * 3) slotCount *= 2;
+    if (slotCount > _slots.size()) rehash(slotCount);
+}
+
+/**
+ * @brief Dựng lại bảng với số ô mới.
+ */
+void AttendanceConflictIndex::rehash(std::size_t slotCount) {
+    std::vector<Slot> old;
+    old.swap(_slots);
+    Slot empty = {};
+    empty.employeeKey = EMPTY_KEY;
+    _slots.assign(slotCount, empty);
+    _shift = 64;
+    for (std::size_t n = slotCount; n > 1; n >>= 1) --_shift;
+
+    const std::size_t mask = slotCount - 1;
+    for (const Slot& slot : old) {
+        if (slot.employeeKey == EMPTY_KEY) continue;
+        std::size_t pos = slotOf(slot.employeeKey, slot.workDay);
+        while (_slots[pos].employeeKey != EMPTY_KEY) pos = (pos + 1) & mask;
+        _slots[pos] = slot;
+    }
+}
+
+/**
+ * @brief Xóa toàn bộ bảng.
+ */
+void AttendanceConflictIndex::clear() {
+    for (Slot& slot : _slots) slot.employeeKey = EMPTY_KEY;
+    _size = 0;
+}
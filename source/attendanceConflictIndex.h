@@ -0,0 +1,114 @@
+﻿#ifndef ATTENDANCE_CONFLICT_INDEX_H
+#define ATTENDANCE_CONFLICT_INDEX_H
+
+#include "globaldefinitions.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file AttendanceConflictIndex.h
+ * @brief Định nghĩa lớp AttendanceConflictIndex, phát hiện bản ghi chấm công trùng lặp hoặc chồng giờ.
+ */
+
+/**
+ * @enum DuplicatePolicy
+ * @brief Cách xử lý bản ghi chấm công trùng lặp hoặc chồng giờ khi tải dữ liệu.
+ */
+enum class DuplicatePolicy : std::uint8_t {
+    KeepFirst, ///< @brief Bỏ các bản ghi trùng hoàn toàn đến sau (mặc định); bản ghi chồng giờ vẫn được giữ và chỉ được ghi nhận.
+    Reject,    ///< @brief Từ chối cả file: nếu có xung đột thì kho chấm công bị làm rỗng sau khi tải.
+    Report     ///< @brief Giữ mọi bản ghi (cộng hết vào lương như trước đây), chỉ ghi nhận xung đột.
+};
+
+/**
+ * @enum AttendanceConflict
+ * @brief Kết quả kiểm tra một bản ghi với các bản ghi đã có.
+ */
+enum class AttendanceConflict : std::uint8_t {
+    None,      ///< @brief Không xung đột.
+    Duplicate, ///< @brief Trùng hoàn toàn (nhân viên, ngày, giờ vào, giờ ra, loại ngày) với một bản ghi đã có.
+    Overlap    ///< @brief Khoảng giờ [vào, ra) giao với khoảng giờ của một bản ghi cùng nhân viên, cùng ngày.
+};
+
+/**
+ * @brief Kiểm tra một bản ghi có loại xung đột `conflict` có được nhận vào kho theo chính sách `policy` hay không.
+ * Chỉ bản ghi trùng hoàn toàn mới bị bỏ theo KeepFirst: hai khoảng giờ chồng nhau chưa cho biết khoảng nào
+ * sai, nên tự động bỏ một dòng có thể làm mất giờ công được trả lương.
+ */
+inline bool keepsConflict(DuplicatePolicy policy, AttendanceConflict conflict) {
+    switch (conflict) {
+    case AttendanceConflict::None:      return true;
+    case AttendanceConflict::Duplicate: return policy == DuplicatePolicy::Report;
+    case AttendanceConflict::Overlap:   return policy != DuplicatePolicy::Reject;
+    }
+    return false;
+}
+
+/**
+ * @class AttendanceConflictIndex
+ * @brief Bảng băm địa chỉ mở (dò tuyến tính) các bản ghi đã nhận, dùng để phát hiện trùng lặp
+ * và chồng giờ với chi phí O(1) trung bình cho mỗi dòng.
+ *
+ * Mỗi ô (16 byte) lưu khóa nhân viên, ngày, loại ngày, cờ và giờ vào/ra của một bản ghi. Vị trí
+ * bắt đầu dò chỉ phụ thuộc vào (nhân viên, ngày), nên mọi bản ghi cùng nhân viên, cùng ngày
+ * (thường chỉ 1-2 bản ghi) nằm trên cùng một chuỗi dò và được so sánh trong một lần dò.
+ * Bảng tự tăng gấp đôi khi đầy quá 3/4.
+ */
+class AttendanceConflictIndex {
+public:
+    /**
+     * @brief Kiểm tra một bản ghi với các bản ghi đã có, rồi thêm nó vào bảng nếu bản ghi được nhận
+     * theo `policy` (xem keepsConflict()).
+     * @param record Bản ghi (khóa nhân viên phải là khóa chung của kho).
+     * @param policy Chính sách xử lý xung đột (DuplicatePolicy::Report: luôn thêm).
+     * @return Loại xung đột (Duplicate được ưu tiên hơn Overlap).
+     */
+    AttendanceConflict insert(const PackedAttendanceRecord& record, DuplicatePolicy policy = DuplicatePolicy::KeepFirst);
+
+    /**
+     * @brief Chuẩn bị chỗ cho `count` bản ghi (tránh dựng lại bảng nhiều lần).
+     */
+    void reserve(std::size_t count);
+
+    /** @brief Số bản ghi đang có trong bảng. */
+    std::size_t size() const { return _size; }
+
+    /** @brief Số byte bộ nhớ của bảng. */
+    std::size_t memoryBytes() const { return _slots.capacity() * sizeof(Slot); }
+
+    /** @brief Xóa toàn bộ bảng, giữ lại các ô để dùng lại cho lần tải sau. */
+    void clear();
+
+private:
+    /**
+     * @brief Một ô của bảng; ô trống có employeeKey = EMPTY_KEY.
+     */
+    struct Slot {
+        std::uint32_t employeeKey;
+        std::uint16_t workDay;
+        std::uint8_t dayType;
+        std::uint8_t flags;
+        std::int32_t checkInSeconds;
+        std::int32_t checkOutSeconds;
+    };
+    static_assert(sizeof(Slot) == 16, "Slot phai co kich thuoc 16 byte");
+
+    static constexpr std::uint32_t EMPTY_KEY = 0xFFFFFFFFu;
+
+    std::vector<Slot> _slots; ///< @brief Các ô (số ô là lũy thừa của 2).
+    std::size_t _size = 0;    ///< @brief Số ô đang dùng.
+    unsigned _shift = 64;     ///< @brief Số bit dịch phải khi lấy vị trí từ giá trị băm (64 - log2(số ô)).
+
+    /**
+     * @brief Vị trí bắt đầu dò của một cặp (nhân viên, ngày).
+     */
+    std::size_t slotOf(std::uint32_t employeeKey, std::uint16_t workDay) const;
+
+    /**
+     * @brief Dựng lại bảng với số ô mới (lũy thừa của 2).
+     */
+    void rehash(std::size_t slotCount);
+};
+
+#endif // ATTENDANCE_CONFLICT_INDEX_H
@@ -4,7 +4,126 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath> // Để dùng floor
+#include <string_view>
+#include <filesystem>
+#include <system_error>
 #include "utils.h"
+#include "MappedFile.h"
+#include "AttendanceParser.h"
+#include "ThreadPool.h"
+#include "AttendanceCache.h"
+#include "AttendancePartitions.h"
+
+namespace {
+
+    /**
+     * @brief Bỏ các ký tự khoảng trắng ở cuối (giống erase(find_last_not_of(" \n\r\t") + 1)).
+     */
+    std::string_view trimRight(std::string_view field) {
+        std::size_t end = field.find_last_not_of(" \n\r\t");
+        return (end == std::string_view::npos) ? std::string_view() : field.substr(0, end + 1);
+    }
+
+    /**
+     * @brief Lấy trường tiếp theo trong dòng, kết thúc bởi dấu phẩy (hoặc hết dòng).
+     * Con trỏ `pos` được dịch qua dấu phẩy, tương tự std::getline(ss, field, ',').
+     */
+    std::string_view nextField(std::string_view line, std::size_t& pos) {
+        if (pos >= line.size()) {
+            pos = line.size();
+            return std::string_view();
+        }
+        std::size_t comma = line.find(',', pos);
+        if (comma == std::string_view::npos) comma = line.size();
+        std::string_view field = line.substr(pos, comma - pos);
+        pos = (comma < line.size()) ? comma + 1 : line.size();
+        return field;
+    }
+
+    /**
+     * @brief Các trường của một dòng CSV chấm công (trỏ thẳng vào nội dung dòng).
+     */
+    struct CsvFields {
+        std::string_view employeeId;
+        std::string_view workDate;
+        std::string_view checkIn;
+        std::string_view checkOut;
+        std::string_view dayType;
+    };
+
+    /**
+     * @brief Tách một dòng CSV thành các trường, bỏ khoảng trắng cuối mỗi trường.
+     */
+    CsvFields splitLine(std::string_view line) {
+        CsvFields fields;
+        std::size_t pos = 0;
+        fields.employeeId = trimRight(nextField(line, pos));
+        fields.workDate = trimRight(nextField(line, pos));
+        fields.checkIn = trimRight(nextField(line, pos));
+        fields.checkOut = trimRight(nextField(line, pos));
+        fields.dayType = trimRight(line.substr(pos)); // Phần còn lại của dòng
+        return fields;
+    }
+
+    /**
+     * @brief Một lô dòng CSV đã tách trường, lưu theo cột để chuyển đổi cả cột một lần.
+     */
+    struct ColumnBatch {
+        std::vector<std::string_view> employeeIds;
+        std::vector<std::string_view> workDates;
+        std::vector<std::string_view> checkIns;
+        std::vector<std::string_view> checkOuts;
+        std::vector<std::string_view> dayTypes;
+        std::vector<std::size_t> lineNumbers;
+
+        void push(const CsvFields& fields, std::size_t lineNumber) {
+            employeeIds.push_back(fields.employeeId);
+            workDates.push_back(fields.workDate);
+            checkIns.push_back(fields.checkIn);
+            checkOuts.push_back(fields.checkOut);
+            dayTypes.push_back(fields.dayType);
+            lineNumbers.push_back(lineNumber);
+        }
+
+        void clear() {
+            employeeIds.clear();
+            workDates.clear();
+            checkIns.clear();
+            checkOuts.clear();
+            dayTypes.clear();
+            lineNumbers.clear();
+        }
+    };
+
+    /**
+     * @brief Bỏ qua dòng tiêu đề, trả về phần dữ liệu còn lại của file.
+     */
+    std::string_view skipHeader(std::string_view content) {
+        std::size_t headerEnd = content.find('\n');
+        return (headerEnd == std::string_view::npos) ? std::string_view() : content.substr(headerEnd + 1);
+    }
+
+    /**
+     * @brief Đếm số dòng của một nội dung (dòng cuối không có '\n' vẫn được tính).
+     */
+    std::size_t countLines(std::string_view content) {
+        std::size_t lines = static_cast<std::size_t>(std::count(content.begin(), content.end(), '\n'));
+        return (!content.empty() && content.back() != '\n') ? lines + 1 : lines;
+    }
+
+} // namespace
+
+/**
+ * @brief Bộ đệm kết quả phân tích của một đoạn file.
+ * Khóa nhân viên trong `records` là khóa cục bộ của `localIds`, được ánh xạ lại khi gộp.
+ */
+struct AttendanceManager::ParsedChunk {
+    std::vector<PackedAttendanceRecord> records; ///< Các bản ghi hợp lệ theo thứ tự trong đoạn.
+    EmployeeIdPool localIds;                     ///< Bảng mã nhân viên cục bộ của đoạn.
+    std::vector<std::uint32_t> lineNumbers;      ///< Số dòng (tính từ đầu đoạn) của từng bản ghi.
+    IngestDiagnostics diagnostics;               ///< Các dòng lỗi (số dòng tính từ đầu đoạn).
+    std::size_t lineCount = 0;                   ///< Số dòng của đoạn (kể cả dòng trống).
+};
 
 // Khởi tạo danh sách ngày lễ cố định (MM-DD)
 std::vector<std::string> AttendanceManager::_holidays = {
@@ -15,31 +134,576 @@ std::vector<std::string> AttendanceManager::_holidays = {
  * @brief Chuyển đổi chuỗi thời gian "HH:MM:SS" thành tổng số giây.
  */
 int AttendanceManager::timeToSeconds(const std::string& timeStr) {
-    if (timeStr.empty() || timeStr.find(':') == std::string::npos) {
-        // Trả về 0 hoặc ném lỗi nếu định dạng thời gian không hợp lệ / rỗng
-        return 0;
+    // Không dùng stringstream: định dạng chuẩn được đọc bằng SWAR, các dạng khác được đọc
+    // từng ký tự với cùng kết quả như `ss >> hours >> colon >> minutes >> colon >> seconds`
+    return AttendanceParser::parseTime(timeStr);
+}
+
+/**
+ * @brief Nén các trường chuỗi của một bản ghi (trừ mã nhân viên).
+ */
+bool AttendanceManager::packRecord(std::string_view workDate, std::string_view checkIn, std::string_view checkOut,
+                                   std::string_view dayType, PackedAttendanceRecord& out) {
+    int year = 0, month = 0, day = 0;
+    if (!AttendanceParser::parseDate(workDate, year, month, day) || !packDate(year, month, day, out)) {
+        return false;
     }
-    std::stringstream ss(timeStr);
-    int hours = 0, minutes = 0, seconds = 0;
-    char colon;
-    ss >> hours >> colon >> minutes >> colon >> seconds;
-    return hours * 3600 + minutes * 60 + seconds;
+    out.checkInSeconds = AttendanceParser::parseTime(checkIn);
+    out.checkOutSeconds = AttendanceParser::parseTime(checkOut);
+    out.dayType = AttendanceParser::parseDayType(dayType);
+    if (!checkIn.empty()) out.flags |= ATTENDANCE_HAS_CHECK_IN;
+    if (!checkOut.empty()) out.flags |= ATTENDANCE_HAS_CHECK_OUT;
+    return true;
+}
+
+/**
+ * @brief Ghi ngày làm việc (và cờ ngày lễ cố định) vào bản ghi nén.
+ */
+bool AttendanceManager::packDate(int year, int month, int day, PackedAttendanceRecord& out) {
+    if (year < 1970 || year > 2149) {
+        return false; // Ngoài phạm vi biểu diễn của workDay (16 bit)
+    }
+    out.workDay = static_cast<std::uint16_t>(AttendanceParser::daysFromCivil(year, month, day));
+    out.flags = isHoliday(month, day) ? ATTENDANCE_FIXED_HOLIDAY : 0;
+    return true;
+}
+
+/**
+ * @brief Kiểm tra, nén và thêm một dòng chấm công đã tách trường.
+ */
+void AttendanceManager::appendParsedLine(std::string_view employeeId, std::string_view workDate, std::string_view checkIn,
+                                         std::string_view checkOut, std::string_view dayType, std::size_t lineNumber) {
+    PackedAttendanceRecord packed;
+    if (!packRecord(workDate, checkIn, checkOut, dayType, packed)) {
+        _diagnostics.record(IngestIssue::InvalidDate, lineNumber, workDate, employeeId);
+        return; // Bỏ qua bản ghi có ngày không đúng định dạng mong muốn
+    }
+    if (employeeId.empty()) {
+        _diagnostics.record(IngestIssue::MissingEmployeeId, lineNumber, workDate);
+        return;
+    }
+
+    packed.employeeKey = _employeeIds.intern(employeeId);
+    if (!admitRecord(packed, lineNumber)) return;
+    _records.push_back(packed);
+    _recordViewDirty = true;
+    _indexDirty = true;
+}
+
+/**
+ * @brief Kiểm tra xung đột của một bản ghi và áp dụng chính sách xử lý.
+ */
+bool AttendanceManager::admitRecord(const PackedAttendanceRecord& record, std::size_t lineNumber) {
+    const AttendanceConflict conflict = _conflicts.insert(record, _duplicatePolicy);
+    if (conflict == AttendanceConflict::None) return true;
+    const bool keep = keepsConflict(_duplicatePolicy, conflict);
+
+    const IngestIssue issue = (conflict == AttendanceConflict::Duplicate) ? IngestIssue::DuplicateRecord : IngestIssue::OverlappingRecord;
+    if (!_diagnostics.hasRoomForExample()) { // Chỉ đếm, không dựng chuỗi mô tả
+        _diagnostics.record(issue, lineNumber, std::string_view());
+        return keep;
+    }
+    std::string value = AttendanceParser::formatDate(record.workDay);
+    value.append(" ").append(AttendanceParser::formatTime(record.checkInSeconds))
+         .append("-").append(AttendanceParser::formatTime(record.checkOutSeconds));
+    _diagnostics.record(issue, lineNumber, value, _employeeIds.idOf(record.employeeKey));
+    return keep;
+}
+
+/**
+ * @brief Dựng lại bảng phát hiện xung đột từ kho bản ghi.
+ */
+void AttendanceManager::ensureConflictIndex() {
+    if (_conflictsValid) return;
+    _conflicts.clear();
+    _conflicts.reserve(_records.size());
+    for (const auto& record : _records) {
+        _conflicts.insert(record, DuplicatePolicy::Report);
+    }
+    _conflictsValid = true;
+}
+
+/**
+ * @brief Từ chối dữ liệu vừa tải nếu chính sách là Reject và có xung đột.
+ */
+bool AttendanceManager::rejectConflicts() {
+    if (_duplicatePolicy != DuplicatePolicy::Reject
+        || _diagnostics.count(IngestIssue::DuplicateRecord) + _diagnostics.count(IngestIssue::OverlappingRecord) == 0) {
+        return false;
+    }
+    std::cerr << "Loi: File cham cong " << _diagnostics.getSource()
+              << " co ban ghi trung lap hoac chong gio, du lieu bi tu choi." << std::endl;
+    resetRecords();
+    _rejected = true;
+    return true;
+}
+
+/**
+ * @brief Lấy số byte bộ nhớ của từng thành phần dữ liệu chấm công.
+ */
+AttendanceMemoryReport AttendanceManager::memoryReport() const {
+    AttendanceMemoryReport report;
+    report.recordCount = _records.size();
+    report.recordBytes = _records.capacity() * sizeof(PackedAttendanceRecord);
+    report.employeeIdCount = _employeeIds.size();
+    report.employeeIdCharBytes = _employeeIds.charBytes();
+    report.employeeIdBytes = _employeeIds.memoryBytes();
+    report.periodIndexBytes = _periodIndex.capacity() * sizeof(PeriodSlot);
+    report.conflictIndexBytes = _conflicts.memoryBytes();
+    report.recordViewBytes = _recordView.capacity() * sizeof(AttendanceRecord);
+    const std::string emptyString;
+    for (const auto& record : _recordView) {
+        for (const std::string* field : { &record.employeeId, &record.workDate, &record.checkInTime, &record.checkOutTime, &record.dayType }) {
+            if (field->capacity() > emptyString.capacity()) report.recordViewBytes += field->capacity() + 1;
+        }
+    }
+    report.summaryBytes = _summaryValues.capacity() * sizeof(AttendanceSummary)
+                        + _summaryGroups.capacity() * sizeof(std::uint64_t) + _summarySlots.capacity() * sizeof(std::uint32_t);
+    return report;
+}
+
+/**
+ * @brief Đặt cách xử lý bản ghi trùng lặp hoặc chồng giờ.
+ */
+void AttendanceManager::setDuplicatePolicy(DuplicatePolicy policy) {
+    if (policy == _duplicatePolicy) return;
+    _duplicatePolicy = policy;
+    _source.inSync = false; // Dữ liệu hiện có được lọc theo chính sách cũ
 }
 
 /**
  * @brief Thêm một bản ghi chấm công.
  */
-void AttendanceManager::addRecord(const AttendanceRecord& record) {
-    _records.push_back(record);
+bool AttendanceManager::addRecord(const AttendanceRecord& record) {
+    PackedAttendanceRecord packed;
+    if (record.employeeId.empty()
+        || !packRecord(record.workDate, record.checkInTime, record.checkOutTime, record.dayType, packed)) {
+        return false;
+    }
+    packed.employeeKey = _employeeIds.intern(record.employeeId);
+    ensureConflictIndex();
+    if (!keepsConflict(_duplicatePolicy, _conflicts.insert(packed, _duplicatePolicy))) {
+        return false;
+    }
+
+    // Chèn vào sau các bản ghi cùng (nhân viên, tháng) để kho luôn giữ thứ tự đã sắp xếp
+    const std::int32_t period = AttendanceParser::periodOfDay(packed.workDay);
+    auto position = std::upper_bound(_records.begin(), _records.end(), packed,
+        [period](const PackedAttendanceRecord& value, const PackedAttendanceRecord& element) {
+            if (value.employeeKey != element.employeeKey) return value.employeeKey < element.employeeKey;
+            return period < AttendanceParser::periodOfDay(element.workDay);
+        });
+    _records.insert(position, packed);
+    accumulate(summaryOf(periodIndexKey(packed.employeeKey, period)), packed);
+    ++_dataVersion;
+    logChange(packed.employeeKey, period);
+    _source.inSync = false; // Kho không còn trùng với file nên lần refreshFromFile() sau sẽ tải lại toàn bộ
+    _recordViewDirty = true;
+    _indexDirty = true;
+    return true;
+}
+
+/**
+ * @brief Xóa một bản ghi chấm công.
+ */
+bool AttendanceManager::removeRecord(const AttendanceRecord& record) {
+    PackedAttendanceRecord packed;
+    if (_aggregateOnly || record.employeeId.empty()
+        || !packRecord(record.workDate, record.checkInTime, record.checkOutTime, record.dayType, packed)) {
+        return false;
+    }
+    const std::uint32_t key = _employeeIds.find(record.employeeId);
+    if (key == EmployeeIdPool::npos) return false;
+
+    // Kho được sắp xếp theo (nhân viên, kỳ lương): tìm nhóm bằng tìm kiếm nhị phân rồi dò trong nhóm
+    const std::int32_t period = AttendanceParser::periodOfDay(packed.workDay);
+    const std::uint64_t group = periodIndexKey(key, period);
+    auto groupOf = [](const PackedAttendanceRecord& value) {
+        return periodIndexKey(value.employeeKey, AttendanceParser::periodOfDay(value.workDay));
+    };
+    auto it = std::lower_bound(_records.begin(), _records.end(), group,
+        [&groupOf](const PackedAttendanceRecord& element, std::uint64_t value) { return groupOf(element) < value; });
+    for (; it != _records.end() && groupOf(*it) == group; ++it) {
+        if (it->workDay == packed.workDay && it->dayType == packed.dayType
+            && it->checkInSeconds == packed.checkInSeconds && it->checkOutSeconds == packed.checkOutSeconds
+            && (it->flags & ~ATTENDANCE_FIXED_HOLIDAY) == (packed.flags & ~ATTENDANCE_FIXED_HOLIDAY)) {
+            break;
+        }
+    }
+    if (it == _records.end() || groupOf(*it) != group) return false;
+
+    // Kỳ không còn bản ghi nào vẫn giữ ô của nó: số liệu trừ về 0, giống hệt AttendanceSummary()
+    subtract(summaryOf(group), *it);
+    _records.erase(it);
+    ++_dataVersion;
+    logChange(key, period);
+    _conflictsValid = false; // Bảng phát hiện xung đột không hỗ trợ xóa: dựng lại ở lần thêm tiếp theo
+    _source.inSync = false;
+    _recordViewDirty = true;
+    _indexDirty = true;
+    return true;
+}
+
+/**
+ * @brief Ghi nhận một (nhân viên, kỳ lương) vừa thay đổi.
+ */
+void AttendanceManager::logChange(std::uint32_t employeeKey, std::int32_t period) {
+    if (_changeLog.size() >= MAX_CHANGE_LOG) { // Quá nhiều thay đổi: coi như toàn bộ dữ liệu thay đổi
+        _changeLog.clear();
+        _changeLogStart = _dataVersion;
+        return;
+    }
+    _changeLog.push_back(ChangeLogEntry{ _dataVersion, AttendanceChange{ employeeKey, period } });
+}
+
+/**
+ * @brief Lấy các (nhân viên, kỳ lương) thay đổi sau một phiên bản dữ liệu.
+ */
+bool AttendanceManager::getChangesSince(std::uint64_t version, std::vector<AttendanceChange>& changes) const {
+    changes.clear();
+    if (version < _changeLogStart || version > _dataVersion) return false;
+    for (auto it = _changeLog.rbegin(); it != _changeLog.rend() && it->version > version; ++it) {
+        changes.push_back(it->change);
+    }
+    return true;
 }
 
 /**
- * @brief Lấy danh sách tất cả các bản ghi.
+ * @brief Lấy danh sách tất cả các bản ghi (dạng chuỗi, dựng lại từ kho nén khi cần).
  */
 const std::vector<AttendanceRecord>& AttendanceManager::getRecords() const {
+    if (_recordViewDirty || _recordView.size() != _records.size()) {
+        _recordView.clear();
+        _recordView.reserve(_records.size());
+        for (const auto& packed : _records) {
+            AttendanceRecord& rec = _recordView.emplace_back();
+            rec.employeeId = _employeeIds.idOf(packed.employeeKey);
+            rec.workDate = AttendanceParser::formatDate(packed.workDay);
+            if (packed.flags & ATTENDANCE_HAS_CHECK_IN) rec.checkInTime = AttendanceParser::formatTime(packed.checkInSeconds);
+            if (packed.flags & ATTENDANCE_HAS_CHECK_OUT) rec.checkOutTime = AttendanceParser::formatTime(packed.checkOutSeconds);
+            rec.dayType = AttendanceParser::dayTypeName(packed.dayType);
+        }
+        _recordViewDirty = false;
+    }
+    return _recordView;
+}
+
+/**
+ * @brief Lấy danh sách các bản ghi dạng nén.
+ */
+const std::vector<PackedAttendanceRecord>& AttendanceManager::getPackedRecords() const {
     return _records;
 }
 
+/**
+ * @brief Lấy bảng ánh xạ mã nhân viên <-> khóa.
+ */
+const EmployeeIdPool& AttendanceManager::getEmployeeIds() const {
+    return _employeeIds;
+}
+
+std::uint64_t AttendanceManager::periodIndexKey(std::uint32_t employeeKey, std::int32_t period) {
+    return (static_cast<std::uint64_t>(employeeKey) << 32) | static_cast<std::uint32_t>(period);
+}
+
+std::size_t AttendanceManager::periodSlotOf(std::uint64_t group, std::size_t mask) {
+    std::uint64_t hash = group * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(hash ^ (hash >> 32)) & mask;
+}
+
+/**
+ * @brief Sắp xếp ổn định theo (nhân viên, tháng) rồi dựng lại số liệu tổng hợp.
+ */
+void AttendanceManager::buildIndex() {
+    // Khóa sắp xếp: (khóa nhân viên, kỳ lương) kèm vị trí gốc để giữ thứ tự ổn định
+    struct SortKey {
+        std::uint64_t group;
+        std::uint32_t position;
+    };
+    std::vector<SortKey> keys(_records.size());
+    bool sorted = true;
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        keys[i].group = periodIndexKey(_records[i].employeeKey, AttendanceParser::periodOfDay(_records[i].workDay));
+        keys[i].position = static_cast<std::uint32_t>(i);
+        if (i > 0 && keys[i].group < keys[i - 1].group) sorted = false;
+    }
+    if (!sorted) {
+        std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) {
+            return a.group != b.group ? a.group < b.group : a.position < b.position;
+        });
+        std::vector<PackedAttendanceRecord> ordered;
+        ordered.reserve(_records.size());
+        for (const auto& key : keys) {
+            ordered.push_back(_records[key.position]);
+        }
+        std::copy(ordered.begin(), ordered.end(), _records.begin()); // Giữ nguyên vùng nhớ của kho để dùng lại khi tải lại
+        _recordViewDirty = true;
+    }
+    _indexDirty = true; // Chỉ mục kỳ lương chỉ được dựng khi getRecordsFor() cần tới
+    rebuildSummaries();
+}
+
+/**
+ * @brief Dựng lại số liệu tổng hợp từ kho bản ghi bằng một lần quét.
+ */
+void AttendanceManager::rebuildSummaries() {
+    if (_aggregateOnly) return;
+    clearSummaries();
+    // Kho đã sắp xếp theo (nhân viên, kỳ lương): mỗi nhóm chỉ tra bảng băm một lần
+    AttendanceSummary* summary = nullptr;
+    std::uint64_t currentGroup = 0;
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        const std::uint64_t group = periodIndexKey(_records[i].employeeKey, AttendanceParser::periodOfDay(_records[i].workDay));
+        if (summary == nullptr || group != currentGroup) {
+            summary = &summaryOf(group);
+            currentGroup = group;
+        }
+        accumulate(*summary, _records[i]);
+    }
+}
+
+/**
+ * @brief Lấy (hoặc thêm) số liệu tổng hợp của một nhóm.
+ */
+AttendanceSummary& AttendanceManager::summaryOf(std::uint64_t group) {
+    // Hệ số tải <= 1/2; bảng chỉ được cấp phát lại khi số nhóm vượt quá mọi lần tải trước
+    if ((_summaryValues.size() + 1) * 2 > _summarySlots.size()) {
+        const std::size_t slotCount = _summarySlots.empty() ? 1024 : _summarySlots.size() * 2;
+        _summarySlots.assign(slotCount, 0);
+        const std::size_t mask = slotCount - 1;
+        for (std::size_t i = 0; i < _summaryGroups.size(); ++i) {
+            std::size_t pos = periodSlotOf(_summaryGroups[i], mask);
+            while (_summarySlots[pos] != 0) pos = (pos + 1) & mask;
+            _summarySlots[pos] = static_cast<std::uint32_t>(i + 1);
+        }
+    }
+    const std::size_t mask = _summarySlots.size() - 1;
+    std::size_t pos = periodSlotOf(group, mask);
+    for (; _summarySlots[pos] != 0; pos = (pos + 1) & mask) {
+        const std::size_t index = _summarySlots[pos] - 1;
+        if (_summaryGroups[index] == group) return _summaryValues[index];
+    }
+    _summaryGroups.push_back(group);
+    _summaryValues.emplace_back();
+    _summarySlots[pos] = static_cast<std::uint32_t>(_summaryValues.size());
+    return _summaryValues.back();
+}
+
+/**
+ * @brief Tìm số liệu tổng hợp của một nhóm.
+ */
+const AttendanceSummary* AttendanceManager::findSummary(std::uint64_t group) const {
+    if (_summaryValues.empty()) return nullptr;
+    const std::size_t mask = _summarySlots.size() - 1;
+    for (std::size_t pos = periodSlotOf(group, mask); _summarySlots[pos] != 0; pos = (pos + 1) & mask) {
+        const std::size_t index = _summarySlots[pos] - 1;
+        if (_summaryGroups[index] == group) return &_summaryValues[index];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Xóa mọi số liệu tổng hợp, giữ lại dung lượng.
+ */
+void AttendanceManager::clearSummaries() {
+    if (_summaryValues.empty()) return;
+    std::fill(_summarySlots.begin(), _summarySlots.end(), 0);
+    _summaryValues.clear();
+    _summaryGroups.clear();
+}
+
+/**
+ * @brief Sắp xếp các bản ghi mới nối thêm rồi trộn với phần đã sắp xếp.
+ */
+void AttendanceManager::mergeAppended(std::size_t firstNew) {
+    if (firstNew >= _records.size()) return;
+    ++_dataVersion;
+    for (std::size_t i = firstNew; i < _records.size(); ++i) { // Cập nhật số liệu tổng hợp O(1) mỗi bản ghi mới
+        const PackedAttendanceRecord& record = _records[i];
+        const std::int32_t period = AttendanceParser::periodOfDay(record.workDay);
+        accumulate(summaryOf(periodIndexKey(record.employeeKey, period)), record);
+        logChange(record.employeeKey, period);
+    }
+    auto groupLess = [](const PackedAttendanceRecord& a, const PackedAttendanceRecord& b) {
+        if (a.employeeKey != b.employeeKey) return a.employeeKey < b.employeeKey;
+        return AttendanceParser::periodOfDay(a.workDay) < AttendanceParser::periodOfDay(b.workDay);
+    };
+    // stable_sort và inplace_merge đều ổn định: bản ghi cũ đứng trước bản ghi mới cùng nhóm,
+    // các bản ghi mới giữ thứ tự trong file, giống hệt khi sắp xếp lại toàn bộ.
+    auto middle = _records.begin() + static_cast<std::ptrdiff_t>(firstNew);
+    std::stable_sort(middle, _records.end(), groupLess);
+    std::inplace_merge(_records.begin(), middle, _records.end(), groupLess);
+    _recordViewDirty = true;
+    _indexDirty = true;
+}
+
+/**
+ * @brief Dựng lại chỉ mục kỳ lương từ _records (đã sắp xếp) nếu cần.
+ */
+void AttendanceManager::ensureIndex() const {
+    if (!_indexDirty) return;
+    // Lần quét thứ nhất đếm số nhóm để chọn số ô (hệ số tải <= 1/2); assign() dùng lại dung lượng cũ
+    std::size_t groupCount = 0;
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        if (i == 0 || _records[i].employeeKey != _records[i - 1].employeeKey
+            || AttendanceParser::periodOfDay(_records[i].workDay) != AttendanceParser::periodOfDay(_records[i - 1].workDay)) {
+            ++groupCount;
+        }
+    }
+    std::size_t slotCount = 16;
+    while (slotCount < groupCount * 2) slotCount *= 2;
+    _periodIndex.assign(slotCount, PeriodSlot{ 0, 0, 0 });
+
+    const std::size_t mask = slotCount - 1;
+    auto insertGroup = [this, mask](std::uint64_t group, std::size_t first, std::size_t last) {
+        std::size_t pos = periodSlotOf(group, mask);
+        while (_periodIndex[pos].last != 0) pos = (pos + 1) & mask;
+        _periodIndex[pos] = PeriodSlot{ group, static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last) };
+    };
+    std::size_t groupStart = 0;
+    std::uint64_t currentGroup = 0;
+    for (std::size_t i = 0; i < _records.size(); ++i) {
+        std::uint64_t group = periodIndexKey(_records[i].employeeKey, AttendanceParser::periodOfDay(_records[i].workDay));
+        if (i > 0 && group != currentGroup) {
+            insertGroup(currentGroup, groupStart, i);
+            groupStart = i;
+        }
+        currentGroup = group;
+    }
+    if (!_records.empty()) {
+        insertGroup(currentGroup, groupStart, _records.size());
+    }
+    _indexDirty = false;
+}
+
+/**
+ * @brief Lấy các bản ghi của một nhân viên trong một kỳ lương.
+ */
+AttendanceRange AttendanceManager::getRecordsFor(const std::string& employeeId, int month, int year) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
+    if (key == EmployeeIdPool::npos) return AttendanceRange();
+    return getRecordsFor(key, month, year);
+}
+
+/**
+ * @brief Lấy các bản ghi của một nhân viên (theo khóa) trong một kỳ lương.
+ */
+AttendanceRange AttendanceManager::getRecordsFor(std::uint32_t employeeKey, int month, int year) const {
+    ensureIndex();
+    const std::uint64_t group = periodIndexKey(employeeKey, AttendanceParser::periodOf(year, month));
+    const std::size_t mask = _periodIndex.size() - 1;
+    for (std::size_t pos = periodSlotOf(group, mask); _periodIndex[pos].last != 0; pos = (pos + 1) & mask) {
+        if (_periodIndex[pos].group == group) {
+            const PackedAttendanceRecord* base = _records.data();
+            return AttendanceRange{ base + _periodIndex[pos].first, base + _periodIndex[pos].last };
+        }
+    }
+    return AttendanceRange();
+}
+
+/**
+ * @brief Cộng dồn một bản ghi vào số liệu tổng hợp (quy tắc phân loại giờ mà calculatePay() dùng để tính lương).
+ */
+void AttendanceManager::accumulate(AttendanceSummary& summary, const PackedAttendanceRecord& record) {
+    std::int64_t seconds = static_cast<std::int64_t>(record.checkOutSeconds) - record.checkInSeconds;
+    if (seconds < 0) seconds = 0; // Giờ check out < check in (dữ liệu lỗi) không được tính
+
+    const std::size_t type = static_cast<std::size_t>(record.dayType);
+    summary.workedSeconds[type] += seconds;
+    summary.dayCounts[type] += 1;
+    summary.dayTypeMask |= attendanceDayTypeBit(record.dayType);
+
+    // Cờ ATTENDANCE_FIXED_HOLIDAY được tính sẵn khi tải dữ liệu (tương đương isHoliday(workDate))
+    if ((record.flags & ATTENDANCE_FIXED_HOLIDAY) || record.dayType == AttendanceDayType::Holiday) {
+        summary.paidHolidaySeconds += seconds;
+    } else if (record.dayType == AttendanceDayType::Normal) {
+        summary.paidNormalSeconds += seconds;
+    } else if (record.dayType == AttendanceDayType::Overtime) {
+        summary.paidOvertimeSeconds += seconds;
+    }
+}
+
+/**
+ * @brief Trừ một bản ghi khỏi số liệu tổng hợp (phép ngược của accumulate()).
+ */
+void AttendanceManager::subtract(AttendanceSummary& summary, const PackedAttendanceRecord& record) {
+    std::int64_t seconds = static_cast<std::int64_t>(record.checkOutSeconds) - record.checkInSeconds;
+    if (seconds < 0) seconds = 0;
+
+    const std::size_t type = static_cast<std::size_t>(record.dayType);
+    summary.workedSeconds[type] -= seconds;
+    summary.dayCounts[type] -= 1;
+    if (summary.dayCounts[type] == 0) summary.dayTypeMask &= static_cast<std::uint8_t>(~attendanceDayTypeBit(record.dayType));
+
+    if ((record.flags & ATTENDANCE_FIXED_HOLIDAY) || record.dayType == AttendanceDayType::Holiday) {
+        summary.paidHolidaySeconds -= seconds;
+    } else if (record.dayType == AttendanceDayType::Normal) {
+        summary.paidNormalSeconds -= seconds;
+    } else if (record.dayType == AttendanceDayType::Overtime) {
+        summary.paidOvertimeSeconds -= seconds;
+    }
+}
+
+/**
+ * @brief Lấy số liệu tổng hợp của một nhân viên trong một kỳ lương.
+ */
+AttendanceSummary AttendanceManager::summarize(const std::string& employeeId, int month, int year) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
+    if (key == EmployeeIdPool::npos) return AttendanceSummary();
+    return summarize(key, month, year);
+}
+
+/**
+ * @brief Lấy số liệu tổng hợp của một nhân viên (theo khóa) trong một kỳ lương.
+ */
+AttendanceSummary AttendanceManager::summarize(std::uint32_t employeeKey, int month, int year) const {
+    // Số liệu tổng hợp luôn được cập nhật cùng kho bản ghi nên chỉ cần một lần tra O(1)
+    const AttendanceSummary* summary = findSummary(periodIndexKey(employeeKey, AttendanceParser::periodOf(year, month)));
+    return (summary != nullptr) ? *summary : AttendanceSummary();
+}
+
+/**
+ * @brief Tổng hợp số liệu của mọi nhân viên trong một kỳ lương bằng một lần quét.
+ */
+void AttendanceManager::summarizePeriod(int month, int year, std::vector<AttendanceSummary>& summaries) const {
+    const std::uint32_t keyCount = _employeeIds.size();
+    summaries.assign(keyCount, AttendanceSummary());
+    const std::int32_t period = AttendanceParser::periodOf(year, month);
+    // Mỗi khóa một lần tra O(1) vào số liệu tổng hợp được cập nhật dần
+    for (std::uint32_t key = 0; key < keyCount; ++key) {
+        if (const AttendanceSummary* summary = findSummary(periodIndexKey(key, period))) summaries[key] = *summary;
+    }
+}
+
+/**
+ * @brief Tổng hợp số liệu của mọi nhân viên trong 12 tháng của một năm.
+ */
+void AttendanceManager::summarizeYear(int year, std::vector<AttendanceSummary>& summaries) const {
+    const std::size_t keyCount = _employeeIds.size();
+    summaries.assign(keyCount * 12, AttendanceSummary());
+    const std::int32_t firstPeriod = AttendanceParser::periodOf(year, 1);
+    // Một lần duyệt số liệu tổng hợp: mỗi (nhân viên, tháng) của năm được chép đúng vào ô của nó
+    for (std::size_t i = 0; i < _summaryGroups.size(); ++i) {
+        const std::uint64_t group = _summaryGroups[i];
+        const std::int32_t month = static_cast<std::int32_t>(static_cast<std::uint32_t>(group)) - firstPeriod;
+        if (month < 0 || month >= 12) continue;
+        const std::size_t key = static_cast<std::size_t>(group >> 32);
+        summaries[static_cast<std::size_t>(month) * keyCount + key] = _summaryValues[i];
+    }
+}
+
+/**
+ * @brief Bitmask loại ngày của mọi nhân viên trong một kỳ lương.
+ */
+void AttendanceManager::dayTypeMasksForPeriod(int month, int year, std::vector<std::uint8_t>& masks) const {
+    const std::uint32_t keyCount = _employeeIds.size();
+    masks.assign(keyCount, 0);
+    const std::int32_t period = AttendanceParser::periodOf(year, month);
+    for (std::uint32_t key = 0; key < keyCount; ++key) {
+        if (const AttendanceSummary* summary = findSummary(periodIndexKey(key, period))) masks[key] = summary->dayTypeMask;
+    }
+}
+
 /**
  * @brief Tải dữ liệu chấm công từ file CSV.
  * Định dạng CSV: EmployeeID,WorkDate,CheckInTime,CheckOutTime,DayType
@@ -48,15 +712,17 @@ void AttendanceManager::loadFromFile(const std::string& filename) {
     std::ifstream inFile(filename);
     if (!inFile) {
         std::cerr << "Loi: Khong the mo file cham cong: " << filename << std::endl;
-        _records.clear(); // Đảm bảo records rỗng nếu không mở được file
+        resetRecords(); // Đảm bảo records rỗng nếu không mở được file
         return;
     }
-    _records.clear(); // Xóa dữ liệu cũ trước khi tải
+    resetRecords(); // Xóa dữ liệu cũ trước khi tải
+    _diagnostics.reset(filename);
     std::string line;
     std::getline(inFile, line); // Bỏ qua dòng tiêu đề (EmployeeID,WorkDate,...)
+    std::size_t lineNumber = 1;
 
-    int count = 0;
     while (std::getline(inFile, line)) {
+        ++lineNumber;
         if (line.empty()) continue; // Bỏ qua dòng trống
 
         std::stringstream ss(line);
@@ -75,22 +741,418 @@ void AttendanceManager::loadFromFile(const std::string& filename) {
         rec.checkOutTime.erase(rec.checkOutTime.find_last_not_of(" \n\r\t") + 1);
         rec.dayType.erase(rec.dayType.find_last_not_of(" \n\r\t") + 1);
 
-        // Kiểm tra cơ bản định dạng ngày YYYY-MM-DD (tùy chọn, nhưng nên có)
-        if (rec.workDate.length() == 10 && rec.workDate[4] == '-' && rec.workDate[7] == '-') {
-            // Định dạng có vẻ đúng
-        } else {
-            std::cerr << "CANH BAO: Dinh dang ngay khong dung YYYY-MM-DD trong attendance.csv: "
-                      << rec.workDate << " cho NV " << rec.employeeId << ". Bo qua ban ghi." << std::endl;
-            continue; // Bỏ qua bản ghi có ngày không đúng định dạng mong muốn
+        appendParsedLine(rec.employeeId, rec.workDate, rec.checkInTime, rec.checkOutTime, rec.dayType, lineNumber);
+    }
+    inFile.close();
+    buildIndex();
+    _diagnostics.printSummary(std::cerr);
+    rejectConflicts();
+    //std::cout << "Da tai " << count << " ban ghi cham cong tu file " << filename << std::endl;
+}
+
+/**
+ * @brief Đọc file CSV theo từng khối và chỉ giữ lại số liệu tổng hợp theo (nhân viên, kỳ lương).
+ */
+void AttendanceManager::loadAggregatesFromFile(const std::string& filename) {
+    std::ifstream inFile(filename, std::ios::binary);
+    resetRecords();
+    if (!inFile) {
+        std::cerr << "Loi: Khong the mo file cham cong: " << filename << std::endl;
+        return;
+    }
+    _aggregateOnly = true;
+    _indexDirty = true;
+    _diagnostics.reset(filename);
+    _conflicts.reserve(STREAM_CONFLICT_WINDOW_ROWS); // Bảng có kích thước cố định, không dựng lại trong lúc đọc
+
+    std::size_t lineNumber = 0;
+    auto foldLine = [this, &lineNumber](std::string_view line) {
+        if (++lineNumber == 1) return; // Dòng đầu tiên là dòng tiêu đề
+        if (line.empty()) return;
+        CsvFields fields = splitLine(line);
+        PackedAttendanceRecord packed;
+        if (!packRecord(fields.workDate, fields.checkIn, fields.checkOut, fields.dayType, packed)) {
+            _diagnostics.record(IngestIssue::InvalidDate, lineNumber, fields.workDate, fields.employeeId);
+            return;
+        }
+        if (fields.employeeId.empty()) {
+            _diagnostics.record(IngestIssue::MissingEmployeeId, lineNumber, fields.workDate);
+            return;
         }
 
-        if (!rec.employeeId.empty()) {
-            _records.push_back(rec);
-            count++;
+        packed.employeeKey = _employeeIds.intern(fields.employeeId);
+        if (_conflicts.size() >= STREAM_CONFLICT_WINDOW_ROWS) {
+            _conflicts.clear(); // Đầy cửa sổ: bắt đầu cửa sổ mới để bộ nhớ không tăng theo số dòng
+        }
+        if (!admitRecord(packed, lineNumber)) return;
+        accumulate(summaryOf(periodIndexKey(packed.employeeKey, AttendanceParser::periodOfDay(packed.workDay))), packed);
+        ++_aggregatedRecordCount;
+    };
+
+    // Bộ nhớ dùng: một khối đọc + phần dòng dở dang ở cuối khối + cửa sổ kiểm tra trùng lặp + số liệu tổng hợp
+    std::vector<char> block(STREAM_BLOCK_BYTES);
+    std::string carry; // Dòng bị cắt ngang giữa hai khối
+    while (inFile) {
+        inFile.read(block.data(), static_cast<std::streamsize>(block.size()));
+        std::string_view text(block.data(), static_cast<std::size_t>(inFile.gcount()));
+        if (text.empty()) break;
+
+        std::size_t lineStart = 0;
+        std::size_t newline = text.find('\n');
+        if (!carry.empty()) {
+            if (newline == std::string_view::npos) { // Dòng dài hơn cả khối
+                carry.append(text);
+                continue;
+            }
+            carry.append(text.substr(0, newline));
+            foldLine(carry);
+            carry.clear();
+            lineStart = newline + 1;
+            newline = text.find('\n', lineStart);
+        }
+        while (newline != std::string_view::npos) {
+            foldLine(text.substr(lineStart, newline - lineStart));
+            lineStart = newline + 1;
+            newline = text.find('\n', lineStart);
         }
+        carry.assign(text.substr(lineStart));
     }
-    inFile.close();
-    //std::cout << "Da tai " << count << " ban ghi cham cong tu file " << filename << std::endl;
+    if (!carry.empty()) {
+        foldLine(carry);
+    }
+    _diagnostics.printSummary(std::cerr);
+    rejectConflicts();
+}
+
+/**
+ * @brief Phân tích một đoạn CSV vào bộ đệm riêng (không đụng tới dữ liệu của đối tượng).
+ */
+void AttendanceManager::parseChunk(std::string_view text, ParsedChunk& chunk) {
+    // Các dòng được gom thành lô PARSE_BATCH_ROWS dòng; cột ngày và hai cột giờ của cả lô được
+    // chuyển đổi một lần bằng AttendanceParser::parseDates()/parseTimes() (SWAR). Phần tử bị
+    // đánh dấu trong mặt nạ: ngày sai thì bỏ dòng, giờ khác định dạng chuẩn thì đọc bằng parseTime().
+    ColumnBatch batch;
+    std::vector<AttendanceParser::CivilDate> dates(PARSE_BATCH_ROWS);
+    std::vector<std::int32_t> checkIns(PARSE_BATCH_ROWS), checkOuts(PARSE_BATCH_ROWS);
+    const std::size_t words = AttendanceParser::maskWords(PARSE_BATCH_ROWS);
+    std::vector<std::uint64_t> badDates(words), badCheckIns(words), badCheckOuts(words);
+
+    auto packBatch = [&]() {
+        const std::size_t count = batch.employeeIds.size();
+        AttendanceParser::parseDates(batch.workDates.data(), count, dates.data(), badDates.data());
+        AttendanceParser::parseTimes(batch.checkIns.data(), count, checkIns.data(), badCheckIns.data());
+        AttendanceParser::parseTimes(batch.checkOuts.data(), count, checkOuts.data(), badCheckOuts.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            PackedAttendanceRecord packed;
+            const AttendanceParser::CivilDate& date = dates[i];
+            if (AttendanceParser::isMarked(badDates.data(), i) || !packDate(date.year, date.month, date.day, packed)) {
+                chunk.diagnostics.record(IngestIssue::InvalidDate, batch.lineNumbers[i], batch.workDates[i], batch.employeeIds[i]);
+                continue;
+            }
+            if (batch.employeeIds[i].empty()) {
+                chunk.diagnostics.record(IngestIssue::MissingEmployeeId, batch.lineNumbers[i], batch.workDates[i]);
+                continue;
+            }
+
+            packed.checkInSeconds = AttendanceParser::isMarked(badCheckIns.data(), i)
+                ? AttendanceParser::parseTime(batch.checkIns[i]) : checkIns[i];
+            packed.checkOutSeconds = AttendanceParser::isMarked(badCheckOuts.data(), i)
+                ? AttendanceParser::parseTime(batch.checkOuts[i]) : checkOuts[i];
+            packed.dayType = AttendanceParser::parseDayType(batch.dayTypes[i]);
+            if (!batch.checkIns[i].empty()) packed.flags |= ATTENDANCE_HAS_CHECK_IN;
+            if (!batch.checkOuts[i].empty()) packed.flags |= ATTENDANCE_HAS_CHECK_OUT;
+            packed.employeeKey = chunk.localIds.intern(batch.employeeIds[i]);
+            chunk.records.push_back(packed);
+            chunk.lineNumbers.push_back(static_cast<std::uint32_t>(batch.lineNumbers[i]));
+        }
+        batch.clear();
+    };
+
+    std::size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        std::size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = text.size();
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        ++chunk.lineCount;
+        if (line.empty()) continue;
+
+        batch.push(splitLine(line), chunk.lineCount);
+        if (batch.employeeIds.size() == PARSE_BATCH_ROWS) packBatch();
+    }
+    if (!batch.employeeIds.empty()) packBatch();
+}
+
+/**
+ * @brief Gộp một đoạn đã phân tích vào kho bản ghi.
+ */
+void AttendanceManager::mergeChunk(ParsedChunk& chunk, std::size_t lineOffset) {
+    // Khóa cục bộ được cấp theo thứ tự xuất hiện trong đoạn, nên intern lần lượt sẽ cho
+    // đúng thứ tự khóa chung như khi phân tích tuần tự.
+    std::vector<std::uint32_t> keyMap(chunk.localIds.size());
+    for (std::uint32_t localKey = 0; localKey < chunk.localIds.size(); ++localKey) {
+        keyMap[localKey] = _employeeIds.intern(chunk.localIds.idOf(localKey));
+    }
+    _diagnostics.merge(chunk.diagnostics, lineOffset);
+    // Xung đột được kiểm tra ở đây (tuần tự, theo thứ tự file) vì bản ghi trùng có thể nằm ở hai đoạn khác nhau
+    _records.reserve(_records.size() + chunk.records.size());
+    for (std::size_t i = 0; i < chunk.records.size(); ++i) {
+        PackedAttendanceRecord record = chunk.records[i];
+        record.employeeKey = keyMap[record.employeeKey];
+        if (!admitRecord(record, lineOffset + chunk.lineNumbers[i])) continue;
+        _records.push_back(record);
+    }
+    _recordViewDirty = true;
+    _indexDirty = true;
+}
+
+/**
+ * @brief Xóa toàn bộ dữ liệu chấm công hiện có.
+ */
+void AttendanceManager::resetRecords() {
+    ++_dataVersion;
+    _changeLog.clear();
+    _changeLogStart = _dataVersion;
+    _source.inSync = false;
+    _aggregateOnly = false;
+    _aggregatedRecordCount = 0;
+    _rejected = false;
+    clearSummaries();
+    _records.clear();
+    _employeeIds.clear();
+    _conflicts.clear();
+    _conflictsValid = true;
+    _recordViewDirty = true;
+    _indexDirty = true;
+}
+
+/**
+ * @brief Tải dữ liệu chấm công từ file CSV bằng memory-map, tách trường bằng string_view.
+ */
+void AttendanceManager::loadFromFileMapped(const std::string& filename) {
+    MappedFile file;
+    resetRecords();
+    if (!file.open(filename)) {
+        std::cerr << "Loi: Khong the mo file cham cong: " << filename << std::endl;
+        return;
+    }
+
+    _diagnostics.reset(filename);
+    ParsedChunk chunk;
+    parseChunk(skipHeader(file.view()), chunk);
+    mergeChunk(chunk, 1);
+    buildIndex();
+    _diagnostics.printSummary(std::cerr);
+    rejectConflicts();
+}
+
+/**
+ * @brief Tải dữ liệu chấm công từ file CSV bằng nhiều luồng, gộp kết quả theo thứ tự gốc.
+ */
+void AttendanceManager::loadFromFileParallel(const std::string& filename, unsigned threadCount) {
+    MappedFile file;
+    resetRecords();
+    if (!file.open(filename)) {
+        std::cerr << "Loi: Khong the mo file cham cong: " << filename << std::endl;
+        return;
+    }
+    _diagnostics.reset(filename);
+    appendRowsParallel(skipHeader(file.view()), threadCount, 1);
+    buildIndex();
+    _diagnostics.printSummary(std::cerr);
+    rejectConflicts();
+}
+
+/**
+ * @brief Tải dữ liệu chấm công, ưu tiên dùng cache nhị phân nếu cache còn khớp với file CSV.
+ */
+void AttendanceManager::loadFromFileCached(const std::string& filename, unsigned threadCount) {
+    MappedFile file;
+    resetRecords();
+    if (!file.open(filename)) {
+        std::cerr << "Loi: Khong the mo file cham cong: " << filename << std::endl;
+        return;
+    }
+
+    _diagnostics.reset(filename);
+    const std::string cacheFile = AttendanceCache::cachePathFor(filename);
+    std::int64_t modified = 0;
+    bool hasModified = AttendanceCache::lastModified(filename, modified);
+    if (hasModified && AttendanceCache::load(cacheFile, file.view(), modified, _duplicatePolicy, _records, _employeeIds)) {
+        _recordViewDirty = true;
+        _indexDirty = true;
+        _conflictsValid = false; // Chỉ dựng lại khi cần (refreshFromFile() nối thêm, addRecord())
+        buildIndex(); // Bản ghi trong cache đã được sắp xếp nên chỉ dựng lại số liệu tổng hợp
+        rememberSource(filename, file.view(), modified, countLines(file.view()));
+        return;
+    }
+
+    // Cache không có, đã cũ hoặc bị hỏng: phân tích lại file CSV rồi ghi cache mới
+    resetRecords();
+    const std::size_t lineCount = 1 + appendRowsParallel(skipHeader(file.view()), threadCount, 1);
+    buildIndex();
+    _diagnostics.printSummary(std::cerr);
+    if (rejectConflicts()) return;
+    if (hasModified) {
+        AttendanceCache::save(cacheFile, file.view(), modified, _duplicatePolicy, _records, _employeeIds);
+        rememberSource(filename, file.view(), modified, lineCount);
+    }
+}
+
+/**
+ * @brief Cập nhật dữ liệu chấm công của một kỳ lương từ thư mục phân vùng.
+ */
+void AttendanceManager::refreshPartition(const std::string& directory, int month, int year, unsigned threadCount) {
+    const std::string path = AttendancePartitions::pathFor(directory, month, year);
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(std::filesystem::u8path(path), error)) {
+        resetRecords(); // Tháng không có dữ liệu chấm công
+        return;
+    }
+    refreshFromFile(path, threadCount);
+}
+
+/**
+ * @brief Tải dữ liệu chấm công của cả năm từ thư mục phân vùng.
+ */
+void AttendanceManager::loadPartitionYear(const std::string& directory, int year, unsigned threadCount) {
+    resetRecords();
+    for (int month = 1; month <= 12; ++month) {
+        const std::string path = AttendancePartitions::pathFor(directory, month, year);
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(std::filesystem::u8path(path), error)) continue;
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << "Loi: Khong the mo file cham cong: " << path << std::endl;
+            continue;
+        }
+        _diagnostics.reset(path);
+        appendRowsParallel(skipHeader(file.view()), threadCount, 1);
+        _diagnostics.printSummary(std::cerr);
+        if (rejectConflicts()) return;
+    }
+    buildIndex(); // Sắp xếp và dựng số liệu tổng hợp một lần cho cả năm
+}
+
+/**
+ * @brief Ghi nhận trạng thái file nguồn vừa được tải đầy đủ vào kho.
+ */
+void AttendanceManager::rememberSource(const std::string& filename, std::string_view content, std::int64_t modified,
+                                       std::size_t lineCount) {
+    _source.filename = filename;
+    _source.size = content.size();
+    _source.modified = modified;
+    _source.checksum = AttendanceCache::checksum(content.data(), content.size());
+    _source.lineCount = lineCount;
+    _source.endsWithNewline = !content.empty() && content.back() == '\n';
+    _source.inSync = true;
+    _source.cacheStale = false;
+}
+
+/**
+ * @brief Ghi lại cache của file nguồn sau các lần nối thêm dòng (nếu file vẫn đúng như lần đọc cuối).
+ */
+bool AttendanceManager::flushCache() {
+    if (!_source.cacheStale || !_source.inSync) return false;
+    _source.cacheStale = false;
+
+    std::int64_t modified = 0;
+    MappedFile file;
+    if (!AttendanceCache::lastModified(_source.filename, modified) || modified != _source.modified
+        || !file.open(_source.filename) || file.size() != _source.size) {
+        return false;
+    }
+    return AttendanceCache::save(AttendanceCache::cachePathFor(_source.filename), file.view(), modified,
+                                 _duplicatePolicy, _records, _employeeIds);
+}
+
+/**
+ * @brief Tải lại dữ liệu chấm công chỉ khi file thay đổi; chỉ phân tích phần được nối thêm nếu có thể.
+ */
+void AttendanceManager::refreshFromFile(const std::string& filename, unsigned threadCount) {
+    std::int64_t modified = 0;
+    std::error_code error;
+    const std::uint64_t size = std::filesystem::file_size(std::filesystem::u8path(filename), error);
+    if (error || !AttendanceCache::lastModified(filename, modified)
+        || !_source.inSync || _source.filename != filename) {
+        flushCache(); // Giữ lại phần nối thêm của file cũ trước khi kho bị thay
+        loadFromFileCached(filename, threadCount);
+        return;
+    }
+
+    // File không đổi: giữ nguyên dữ liệu đã tải
+    if (size == _source.size && modified == _source.modified) {
+        return;
+    }
+
+    // File chỉ được nối thêm: toàn bộ phần đã đọc (kiểm tra qua checksum) không đổi
+    // và lần trước file kết thúc bằng ký tự xuống dòng (không có dòng dở dang).
+    if (size > _source.size && _source.endsWithNewline) {
+        MappedFile file;
+        if (file.open(filename) && file.size() > _source.size) {
+            std::string_view content = file.view();
+            const std::size_t oldSize = static_cast<std::size_t>(_source.size);
+            if (AttendanceCache::checksum(content.data(), oldSize) == _source.checksum) {
+                const std::size_t firstNew = _records.size();
+                _diagnostics.reset(filename);
+                ensureConflictIndex();
+                const std::size_t newLines = appendRowsParallel(content.substr(oldSize), threadCount, _source.lineCount);
+                mergeAppended(firstNew);
+                _diagnostics.printSummary(std::cerr);
+                if (rejectConflicts()) return;
+                rememberSource(filename, content, modified, _source.lineCount + newLines);
+                _source.cacheStale = true; // Cache được ghi lại một lần ở flushCache(), không phải mỗi lần nối thêm
+                return;
+            }
+        }
+    }
+
+    // Các trường hợp khác (file bị sửa, bị cắt ngắn...): tải lại toàn bộ
+    loadFromFileCached(filename, threadCount);
+}
+
+/**
+ * @brief Phân tích các dòng dữ liệu CSV bằng nhiều luồng và nối vào cuối kho.
+ */
+std::size_t AttendanceManager::appendRowsParallel(std::string_view body, unsigned threadCount, std::size_t lineOffset) {
+    // Số đoạn: theo số luồng nhưng mỗi đoạn không nhỏ hơn PARALLEL_MIN_CHUNK_BYTES
+    std::size_t chunkCount = ThreadPool::resolveThreadCount(threadCount);
+    chunkCount = (std::min)(chunkCount, body.size() / PARALLEL_MIN_CHUNK_BYTES);
+    if (chunkCount < 1) chunkCount = 1;
+
+    // Chia file tại ranh giới dòng: mỗi đoạn kết thúc ngay sau một ký tự '\n'
+    std::vector<std::string_view> pieces;
+    std::size_t start = 0;
+    for (std::size_t i = 1; i <= chunkCount && start < body.size(); ++i) {
+        std::size_t end = body.size();
+        if (i < chunkCount) {
+            std::size_t target = (std::max)(start, body.size() / chunkCount * i);
+            std::size_t newline = body.find('\n', target);
+            end = (newline == std::string_view::npos) ? body.size() : newline + 1;
+        }
+        pieces.push_back(body.substr(start, end - start));
+        start = end;
+    }
+
+    std::vector<ParsedChunk> chunks(pieces.size());
+    if (pieces.size() <= 1) {
+        if (!pieces.empty()) parseChunk(pieces[0], chunks[0]);
+    } else {
+        ThreadPool pool(static_cast<unsigned>(pieces.size()));
+        std::vector<std::future<void>> pending;
+        for (std::size_t i = 0; i < pieces.size(); ++i) {
+            pending.push_back(pool.submit([&pieces, &chunks, i] { parseChunk(pieces[i], chunks[i]); }));
+        }
+        for (auto& task : pending) task.get();
+    }
+
+    std::size_t lineCount = 0;
+    for (auto& chunk : chunks) {
+        mergeChunk(chunk, lineOffset + lineCount);
+        lineCount += chunk.lineCount;
+    }
+    return lineCount;
 }
 
 /**
@@ -102,15 +1164,69 @@ bool AttendanceManager::isHoliday(const std::string& date) const {
     return std::find(_holidays.begin(), _holidays.end(), monthDay) != _holidays.end();
 }
 
+/**
+ * @brief Kiểm tra ngày lễ cố định theo tháng/ngày (không cấp phát chuỗi).
+ */
+bool AttendanceManager::isHoliday(int month, int day) {
+    for (const auto& holiday : _holidays) {
+        if (holiday.size() == 5 && (holiday[0] - '0') * 10 + (holiday[1] - '0') == month
+            && (holiday[3] - '0') * 10 + (holiday[4] - '0') == day) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Số giờ/số ngày chấm công của một nhân viên trong một kỳ lương.
+ */
+AttendanceTotals AttendanceManager::getAttendanceTotals(const std::string& employeeId, int month, int year) const {
+    return totalsOf(summarize(employeeId, month, year));
+}
+
+/**
+ * @brief Quy đổi số liệu tổng hợp sang số giờ/số ngày hiển thị.
+ */
+AttendanceTotals AttendanceManager::totalsOf(const AttendanceSummary& summary) {
+    AttendanceTotals totals;
+    totals.workHours = static_cast<int>(summary.workedSeconds[static_cast<std::size_t>(AttendanceDayType::Normal)] / 3600);
+    totals.overtimeHours = static_cast<int>(summary.workedSeconds[static_cast<std::size_t>(AttendanceDayType::Overtime)] / 3600);
+    totals.holidayWorkDays = static_cast<int>(summary.dayCounts[static_cast<std::size_t>(AttendanceDayType::Holiday)]);
+    totals.leavePaidDays = static_cast<int>(summary.dayCounts[static_cast<std::size_t>(AttendanceDayType::Leave)]);
+    totals.leaveUnpaidDays = static_cast<int>(summary.dayCounts[static_cast<std::size_t>(AttendanceDayType::LeaveUnpaid)]);
+    return totals;
+}
+
+int AttendanceManager::getTotalWorkHours(const std::string& employeeId, int month, int year) const {
+    return getAttendanceTotals(employeeId, month, year).workHours;
+}
+
+int AttendanceManager::getOvertimeHours(const std::string& employeeId, int month, int year) const {
+    return getAttendanceTotals(employeeId, month, year).overtimeHours;
+}
+
+int AttendanceManager::getHolidayWorkDays(const std::string& employeeId, int month, int year) const {
+    return getAttendanceTotals(employeeId, month, year).holidayWorkDays;
+}
+
+int AttendanceManager::getLeaveUnpaidDays(const std::string& employeeId, int month, int year) const {
+    return getAttendanceTotals(employeeId, month, year).leaveUnpaidDays;
+}
+
+int AttendanceManager::getLeavePaidDays(const std::string& employeeId, int month, int year) const {
+    return getAttendanceTotals(employeeId, month, year).leavePaidDays;
+}
+
 // --- CÁC HÀM TÍNH TOÁN THEO LOGIC CŨ CỦA BẠN (ĐÃ SỬA) ---
 
 int AttendanceManager::getTotalWorkHours(const std::string& employeeId) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
     double totalHours = 0;
     for (const auto& record : _records) {
-        if (record.employeeId == employeeId && record.dayType == "normal") {
-            // Tính toán thời gian từ string
-            if (!record.checkInTime.empty() && !record.checkOutTime.empty()) {
-                totalHours += (timeToSeconds(record.checkOutTime) - timeToSeconds(record.checkInTime)) / 3600.0;
+        if (record.employeeKey == key && record.dayType == AttendanceDayType::Normal) {
+            // Chỉ tính khi có đủ giờ vào/ra
+            if ((record.flags & ATTENDANCE_HAS_CHECK_IN) && (record.flags & ATTENDANCE_HAS_CHECK_OUT)) {
+                totalHours += (record.checkOutSeconds - record.checkInSeconds) / 3600.0;
             }
         }
     }
@@ -118,12 +1234,13 @@ int AttendanceManager::getTotalWorkHours(const std::string& employeeId) const {
 }
 
 int AttendanceManager::getOvertimeHours(const std::string& employeeId) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
     double overtimeHours = 0;
     for (const auto& record : _records) {
-        if (record.employeeId == employeeId && record.dayType == "overtime") {
-            // Tính toán thời gian từ string
-            if (!record.checkInTime.empty() && !record.checkOutTime.empty()) {
-                overtimeHours += (timeToSeconds(record.checkOutTime) - timeToSeconds(record.checkInTime)) / 3600.0;
+        if (record.employeeKey == key && record.dayType == AttendanceDayType::Overtime) {
+            // Chỉ tính khi có đủ giờ vào/ra
+            if ((record.flags & ATTENDANCE_HAS_CHECK_IN) && (record.flags & ATTENDANCE_HAS_CHECK_OUT)) {
+                overtimeHours += (record.checkOutSeconds - record.checkInSeconds) / 3600.0;
             }
         }
     }
@@ -131,9 +1248,10 @@ int AttendanceManager::getOvertimeHours(const std::string& employeeId) const {
 }
 
 int AttendanceManager::getHolidayWorkDays(const std::string& employeeId) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
     int holidayDays = 0;
     for (const auto& record : _records) {
-        if (record.employeeId == employeeId && record.dayType == "holiday") {
+        if (record.employeeKey == key && record.dayType == AttendanceDayType::Holiday) {
             holidayDays++;
         }
     }
@@ -141,9 +1259,10 @@ int AttendanceManager::getHolidayWorkDays(const std::string& employeeId) const {
 }
 
 int AttendanceManager::getLeaveUnpaidDays(const std::string& employeeId) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
     int unpaidDays = 0;
     for (const auto& record : _records) {
-        if (record.employeeId == employeeId && record.dayType == "leave_unpaid") {
+        if (record.employeeKey == key && record.dayType == AttendanceDayType::LeaveUnpaid) {
             unpaidDays++;
         }
     }
@@ -151,11 +1270,12 @@ int AttendanceManager::getLeaveUnpaidDays(const std::string& employeeId) const {
 }
 
 int AttendanceManager::getLeavePaidDays(const std::string& employeeId) const {
+    std::uint32_t key = _employeeIds.find(employeeId);
     int leaveDays = 0;
     for (const auto& record : _records) {
-        if (record.employeeId == employeeId && record.dayType == "leave") {
+        if (record.employeeKey == key && record.dayType == AttendanceDayType::Leave) {
             leaveDays++;
         }
     }
     return leaveDays;
-}
\ No newline at end of file
+}
@@ -2,7 +2,13 @@
 #define ATTENDANCE_MANAGER_H
 
 #include "globaldefinitions.h" // Đảm bảo đường dẫn này đúng
+#include "EmployeeIdPool.h"
+#include "IngestDiagnostics.h"
+#include "AttendanceConflictIndex.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 /**
@@ -10,19 +16,284 @@
  * @brief Định nghĩa lớp AttendanceManager để quản lý dữ liệu chấm công.
  */
 
+/**
+ * @struct AttendanceRange
+ * @brief Một dãy liên tiếp các bản ghi chấm công dạng nén (dùng được với vòng lặp range-for).
+ */
+struct AttendanceRange {
+    const PackedAttendanceRecord* first = nullptr; ///< @brief Bản ghi đầu tiên của dãy.
+    const PackedAttendanceRecord* last = nullptr;  ///< @brief Vị trí ngay sau bản ghi cuối cùng.
+
+    const PackedAttendanceRecord* begin() const { return first; }
+    const PackedAttendanceRecord* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * @struct AttendanceChange
+ * @brief Một cặp (nhân viên, kỳ lương) có số liệu chấm công vừa thay đổi.
+ */
+struct AttendanceChange {
+    std::uint32_t employeeKey = 0; ///< @brief Khóa nhân viên (xem AttendanceManager::getEmployeeIds()).
+    std::int32_t period = 0;       ///< @brief Mã kỳ lương (AttendanceParser::periodOf()).
+};
+
+/**
+ * @struct AttendanceTotals
+ * @brief Số giờ/số ngày chấm công của một nhân viên trong một kỳ lương, dạng hiển thị (giờ đã làm tròn xuống).
+ */
+struct AttendanceTotals {
+    int workHours = 0;       ///< @brief Số giờ làm việc bình thường (bản ghi `normal`).
+    int overtimeHours = 0;   ///< @brief Số giờ tăng ca (bản ghi `overtime`).
+    int holidayWorkDays = 0; ///< @brief Số ngày làm việc trong ngày lễ (bản ghi `holiday`).
+    int leavePaidDays = 0;   ///< @brief Số ngày nghỉ phép có lương (bản ghi `leave`).
+    int leaveUnpaidDays = 0; ///< @brief Số ngày nghỉ không lương (bản ghi `leave_unpaid`).
+};
+
+/**
+ * @struct AttendanceMemoryReport
+ * @brief Số byte bộ nhớ mà các thành phần dữ liệu chấm công đang giữ (theo dung lượng đã cấp phát).
+ */
+struct AttendanceMemoryReport {
+    std::size_t recordCount = 0;          ///< @brief Số bản ghi trong kho.
+    std::size_t recordBytes = 0;          ///< @brief Kho bản ghi nén.
+    std::size_t employeeIdCount = 0;      ///< @brief Số mã nhân viên.
+    std::size_t employeeIdCharBytes = 0;  ///< @brief Số byte ký tự của các mã nhân viên (trong arena).
+    std::size_t employeeIdBytes = 0;      ///< @brief Bảng mã nhân viên (arena, danh sách mã, bảng băm).
+    std::size_t periodIndexBytes = 0;     ///< @brief Chỉ mục kỳ lương.
+    std::size_t conflictIndexBytes = 0;   ///< @brief Bảng phát hiện bản ghi trùng lặp/chồng giờ.
+    std::size_t recordViewBytes = 0;      ///< @brief Danh sách AttendanceRecord dạng chuỗi (kể cả chuỗi dài hơn bộ đệm SSO).
+    std::size_t summaryBytes = 0;         ///< @brief Số liệu tổng hợp theo (nhân viên, kỳ lương), gồm bảng băm tra cứu.
+
+    /** @brief Tổng số byte của mọi thành phần. */
+    std::size_t totalBytes() const {
+        return recordBytes + employeeIdBytes + periodIndexBytes + conflictIndexBytes + recordViewBytes + summaryBytes;
+    }
+};
+
 /**
  * @class AttendanceManager
  * @brief Lớp quản lý danh sách các bản ghi chấm công của nhân viên.
  *
  * Lớp này chịu trách nhiệm lưu trữ, tải từ file, và cung cấp các phương thức
  * để truy vấn thông tin chấm công như tổng giờ làm, giờ tăng ca, ngày lễ, v.v.
- * Nó làm việc với cấu trúc `AttendanceRecord` bao gồm cả `dayType`.
+ * Dữ liệu được lưu ở dạng nén `PackedAttendanceRecord` (16 byte/bản ghi, mã nhân viên
+ * được "intern" qua EmployeeIdPool); danh sách `AttendanceRecord` dạng chuỗi vẫn được
+ * cung cấp qua getRecords() cho các nơi gọi cũ.
+ *
+ * Các bản ghi được sắp xếp ổn định (stable) theo (nhân viên, tháng) để mỗi cặp
+ * (nhân viên, tháng, năm) ứng với một dãy bản ghi liên tiếp; chỉ mục kỳ lương chỉ được dựng ở lần
+ * gọi getRecordsFor() đầu tiên sau khi dữ liệu thay đổi (mọi phép tính lương đều đọc số liệu tổng hợp).
+ *
+ * Khi tải lại, mọi thành phần (kho bản ghi, ký tự mã nhân viên trong MonotonicArena, các bảng
+ * băm địa chỉ mở) được thu hồi một lần và giữ lại dung lượng, nên tải lại nhiều lần trong một
+ * phiên không làm phân mảnh heap; xem memoryReport().
+ *
+ * Khi tải, mỗi bản ghi được kiểm tra với các bản ghi trước đó qua AttendanceConflictIndex:
+ * bản ghi trùng hoàn toàn hoặc chồng giờ (cùng nhân viên, cùng ngày) được xử lý theo
+ * DuplicatePolicy (mặc định giữ bản ghi đầu tiên) và được ghi nhận vào getLoadDiagnostics().
  */
 class AttendanceManager {
 private:
-    std::vector<AttendanceRecord> _records;
+    std::vector<PackedAttendanceRecord> _records;       ///< @brief Kho bản ghi chấm công dạng nén (dữ liệu gốc).
+    EmployeeIdPool _employeeIds;                        ///< @brief Bảng ánh xạ mã nhân viên <-> khóa 32-bit.
+    mutable std::vector<AttendanceRecord> _recordView;  ///< @brief Bản dạng chuỗi của _records, chỉ dựng lại khi getRecords() được gọi.
+    mutable bool _recordViewDirty = false;              ///< @brief Cờ cho biết _recordView đã cũ so với _records.
     static std::vector<std::string> _holidays; // Danh sách ngày lễ cố định
 
+    /**
+     * @struct PeriodSlot
+     * @brief Một ô của chỉ mục kỳ lương: nhóm (khóa nhân viên, kỳ lương) -> [first, last) trong _records.
+     * Ô trống có last = 0 (một nhóm luôn có ít nhất một bản ghi).
+     */
+    struct PeriodSlot {
+        std::uint64_t group;
+        std::uint32_t first;
+        std::uint32_t last;
+    };
+
+    /// @brief Chỉ mục kỳ lương: bảng băm địa chỉ mở (dò tuyến tính), số ô là lũy thừa của 2.
+    mutable std::vector<PeriodSlot> _periodIndex;
+    mutable bool _indexDirty = true; ///< @brief Cờ cho biết _periodIndex cần được dựng lại.
+
+    /// @brief Số liệu tổng hợp theo (khóa nhân viên, kỳ lương), luôn khớp với kho bản ghi: dựng lại khi tải,
+    /// cập nhật O(1) cho mỗi bản ghi được thêm/xóa sau đó (ở chế độ chỉ-tổng-hợp đây là dữ liệu duy nhất).
+    /// Lưu liền nhau: _summaryValues[i] là số liệu của nhóm _summaryGroups[i].
+    std::vector<AttendanceSummary> _summaryValues;
+    std::vector<std::uint64_t> _summaryGroups;
+    /// @brief Bảng băm địa chỉ mở (dò tuyến tính, số ô là lũy thừa của 2): nhóm -> vị trí trong _summaryValues + 1 (0: ô trống).
+    std::vector<std::uint32_t> _summarySlots;
+    bool _aggregateOnly = false;              ///< @brief Dữ liệu được tải bằng loadAggregatesFromFile() (không có bản ghi gốc).
+    std::size_t _aggregatedRecordCount = 0;   ///< @brief Số bản ghi đã được cộng dồn vào _summaryValues.
+    bool _rejected = false;                   ///< @brief Lần tải gần nhất bị từ chối theo DuplicatePolicy::Reject.
+    std::uint64_t _dataVersion = 0;           ///< @brief Phiên bản dữ liệu, tăng mỗi khi kho chấm công thay đổi.
+
+    /**
+     * @struct ChangeLogEntry
+     * @brief Một thay đổi gia tăng và phiên bản dữ liệu sau thay đổi đó.
+     */
+    struct ChangeLogEntry {
+        std::uint64_t version;
+        AttendanceChange change;
+    };
+    std::vector<ChangeLogEntry> _changeLog;  ///< @brief Các (nhân viên, kỳ lương) thay đổi kể từ phiên bản _changeLogStart.
+    std::uint64_t _changeLogStart = 0;       ///< @brief Mọi thay đổi sau phiên bản này đều có trong _changeLog.
+
+    /** @brief Số thay đổi tối đa được ghi nhận; vượt quá thì coi như toàn bộ dữ liệu thay đổi. */
+    static constexpr std::size_t MAX_CHANGE_LOG = 4096;
+
+    /**
+     * @brief Ghi nhận (nhân viên, kỳ lương) vừa thay đổi ở phiên bản dữ liệu hiện tại.
+     */
+    void logChange(std::uint32_t employeeKey, std::int32_t period);
+
+    /**
+     * @brief Dựng lại _summaryValues từ kho bản ghi (đã sắp xếp) bằng một lần quét (không dùng ở chế độ chỉ-tổng-hợp).
+     */
+    void rebuildSummaries();
+
+    /**
+     * @brief Lấy số liệu tổng hợp của một nhóm (khóa nhân viên, kỳ lương), thêm số liệu rỗng nếu nhóm chưa có.
+     * Tham chiếu trả về bị vô hiệu khi thêm nhóm mới.
+     */
+    AttendanceSummary& summaryOf(std::uint64_t group);
+
+    /**
+     * @brief Tìm số liệu tổng hợp của một nhóm (khóa nhân viên, kỳ lương).
+     * @return nullptr nếu nhóm chưa có bản ghi nào.
+     */
+    const AttendanceSummary* findSummary(std::uint64_t group) const;
+
+    /**
+     * @brief Xóa mọi số liệu tổng hợp, giữ lại dung lượng các mảng để dùng lại cho lần tải sau.
+     */
+    void clearSummaries();
+
+    /**
+     * @brief Tạo khóa tra cứu của chỉ mục từ khóa nhân viên và mã kỳ lương.
+     */
+    static std::uint64_t periodIndexKey(std::uint32_t employeeKey, std::int32_t period);
+
+    /**
+     * @brief Vị trí bắt đầu dò của một nhóm trong _periodIndex.
+     */
+    static std::size_t periodSlotOf(std::uint64_t group, std::size_t mask);
+
+    /**
+     * @brief Dựng lại _periodIndex bằng một lần quét qua _records (đã được sắp xếp).
+     * Được gọi tự động trước khi tra cứu nếu chỉ mục đã cũ.
+     */
+    void ensureIndex() const;
+
+    /**
+     * @brief Chuyển các trường dạng chuỗi của một bản ghi thành PackedAttendanceRecord (trừ employeeKey).
+     * @return false nếu ngày làm việc không đúng định dạng "YYYY-MM-DD".
+     */
+    static bool packRecord(std::string_view workDate, std::string_view checkIn, std::string_view checkOut,
+                           std::string_view dayType, PackedAttendanceRecord& out);
+
+    /**
+     * @brief Ghi ngày làm việc vào bản ghi nén và đặt lại cờ (chỉ giữ cờ ngày lễ cố định nếu có).
+     * @return false nếu năm nằm ngoài phạm vi 1970-2149.
+     */
+    static bool packDate(int year, int month, int day, PackedAttendanceRecord& out);
+
+    /** @brief Số dòng mỗi lô khi chuyển đổi các cột ngày/giờ trong parseChunk(). */
+    static constexpr std::size_t PARSE_BATCH_ROWS = 4096;
+
+    /**
+     * @brief Kiểm tra, nén và thêm một dòng chấm công vào kho (dùng chung cho các hàm tải file).
+     * Dòng có ngày không hợp lệ hoặc mã nhân viên rỗng bị bỏ qua và được ghi nhận vào _diagnostics.
+     * @param lineNumber Số thứ tự của dòng trong file (dùng trong bản tóm tắt lỗi).
+     */
+    void appendParsedLine(std::string_view employeeId, std::string_view workDate, std::string_view checkIn,
+                          std::string_view checkOut, std::string_view dayType, std::size_t lineNumber);
+
+    /// @brief Kết quả phân tích một đoạn file CSV (định nghĩa trong AttendanceManager.cpp).
+    struct ParsedChunk;
+
+    /**
+     * @brief Phân tích một đoạn nội dung CSV (gồm các dòng trọn vẹn, không có dòng tiêu đề)
+     * vào bộ đệm riêng của đoạn. Không truy cập dữ liệu của đối tượng nên chạy song song được.
+     */
+    static void parseChunk(std::string_view text, ParsedChunk& chunk);
+
+    /**
+     * @brief Gộp một đoạn đã phân tích vào kho bản ghi: ánh xạ khóa nhân viên cục bộ sang
+     * khóa chung, gộp các lỗi của đoạn vào _diagnostics và nối các bản ghi vào cuối _records.
+     * @param lineOffset Số dòng của file đứng trước đoạn này.
+     */
+    void mergeChunk(ParsedChunk& chunk, std::size_t lineOffset);
+
+    /**
+     * @brief Xóa toàn bộ dữ liệu chấm công hiện có (bản ghi, bảng mã nhân viên, chỉ mục).
+     */
+    void resetRecords();
+
+    /**
+     * @brief Phân tích các dòng dữ liệu CSV (không có dòng tiêu đề) bằng nhiều luồng và nối
+     * vào cuối _records theo thứ tự gốc. Không sắp xếp và không dựng chỉ mục.
+     * @param lineOffset Số dòng của file đứng trước `body` (để đánh số dòng trong bản tóm tắt lỗi).
+     * @return Số dòng (kể cả dòng trống) của `body`.
+     */
+    std::size_t appendRowsParallel(std::string_view body, unsigned threadCount, std::size_t lineOffset);
+
+    /**
+     * @brief Đưa các bản ghi từ vị trí `firstNew` trở đi về đúng thứ tự (nhân viên, tháng) bằng
+     * cách sắp xếp riêng phần mới rồi trộn với phần cũ (chỉ mục kỳ lương được đánh dấu cũ).
+     */
+    void mergeAppended(std::size_t firstNew);
+
+    /**
+     * @struct SourceState
+     * @brief Trạng thái của file CSV đã được tải đầy đủ vào kho (dùng cho refreshFromFile()).
+     */
+    struct SourceState {
+        std::string filename;              ///< @brief Đường dẫn file đã tải.
+        std::uint64_t size = 0;            ///< @brief Kích thước file lúc tải.
+        std::int64_t modified = 0;         ///< @brief Thời điểm sửa đổi lúc tải.
+        std::uint64_t checksum = 0;        ///< @brief Checksum toàn bộ nội dung file lúc tải.
+        std::size_t lineCount = 0;         ///< @brief Số dòng của file lúc tải (kể cả dòng tiêu đề).
+        bool endsWithNewline = false;      ///< @brief File kết thúc bằng '\n' (không có dòng dở dang).
+        bool inSync = false;               ///< @brief Kho đang trùng khớp với file (chưa bị sửa trong bộ nhớ).
+        bool cacheStale = false;           ///< @brief Đã nối thêm dòng từ file nhưng chưa ghi lại cache (xem flushCache()).
+    };
+    SourceState _source; ///< @brief File nguồn của dữ liệu hiện tại.
+
+    /**
+     * @brief Ghi nhận kích thước, thời điểm sửa đổi, số dòng và checksum toàn bộ nội dung của file vừa tải.
+     */
+    void rememberSource(const std::string& filename, std::string_view content, std::int64_t modified,
+                        std::size_t lineCount);
+
+    IngestDiagnostics _diagnostics; ///< @brief Các dòng lỗi của lần tải (hoặc lần đọc phần nối thêm) gần nhất.
+
+    DuplicatePolicy _duplicatePolicy = DuplicatePolicy::KeepFirst; ///< @brief Cách xử lý bản ghi trùng lặp/chồng giờ.
+    AttendanceConflictIndex _conflicts; ///< @brief Bảng băm các bản ghi đã nhận (phát hiện xung đột).
+    bool _conflictsValid = true;        ///< @brief _conflicts đang khớp với dữ liệu trong kho.
+
+    /**
+     * @brief Kiểm tra xung đột của một bản ghi sắp được nhận vào kho và áp dụng _duplicatePolicy.
+     * Bản ghi xung đột được ghi nhận vào _diagnostics.
+     * @param record Bản ghi (khóa nhân viên là khóa chung).
+     * @param lineNumber Số thứ tự dòng của bản ghi trong file.
+     * @return true nếu bản ghi được nhận vào kho.
+     */
+    bool admitRecord(const PackedAttendanceRecord& record, std::size_t lineNumber);
+
+    /**
+     * @brief Dựng lại _conflicts từ _records nếu cần (ví dụ sau khi đọc từ cache).
+     */
+    void ensureConflictIndex();
+
+    /**
+     * @brief Áp dụng DuplicatePolicy::Reject khi tải xong: nếu có xung đột thì in lỗi, làm rỗng kho
+     * và đánh dấu isRejected().
+     * @return true nếu dữ liệu vừa tải bị từ chối.
+     */
+    bool rejectConflicts();
+
 public:
     /**
      * @brief Constructor mặc định.
@@ -32,6 +303,7 @@ public:
 
     /**
      * @brief Chuyển đổi chuỗi thời gian "HH:MM:SS" thành tổng số giây kể từ đầu ngày.
+     * Dùng AttendanceParser::parseTime (không tạo stringstream cho mỗi lần gọi).
      * @param timeStr Chuỗi thời gian cần chuyển đổi.
      * @return Tổng số giây. Trả về 0 nếu chuỗi không hợp lệ hoặc rỗng.
      */
@@ -39,16 +311,68 @@ public:
 
     /**
      * @brief Thêm một bản ghi chấm công mới vào danh sách.
+     * Bản ghi trùng hoàn toàn với bản ghi đã có bị từ chối (trừ khi chính sách là DuplicatePolicy::Report);
+     * bản ghi chồng giờ chỉ bị từ chối khi chính sách là DuplicatePolicy::Reject.
      * @param record Tham chiếu hằng đến đối tượng AttendanceRecord cần thêm.
+     * @return true nếu thêm thành công, false nếu ngày làm việc không hợp lệ, mã nhân viên rỗng hoặc bản ghi xung đột.
+     */
+    bool addRecord(const AttendanceRecord& record);
+
+    /**
+     * @brief Xóa một bản ghi chấm công (khớp mã nhân viên, ngày, giờ vào, giờ ra và loại ngày).
+     * Số liệu tổng hợp của (nhân viên, kỳ lương) được trừ đi O(1); không dùng được ở chế độ chỉ-tổng-hợp.
+     * @param record Bản ghi cần xóa.
+     * @return true nếu tìm thấy và đã xóa một bản ghi khớp, false nếu không.
      */
-    void addRecord(const AttendanceRecord& record);
+    bool removeRecord(const AttendanceRecord& record);
 
     /**
-     * @brief Lấy danh sách tất cả các bản ghi chấm công hiện có.
+     * @brief Lấy danh sách tất cả các bản ghi chấm công hiện có ở dạng chuỗi.
+     * Danh sách được dựng lại từ kho dạng nén ở lần gọi đầu tiên sau mỗi thay đổi dữ liệu.
+     * Giờ được định dạng lại theo "H:MM:SS" (ví dụ "9:00:00"); loại ngày không nhận ra trở thành chuỗi rỗng.
      * @return Tham chiếu hằng đến vector chứa các AttendanceRecord.
      */
     const std::vector<AttendanceRecord>& getRecords() const;
 
+    /**
+     * @brief Lấy danh sách các bản ghi chấm công ở dạng nén (16 byte/bản ghi).
+     * @return Tham chiếu hằng đến vector chứa các PackedAttendanceRecord.
+     */
+    const std::vector<PackedAttendanceRecord>& getPackedRecords() const;
+
+    /**
+     * @brief Lấy bảng ánh xạ giữa mã nhân viên và khóa dùng trong PackedAttendanceRecord.
+     * @return Tham chiếu hằng đến EmployeeIdPool.
+     */
+    const EmployeeIdPool& getEmployeeIds() const;
+
+    /**
+     * @brief Sắp xếp ổn định các bản ghi theo (nhân viên, tháng) và dựng lại số liệu tổng hợp
+     * (chỉ mục kỳ lương được đánh dấu cũ, xem getRecordsFor()).
+     * Các hàm tải file tự gọi hàm này; thứ tự tương đối giữa các bản ghi của cùng một
+     * nhân viên trong cùng một tháng được giữ nguyên như trong file.
+     */
+    void buildIndex();
+
+    /**
+     * @brief Lấy các bản ghi chấm công của một nhân viên trong một kỳ lương (tháng/năm).
+     * Chi phí tra cứu O(1); dãy trả về chỉ gồm các bản ghi thuộc đúng nhân viên và kỳ đó.
+     * @param employeeId Mã nhân viên.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @return Dãy bản ghi liên tiếp (rỗng nếu không có dữ liệu). Dãy bị vô hiệu khi dữ liệu thay đổi.
+     */
+    AttendanceRange getRecordsFor(const std::string& employeeId, int month, int year) const;
+
+    /**
+     * @brief Lấy các bản ghi chấm công của một nhân viên (theo khóa số) trong một kỳ lương.
+     * @param employeeKey Khóa nhân viên trong EmployeeIdPool.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @return Dãy bản ghi liên tiếp (rỗng nếu không có dữ liệu).
+     */
+    AttendanceRange getRecordsFor(std::uint32_t employeeKey, int month, int year) const;
+
     /**
      * @brief Tải dữ liệu chấm công từ một file CSV.
      * Xóa dữ liệu cũ trước khi tải. Bỏ qua dòng tiêu đề và các dòng trống.
@@ -60,6 +384,231 @@ public:
      */
     void loadFromFile(const std::string& filename);
 
+    /**
+     * @brief Tải dữ liệu chấm công từ file CSV bằng cách ánh xạ file vào bộ nhớ (memory-map).
+     * Kết quả giống hệt loadFromFile() nhưng không dùng getline/stringstream: mỗi dòng được
+     * tách thành các trường dạng std::string_view trỏ thẳng vào vùng nhớ của file, sau đó
+     * gán trực tiếp vào bản ghi. Các trường chấm công đều ngắn (nằm trong bộ đệm SSO của
+     * std::string) nên không phát sinh cấp phát heap cho từng trường.
+     * @param filename Tên của file CSV chứa dữ liệu chấm công.
+     */
+    void loadFromFileMapped(const std::string& filename);
+
+    /**
+     * @brief Tải dữ liệu chấm công từ file CSV bằng nhiều luồng.
+     * File được ánh xạ vào bộ nhớ rồi chia thành các đoạn tại ranh giới dòng; mỗi đoạn được
+     * phân tích trên một ThreadPool vào bộ đệm riêng, sau đó các đoạn được gộp vào kho theo
+     * đúng thứ tự trong file. Kết quả (bản ghi, khóa nhân viên, cảnh báo) giống hệt loadFromFileMapped().
+     * File nhỏ (dưới PARALLEL_MIN_CHUNK_BYTES cho mỗi luồng) được phân tích trên luồng hiện tại.
+     * @param filename Tên của file CSV chứa dữ liệu chấm công.
+     * @param threadCount Số luồng phân tích. Giá trị 0 nghĩa là dùng số lõi CPU.
+     */
+    void loadFromFileParallel(const std::string& filename, unsigned threadCount = 0);
+
+    /**
+     * @brief Tải dữ liệu chấm công, dùng cache nhị phân dạng cột nằm cạnh file CSV nếu có thể.
+     * Nếu file cache (xem AttendanceCache) khớp với kích thước, thời điểm sửa đổi và checksum
+     * của file CSV thì dữ liệu được đọc từ cache (ánh xạ vào bộ nhớ) thay vì phân tích lại.
+     * Nếu cache không có, đã cũ hoặc bị hỏng thì file CSV được phân tích như loadFromFileParallel()
+     * và cache được ghi lại. Kết quả luôn giống hệt khi phân tích file CSV.
+     * @param filename Tên của file CSV chứa dữ liệu chấm công.
+     * @param threadCount Số luồng phân tích khi phải đọc file CSV (0 = theo số lõi CPU).
+     * @note Các dòng lỗi chỉ được ghi nhận (và in tóm tắt) ở lần phân tích file CSV; khi đọc từ cache,
+     * getLoadDiagnostics() không có lỗi nào.
+     */
+    void loadFromFileCached(const std::string& filename, unsigned threadCount = 0);
+
+    /**
+     * @brief Cập nhật dữ liệu chấm công theo file CSV, chỉ đọc lại khi file thay đổi.
+     * - File không đổi (cùng kích thước và thời điểm sửa đổi với lần tải trước): không làm gì.
+     * - File chỉ được nối thêm dòng (dài hơn, checksum của toàn bộ phần đã đọc không đổi): chỉ phân tích
+     *   phần nối thêm rồi trộn vào kho đã sắp xếp. Cache nhị phân không được ghi lại ngay mà chờ flushCache().
+     * - Các trường hợp khác (lần đầu, file khác, file bị sửa ở bất kỳ đâu/cắt ngắn, kho đã bị addRecord()):
+     *   tải lại toàn bộ bằng loadFromFileCached(). Trước khi chuyển sang file khác, cache của file cũ được ghi lại.
+     * Kết quả luôn giống hệt khi tải lại toàn bộ file.
+     * @param filename Tên của file CSV chứa dữ liệu chấm công.
+     * @param threadCount Số luồng phân tích (0 = theo số lõi CPU).
+     */
+    void refreshFromFile(const std::string& filename, unsigned threadCount = 0);
+
+    /**
+     * @brief Ghi lại cache nhị phân của file nguồn nếu refreshFromFile() đã nối thêm dòng mà chưa ghi cache.
+     * Không làm gì nếu cache đang khớp, kho đã bị sửa trong bộ nhớ hoặc file nguồn đã thay đổi từ lần đọc cuối
+     * (lần tải sau sẽ thấy cache cũ và phân tích lại file CSV).
+     * @return true nếu cache đã được ghi.
+     */
+    bool flushCache();
+
+    /**
+     * @brief Cập nhật dữ liệu chấm công của một kỳ lương từ thư mục phân vùng theo tháng.
+     * Chỉ đọc file `<directory>/YYYY-MM.csv` của kỳ được yêu cầu (xem AttendancePartitions),
+     * với cùng cơ chế phát hiện thay đổi như refreshFromFile(). Nếu tháng đó không có file
+     * thì kho được làm rỗng (kỳ lương không có dữ liệu chấm công).
+     * @param directory Thư mục chứa các file theo tháng.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @param threadCount Số luồng phân tích (0 = theo số lõi CPU).
+     */
+    void refreshPartition(const std::string& directory, int month, int year, unsigned threadCount = 0);
+
+    /**
+     * @brief Tải dữ liệu chấm công của cả năm từ thư mục phân vùng theo tháng: các file
+     * `<directory>/YYYY-01.csv` ... `YYYY-12.csv` có mặt được đọc nối tiếp vào kho (mỗi file một lần)
+     * rồi sắp xếp và dựng số liệu tổng hợp một lần. Tháng không có file được bỏ qua.
+     * Lần refreshPartition() sau sẽ tải lại file của tháng được yêu cầu.
+     * @param directory Thư mục chứa các file theo tháng.
+     * @param year Năm.
+     * @param threadCount Số luồng phân tích (0 = theo số lõi CPU).
+     */
+    void loadPartitionYear(const std::string& directory, int year, unsigned threadCount = 0);
+
+    /**
+     * @brief Tải dữ liệu chấm công ở chế độ chỉ-tổng-hợp (dành cho file lớn hơn bộ nhớ).
+     * File được đọc tuần tự theo từng khối STREAM_BLOCK_BYTES byte; mỗi dòng được cộng dồn ngay
+     * vào số liệu tổng hợp của (nhân viên, kỳ lương) rồi bỏ đi, nên bộ nhớ chỉ phụ thuộc vào
+     * số nhân viên x số tháng chứ không phụ thuộc vào số dòng.
+     * Sau khi tải, summarize() (và do đó calculatePay(), BonusWelfare) cho kết quả giống hệt
+     * khi tải đầy đủ; các hàm trả về bản ghi gốc (getRecords(), getRecordsFor(), ...) trả về rỗng.
+     * @note Bản ghi trùng lặp/chồng giờ chỉ được phát hiện trong một cửa sổ STREAM_CONFLICT_WINDOW_ROWS
+     * dòng hợp lệ gần nhất: bảng AttendanceConflictIndex được làm rỗng mỗi khi đầy cửa sổ, nên bộ nhớ của
+     * nó cố định. Một dòng trùng với dòng đứng trước nó quá xa trong file sẽ không bị phát hiện.
+     * @param filename Tên của file CSV chứa dữ liệu chấm công.
+     */
+    void loadAggregatesFromFile(const std::string& filename);
+
+    /**
+     * @brief Lấy số byte bộ nhớ mà dữ liệu chấm công đang giữ, theo từng thành phần.
+     * So sánh báo cáo trước và sau khi tải lại để thấy bộ nhớ được dùng lại thay vì tăng dần.
+     */
+    AttendanceMemoryReport memoryReport() const;
+
+    /**
+     * @brief Đặt cách xử lý bản ghi trùng lặp hoặc chồng giờ; có hiệu lực từ lần tải tiếp theo
+     * (lần refreshFromFile() tiếp theo sẽ tải lại toàn bộ file).
+     * @param policy Chính sách mới.
+     */
+    void setDuplicatePolicy(DuplicatePolicy policy);
+
+    /**
+     * @brief Lấy cách xử lý bản ghi trùng lặp hoặc chồng giờ hiện tại.
+     */
+    DuplicatePolicy getDuplicatePolicy() const { return _duplicatePolicy; }
+
+    /**
+     * @brief Lấy các lỗi dữ liệu của lần tải gần nhất.
+     * Mọi hàm tải file ghi nhận các dòng bị bỏ qua (ngày không hợp lệ, thiếu mã nhân viên) và
+     * các bản ghi trùng lặp/chồng giờ theo
+     * từng loại kèm số dòng, rồi in một bản tóm tắt duy nhất ra std::cerr khi tải xong.
+     * refreshFromFile() chỉ ghi nhận lỗi của phần được đọc lại (không đổi gì nếu file không đổi).
+     * @return Tham chiếu hằng đến bộ thu thập lỗi (có thể dùng totalCount() để dừng sớm).
+     */
+    const IngestDiagnostics& getLoadDiagnostics() const { return _diagnostics; }
+
+    /**
+     * @brief Kiểm tra lần tải gần nhất có bị từ chối theo DuplicatePolicy::Reject hay không.
+     * Khi đó kho rỗng nhưng không có nghĩa là không ai đi làm: nơi gọi phải dừng tính lương thay vì
+     * tính lương bằng 0. Cờ được xóa ở lần tải tiếp theo.
+     */
+    bool isRejected() const { return _rejected; }
+
+    /**
+     * @brief Kiểm tra dữ liệu hiện tại có được tải ở chế độ chỉ-tổng-hợp hay không.
+     */
+    bool isAggregateOnly() const { return _aggregateOnly; }
+
+    /**
+     * @brief Số bản ghi đã được cộng dồn ở chế độ chỉ-tổng-hợp.
+     */
+    std::size_t getAggregatedRecordCount() const { return _aggregatedRecordCount; }
+
+    /**
+     * @brief Phiên bản dữ liệu chấm công: tăng (không bao giờ giảm) mỗi khi kho thay đổi
+     * (tải lại, nối thêm bản ghi từ file, addRecord()). Giữ nguyên nếu refreshFromFile() thấy file không đổi.
+     * Dùng để biết các kết quả tính từ dữ liệu cũ (ví dụ PayrollCache) còn dùng được hay không.
+     */
+    std::uint64_t getDataVersion() const { return _dataVersion; }
+
+    /**
+     * @brief Lấy các (nhân viên, kỳ lương) có số liệu thay đổi sau một phiên bản dữ liệu.
+     * Chỉ có khi dữ liệu từ phiên bản đó tới nay chỉ thay đổi gia tăng (addRecord(), removeRecord(),
+     * refreshFromFile() nối thêm dòng); sau một lần tải lại toàn bộ thì không có.
+     * @param version Phiên bản dữ liệu cũ (getDataVersion() lúc trước).
+     * @param changes Danh sách thay đổi (được xóa trước khi ghi; có thể lặp lại một cặp).
+     * @return true nếu danh sách là đầy đủ, false nếu phải coi như mọi số liệu đã thay đổi.
+     */
+    bool getChangesSince(std::uint64_t version, std::vector<AttendanceChange>& changes) const;
+
+    /**
+     * @brief Cộng dồn một bản ghi vào số liệu tổng hợp của kỳ lương.
+     * Giờ làm âm (giờ ra < giờ vào) tính là 0; ngày trùng ngày lễ cố định hoặc loại "holiday"
+     * được tính vào giờ ngày lễ, còn lại "normal" vào giờ thường và "overtime" vào giờ tăng ca.
+     * @param summary Số liệu tổng hợp cần cộng dồn.
+     * @param record Bản ghi chấm công.
+     */
+    static void accumulate(AttendanceSummary& summary, const PackedAttendanceRecord& record);
+
+    /**
+     * @brief Trừ một bản ghi khỏi số liệu tổng hợp (phép ngược của accumulate()).
+     * @param summary Số liệu tổng hợp đã được cộng dồn bản ghi này.
+     * @param record Bản ghi chấm công.
+     */
+    static void subtract(AttendanceSummary& summary, const PackedAttendanceRecord& record);
+
+    /**
+     * @brief Lấy số liệu chấm công tổng hợp của một nhân viên trong một kỳ lương.
+     * Tra cứu O(1) số liệu tổng hợp được cập nhật dần (cả chế độ đầy đủ và chế độ chỉ-tổng-hợp).
+     * @param employeeId Mã nhân viên.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @return Số liệu tổng hợp (toàn 0 nếu không có dữ liệu).
+     */
+    AttendanceSummary summarize(const std::string& employeeId, int month, int year) const;
+
+    /**
+     * @brief Lấy số liệu chấm công tổng hợp của một nhân viên (theo khóa số) trong một kỳ lương.
+     */
+    AttendanceSummary summarize(std::uint32_t employeeKey, int month, int year) const;
+
+    /**
+     * @brief Tổng hợp số liệu chấm công của mọi nhân viên trong một kỳ lương bằng một lần quét.
+     * Mỗi khóa nhân viên chỉ tra số liệu tổng hợp một lần, nên chi phí là O(số nhân viên),
+     * không tra cứu theo chuỗi mã nhân viên.
+     * summaries[k] giống hệt summarize(k, month, year).
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @param summaries Vector kết quả, được gán lại với getEmployeeIds().size() phần tử (dùng lại dung lượng cũ);
+     * phần tử thứ k ứng với khóa nhân viên k (toàn 0 nếu không có dữ liệu).
+     */
+    void summarizePeriod(int month, int year, std::vector<AttendanceSummary>& summaries) const;
+
+    /**
+     * @brief Tổng hợp số liệu chấm công của mọi nhân viên trong cả 12 tháng của một năm bằng một lần
+     * duyệt số liệu tổng hợp (không tra cứu riêng từng tháng).
+     * summaries[(month - 1) * getEmployeeIds().size() + k] giống hệt summarize(k, month, year).
+     * @param year Năm.
+     * @param summaries Vector kết quả, được gán lại với 12 x getEmployeeIds().size() phần tử (theo tháng rồi theo khóa).
+     */
+    void summarizeYear(int year, std::vector<AttendanceSummary>& summaries) const;
+
+    /**
+     * @brief Lấy bitmask loại ngày (AttendanceSummary::dayTypeMask) của mọi nhân viên trong một kỳ lương.
+     * Giống summarizePeriod() nhưng chỉ chép 1 byte cho mỗi nhân viên, dùng cho các điều kiện chỉ cần biết
+     * kỳ lương có loại ngày nào (ví dụ BonusWelfare::evaluateEligibility()).
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @param masks Vector kết quả, được gán lại với getEmployeeIds().size() phần tử; phần tử thứ k ứng với khóa nhân viên k.
+     */
+    void dayTypeMasksForPeriod(int month, int year, std::vector<std::uint8_t>& masks) const;
+
+    /** @brief Kích thước khối đọc (byte) của loadAggregatesFromFile(). */
+    static constexpr std::size_t STREAM_BLOCK_BYTES = 1 << 20;
+
+    /** @brief Số dòng hợp lệ gần nhất được kiểm tra trùng lặp/chồng giờ trong loadAggregatesFromFile(). */
+    static constexpr std::size_t STREAM_CONFLICT_WINDOW_ROWS = 1 << 16;
+
+    /** @brief Kích thước tối thiểu (byte) của mỗi đoạn khi tải song song. */
+    static constexpr std::size_t PARALLEL_MIN_CHUNK_BYTES = 1 << 20;
+
     /**
      * @brief Kiểm tra xem một ngày (đã cho dưới dạng chuỗi "YYYY-MM-DD") có phải là ngày lễ cố định không.
      * So sánh phần "MM-DD" của ngày với danh sách các ngày lễ đã được định nghĩa.
@@ -68,9 +617,47 @@ public:
      */
     bool isHoliday(const std::string& date) const;
 
+    /**
+     * @brief Kiểm tra xem một ngày (cho dưới dạng tháng/ngày) có phải là ngày lễ cố định không.
+     * @param month Tháng (1-12).
+     * @param day Ngày trong tháng (1-31).
+     * @return true nếu là ngày lễ, false nếu không phải.
+     */
+    static bool isHoliday(int month, int day);
+
     // --- CÁC HÀM LẤY DỮ LIỆU CHẤM CÔNG TỔNG HỢP ---
-    // Các hàm này tính toán dựa trên toàn bộ dữ liệu chấm công đã tải.
-    // Nếu cần tính theo kỳ lương cụ thể, cần truyền thêm month/year và lọc bên trong.
+    // Các phiên bản có month/year tra O(1) số liệu tổng hợp của kỳ lương (xem summarize()), dùng được
+    // cả ở chế độ chỉ-tổng-hợp; giờ được tính theo cùng quy tắc với lương (giờ ra < giờ vào tính là 0).
+    // Các phiên bản chỉ có mã nhân viên quét toàn bộ bản ghi gốc, không phân biệt kỳ lương.
+
+    /**
+     * @brief Lấy số giờ/số ngày chấm công của một nhân viên trong một kỳ lương bằng một lần tra cứu.
+     * @param employeeId Mã nhân viên cần truy vấn.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @return Số liệu của kỳ (toàn 0 nếu không có dữ liệu).
+     */
+    AttendanceTotals getAttendanceTotals(const std::string& employeeId, int month, int year) const;
+
+    /**
+     * @brief Quy đổi số liệu tổng hợp của một kỳ sang số giờ/số ngày hiển thị.
+     */
+    static AttendanceTotals totalsOf(const AttendanceSummary& summary);
+
+    /** @brief Tổng số giờ làm việc bình thường của một nhân viên trong kỳ lương (làm tròn xuống). */
+    int getTotalWorkHours(const std::string& employeeId, int month, int year) const;
+
+    /** @brief Tổng số giờ tăng ca của một nhân viên trong kỳ lương (làm tròn xuống). */
+    int getOvertimeHours(const std::string& employeeId, int month, int year) const;
+
+    /** @brief Số ngày làm việc trong ngày lễ của một nhân viên trong kỳ lương. */
+    int getHolidayWorkDays(const std::string& employeeId, int month, int year) const;
+
+    /** @brief Số ngày nghỉ không lương của một nhân viên trong kỳ lương. */
+    int getLeaveUnpaidDays(const std::string& employeeId, int month, int year) const;
+
+    /** @brief Số ngày nghỉ phép có lương của một nhân viên trong kỳ lương. */
+    int getLeavePaidDays(const std::string& employeeId, int month, int year) const;
 
     /**
      * @brief Lấy tổng số giờ làm việc bình thường của một nhân viên.
@@ -0,0 +1,359 @@
+﻿#include "AttendanceParser.h"
+#include <cstdio>
+
+namespace {
+
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    /**
+     * @brief Đọc một số nguyên như `stream >> int`: bỏ khoảng trắng đầu, cho phép dấu +/-.
+     * @return true nếu đọc được ít nhất một chữ số.
+     */
+    bool readInt(std::string_view text, std::size_t& pos, int& value) {
+        while (pos < text.size() && isSpace(text[pos])) ++pos;
+        bool negative = false;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+            negative = (text[pos] == '-');
+            ++pos;
+        }
+        if (pos >= text.size() || !isDigit(text[pos])) {
+            value = 0;
+            return false;
+        }
+        int result = 0;
+        while (pos < text.size() && isDigit(text[pos])) {
+            result = result * 10 + (text[pos] - '0');
+            ++pos;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    /**
+     * @brief Đọc một ký tự không phải khoảng trắng như `stream >> char`.
+     */
+    bool readChar(std::string_view text, std::size_t& pos) {
+        while (pos < text.size() && isSpace(text[pos])) ++pos;
+        if (pos >= text.size()) return false;
+        ++pos;
+        return true;
+    }
+
+    int twoDigits(std::string_view text, std::size_t pos) {
+        return (text[pos] - '0') * 10 + (text[pos + 1] - '0');
+    }
+
+    // Hằng số SWAR: mỗi byte của từ 64-bit là một ký tự
+    constexpr std::uint64_t ONES = 0x0101010101010101ULL;
+    constexpr std::uint64_t HIGH_BITS = ONES * 0x80;
+
+    /**
+     * @brief Nạp `n` byte (n <= 8) thành từ 64-bit little-endian: ký tự đầu ở byte thấp nhất.
+     */
+    std::uint64_t loadWord(const char* data, std::size_t n) {
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        }
+        return word;
+    }
+
+    /**
+     * @brief Kiểm tra mọi byte của từ đều là chữ số '0'-'9'.
+     * Byte < '0' làm phép trừ mượn (bật bit cao), byte > '9' làm phép cộng 0x46 bật bit cao.
+     */
+    bool allDigits(std::uint64_t word) {
+        return ((word | (word - ONES * '0') | (word + ONES * 0x46)) & HIGH_BITS) == 0;
+    }
+
+    /**
+     * @brief Gộp từng cặp chữ số liền nhau: byte k của kết quả = 10 * byte k + byte k+1.
+     * Các byte đầu vào đều <= 10 nên không có nhớ sang byte bên cạnh.
+     */
+    std::uint64_t combinePairs(std::uint64_t values) {
+        return values * 10 + (values >> 8);
+    }
+
+    /**
+     * @brief Phân tích "HH:MM:SS" (hoặc "H:MM:SS", coi như có '0' ở đầu) bằng SWAR.
+     */
+    bool swarClockTime(std::string_view text, std::int32_t& seconds) {
+        std::uint64_t word;
+        if (text.size() == 8) {
+            word = loadWord(text.data(), 8);
+        } else if (text.size() == 7) {
+            word = (loadWord(text.data(), 7) << 8) | '0';
+        } else {
+            return false;
+        }
+        // Vị trí 2 và 5 phải là ':'; thay bằng '0' để kiểm tra chữ số cho cả từ một lần
+        constexpr std::uint64_t SEPARATORS = (0xFFULL << 16) | (0xFFULL << 40);
+        constexpr std::uint64_t COLONS = (std::uint64_t(':') << 16) | (std::uint64_t(':') << 40);
+        constexpr std::uint64_t ZEROS = (std::uint64_t('0') << 16) | (std::uint64_t('0') << 40);
+        if ((word & SEPARATORS) != COLONS) return false;
+        word = (word & ~SEPARATORS) | ZEROS;
+        if (!allDigits(word)) return false;
+
+        std::uint64_t pairs = combinePairs(word - ONES * '0');
+        int hours = static_cast<int>(pairs & 0xFF);
+        int minutes = static_cast<int>((pairs >> 24) & 0xFF);
+        int secs = static_cast<int>((pairs >> 48) & 0xFF);
+        if (hours > 23 || minutes > 59 || secs > 59) return false;
+        seconds = hours * 3600 + minutes * 60 + secs;
+        return true;
+    }
+
+    /**
+     * @brief Phân tích "YYYY-MM-DD" bằng SWAR: 8 byte đầu "YYYY-MM-" trong một từ, 2 byte ngày riêng.
+     */
+    bool swarDate(std::string_view text, AttendanceParser::CivilDate& date) {
+        if (text.size() != 10) return false;
+        std::uint64_t word = loadWord(text.data(), 8);
+        constexpr std::uint64_t SEPARATORS = (0xFFULL << 32) | (0xFFULL << 56);
+        constexpr std::uint64_t DASHES = (std::uint64_t('-') << 32) | (std::uint64_t('-') << 56);
+        constexpr std::uint64_t ZEROS = (std::uint64_t('0') << 32) | (std::uint64_t('0') << 56);
+        if ((word & SEPARATORS) != DASHES) return false;
+        word = (word & ~SEPARATORS) | ZEROS;
+        // Hai chữ số ngày được đặt vào một từ đệm '0' để dùng chung phép kiểm tra
+        std::uint64_t dayWord = loadWord(text.data() + 8, 2) | (ONES * '0' & ~0xFFFFULL);
+        if (!allDigits(word) || !allDigits(dayWord)) return false;
+
+        std::uint64_t pairs = combinePairs(word - ONES * '0');
+        int year = static_cast<int>(pairs & 0xFF) * 100 + static_cast<int>((pairs >> 16) & 0xFF);
+        int month = static_cast<int>((pairs >> 40) & 0xFF);
+        int day = static_cast<int>(combinePairs(dayWord - ONES * '0') & 0xFF);
+        if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+        date.year = static_cast<std::uint16_t>(year);
+        date.month = static_cast<std::uint8_t>(month);
+        date.day = static_cast<std::uint8_t>(day);
+        return true;
+    }
+
+    /**
+     * @brief Xóa mặt nạ bit của `count` phần tử.
+     */
+    void clearMask(std::uint64_t* mask, std::size_t count) {
+        for (std::size_t i = 0; i < AttendanceParser::maskWords(count); ++i) mask[i] = 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Phân tích chuỗi ngày "YYYY-MM-DD".
+ */
+bool AttendanceParser::parseDate(std::string_view text, int& year, int& month, int& day) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    for (std::size_t i : { 0, 1, 2, 3, 5, 6, 8, 9 }) {
+        if (!isDigit(text[i])) return false;
+    }
+    year = twoDigits(text, 0) * 100 + twoDigits(text, 2);
+    month = twoDigits(text, 5);
+    day = twoDigits(text, 8);
+    return month >= 1 && month <= 12 && day >= 1 && day <= 31;
+}
+
+/**
+ * @brief Chuyển chuỗi giờ thành số giây, cùng cách xử lý với timeToSeconds.
+ */
+std::int32_t AttendanceParser::parseTime(std::string_view text) {
+    std::int32_t seconds = 0;
+    if (swarClockTime(text, seconds)) {
+        return seconds; // Định dạng chuẩn: cho cùng kết quả với cách đọc tổng quát bên dưới
+    }
+    if (text.empty() || text.find(':') == std::string_view::npos) {
+        return 0;
+    }
+    int hours = 0, minutes = 0, secs = 0;
+    std::size_t pos = 0;
+    if (readInt(text, pos, hours) && readChar(text, pos)
+        && readInt(text, pos, minutes) && readChar(text, pos)) {
+        readInt(text, pos, secs);
+    }
+    return hours * 3600 + minutes * 60 + secs;
+}
+
+/**
+ * @brief Phân tích chặt một giờ "HH:MM:SS" hoặc "H:MM:SS".
+ */
+bool AttendanceParser::parseClockTime(std::string_view text, std::int32_t& seconds) {
+    return swarClockTime(text, seconds);
+}
+
+/**
+ * @brief Phân tích một cột giờ bằng SWAR.
+ */
+std::size_t AttendanceParser::parseTimes(const std::string_view* texts, std::size_t count,
+                                         std::int32_t* seconds, std::uint64_t* invalidMask) {
+    clearMask(invalidMask, count);
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!swarClockTime(texts[i], seconds[i])) {
+            seconds[i] = 0;
+            invalidMask[i / 64] |= std::uint64_t(1) << (i % 64);
+            ++invalid;
+        }
+    }
+    return invalid;
+}
+
+/**
+ * @brief Phân tích một cột giờ theo từng ký tự.
+ */
+std::size_t AttendanceParser::parseTimesScalar(const std::string_view* texts, std::size_t count,
+                                               std::int32_t* seconds, std::uint64_t* invalidMask) {
+    clearMask(invalidMask, count);
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string_view text = texts[i];
+        // "H:MM:SS" được xử lý như "0H:MM:SS"
+        std::size_t shift = (text.size() == 7) ? 1 : 0;
+        bool valid = (text.size() == 7 || text.size() == 8)
+            && text[2 - shift] == ':' && text[5 - shift] == ':';
+        for (std::size_t k = 0; valid && k < text.size(); ++k) {
+            if (k != 2 - shift && k != 5 - shift && !isDigit(text[k])) valid = false;
+        }
+        int hours = 0, minutes = 0, secs = 0;
+        if (valid) {
+            hours = shift ? (text[0] - '0') : twoDigits(text, 0);
+            minutes = twoDigits(text, 3 - shift);
+            secs = twoDigits(text, 6 - shift);
+            valid = hours <= 23 && minutes <= 59 && secs <= 59;
+        }
+        if (valid) {
+            seconds[i] = hours * 3600 + minutes * 60 + secs;
+        } else {
+            seconds[i] = 0;
+            invalidMask[i / 64] |= std::uint64_t(1) << (i % 64);
+            ++invalid;
+        }
+    }
+    return invalid;
+}
+
+/**
+ * @brief Phân tích một cột ngày bằng SWAR.
+ */
+std::size_t AttendanceParser::parseDates(const std::string_view* texts, std::size_t count,
+                                         CivilDate* dates, std::uint64_t* invalidMask) {
+    clearMask(invalidMask, count);
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!swarDate(texts[i], dates[i])) {
+            dates[i] = CivilDate{ 0, 0, 0 };
+            invalidMask[i / 64] |= std::uint64_t(1) << (i % 64);
+            ++invalid;
+        }
+    }
+    return invalid;
+}
+
+/**
+ * @brief Phân tích một cột ngày theo từng ký tự.
+ */
+std::size_t AttendanceParser::parseDatesScalar(const std::string_view* texts, std::size_t count,
+                                               CivilDate* dates, std::uint64_t* invalidMask) {
+    clearMask(invalidMask, count);
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        int year = 0, month = 0, day = 0;
+        if (parseDate(texts[i], year, month, day)) {
+            dates[i] = CivilDate{ static_cast<std::uint16_t>(year), static_cast<std::uint8_t>(month),
+                                  static_cast<std::uint8_t>(day) };
+        } else {
+            dates[i] = CivilDate{ 0, 0, 0 };
+            invalidMask[i / 64] |= std::uint64_t(1) << (i % 64);
+            ++invalid;
+        }
+    }
+    return invalid;
+}
+
+/**
+ * @brief Chuyển chuỗi loại ngày thành enum.
+ */
+AttendanceDayType AttendanceParser::parseDayType(std::string_view text) {
+    if (text == "normal") return AttendanceDayType::Normal;
+    if (text == "overtime") return AttendanceDayType::Overtime;
+    if (text == "holiday") return AttendanceDayType::Holiday;
+    if (text == "leave") return AttendanceDayType::Leave;
+    if (text == "leave_unpaid") return AttendanceDayType::LeaveUnpaid;
+    return AttendanceDayType::Unknown;
+}
+
+/**
+ * @brief Lấy tên chuỗi của loại ngày.
+ */
+const char* AttendanceParser::dayTypeName(AttendanceDayType type) {
+    switch (type) {
+        case AttendanceDayType::Normal: return "normal";
+        case AttendanceDayType::Overtime: return "overtime";
+        case AttendanceDayType::Holiday: return "holiday";
+        case AttendanceDayType::Leave: return "leave";
+        case AttendanceDayType::LeaveUnpaid: return "leave_unpaid";
+        default: return "";
+    }
+}
+
+/**
+ * @brief Số ngày kể từ 1970-01-01 (thuật toán days_from_civil của H. Hinnant).
+ */
+std::int32_t AttendanceParser::daysFromCivil(int year, int month, int day) {
+    year -= (month <= 2) ? 1 : 0;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int>(doe) - 719468;
+}
+
+/**
+ * @brief Ngày dương lịch từ số ngày kể từ 1970-01-01 (thuật toán civil_from_days).
+ */
+void AttendanceParser::civilFromDays(std::int32_t days, int& year, int& month, int& day) {
+    days += 719468;
+    const int era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+/**
+ * @brief Mã kỳ lương (year * 12 + month - 1) của một ngày.
+ */
+std::int32_t AttendanceParser::periodOfDay(std::int32_t days) {
+    int year = 0, month = 0, day = 0;
+    civilFromDays(days, year, month, day);
+    return periodOf(year, month);
+}
+
+/**
+ * @brief Định dạng ngày thành "YYYY-MM-DD".
+ */
+std::string AttendanceParser::formatDate(std::int32_t days) {
+    int year = 0, month = 0, day = 0;
+    civilFromDays(days, year, month, day);
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+/**
+ * @brief Định dạng số giây thành "H:MM:SS".
+ */
+std::string AttendanceParser::formatTime(std::int32_t seconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%d:%02d:%02d", seconds / 3600, (seconds / 60) % 60, seconds % 60);
+    return buffer;
+}
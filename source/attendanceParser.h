@@ -0,0 +1,159 @@
+﻿#ifndef ATTENDANCE_PARSER_H
+#define ATTENDANCE_PARSER_H
+
+#include "globalDefinitions.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @file AttendanceParser.h
+ * @brief Định nghĩa lớp AttendanceParser gồm các hàm chuyển đổi giữa dạng chuỗi và dạng nén
+ * của dữ liệu chấm công (ngày, giờ, loại ngày).
+ */
+
+/**
+ * @class AttendanceParser
+ * @brief Tập hợp các hàm tĩnh phân tích/định dạng các trường của một bản ghi chấm công.
+ *
+ * Ngày được biểu diễn bằng số ngày kể từ 1970-01-01, giờ bằng số giây kể từ đầu ngày,
+ * loại ngày bằng enum AttendanceDayType. Các hàm không cấp phát bộ nhớ (trừ các hàm format).
+ *
+ * Các hàm parseTimes()/parseDates() xử lý cả một cột giá trị: mỗi chuỗi đúng định dạng cố định
+ * được nạp vào một thanh ghi 64-bit và kiểm tra/chuyển đổi tất cả chữ số cùng lúc (SWAR);
+ * phần tử sai định dạng được đánh dấu trong mặt nạ bit đi kèm. Các hàm *Scalar cho kết quả
+ * và mặt nạ giống hệt, dùng để đối chiếu hoặc trên nền tảng không dùng được nhánh SWAR.
+ */
+class AttendanceParser {
+public:
+    /**
+     * @struct CivilDate
+     * @brief Ngày dương lịch đã tách thành năm/tháng/ngày (kết quả của parseDates()).
+     */
+    struct CivilDate {
+        std::uint16_t year;
+        std::uint8_t month;
+        std::uint8_t day;
+    };
+
+    /**
+     * @brief Số từ 64-bit cần cho mặt nạ bit của `count` phần tử.
+     */
+    static std::size_t maskWords(std::size_t count) { return (count + 63) / 64; }
+
+    /**
+     * @brief Kiểm tra phần tử thứ `index` có bị đánh dấu trong mặt nạ bit hay không.
+     */
+    static bool isMarked(const std::uint64_t* mask, std::size_t index) {
+        return (mask[index / 64] >> (index % 64)) & 1u;
+    }
+
+    /**
+     * @brief Phân tích chuỗi ngày "YYYY-MM-DD" (đúng 10 ký tự, các vị trí số phải là chữ số).
+     * @param text Chuỗi ngày.
+     * @param year Biến nhận năm.
+     * @param month Biến nhận tháng (1-12).
+     * @param day Biến nhận ngày (1-31).
+     * @return true nếu chuỗi hợp lệ, false nếu ngược lại.
+     */
+    static bool parseDate(std::string_view text, int& year, int& month, int& day);
+
+    /**
+     * @brief Chuyển chuỗi giờ "H:MM:SS" hoặc "HH:MM:SS" thành số giây kể từ đầu ngày.
+     * Giữ nguyên cách xử lý của AttendanceManager::timeToSeconds: chuỗi rỗng hoặc không có
+     * dấu ':' cho kết quả 0; phần không đọc được sẽ được tính là 0.
+     * @param text Chuỗi giờ.
+     * @return Số giây kể từ đầu ngày.
+     */
+    static std::int32_t parseTime(std::string_view text);
+
+    /**
+     * @brief Phân tích chặt một giờ "HH:MM:SS" hoặc "H:MM:SS" (giờ 0-23, phút và giây 0-59).
+     * @param text Chuỗi giờ.
+     * @param seconds Biến nhận số giây kể từ đầu ngày.
+     * @return true nếu chuỗi đúng định dạng, false nếu ngược lại (seconds không đổi).
+     */
+    static bool parseClockTime(std::string_view text, std::int32_t& seconds);
+
+    /**
+     * @brief Phân tích một cột giờ "HH:MM:SS"/"H:MM:SS" bằng SWAR.
+     * @param texts Mảng `count` chuỗi giờ.
+     * @param count Số phần tử.
+     * @param seconds Mảng `count` phần tử nhận số giây (0 với phần tử không hợp lệ).
+     * @param invalidMask Mặt nạ maskWords(count) từ; bit i được bật nếu texts[i] không đúng định dạng.
+     * @return Số phần tử không hợp lệ.
+     */
+    static std::size_t parseTimes(const std::string_view* texts, std::size_t count,
+                                  std::int32_t* seconds, std::uint64_t* invalidMask);
+
+    /**
+     * @brief Phiên bản vô hướng (từng ký tự) của parseTimes(), cho kết quả giống hệt.
+     */
+    static std::size_t parseTimesScalar(const std::string_view* texts, std::size_t count,
+                                        std::int32_t* seconds, std::uint64_t* invalidMask);
+
+    /**
+     * @brief Phân tích một cột ngày "YYYY-MM-DD" bằng SWAR (cùng điều kiện hợp lệ với parseDate()).
+     * @param texts Mảng `count` chuỗi ngày.
+     * @param count Số phần tử.
+     * @param dates Mảng `count` phần tử nhận ngày ({0, 0, 0} với phần tử không hợp lệ).
+     * @param invalidMask Mặt nạ maskWords(count) từ; bit i được bật nếu texts[i] không hợp lệ.
+     * @return Số phần tử không hợp lệ.
+     */
+    static std::size_t parseDates(const std::string_view* texts, std::size_t count,
+                                  CivilDate* dates, std::uint64_t* invalidMask);
+
+    /**
+     * @brief Phiên bản vô hướng của parseDates() (dùng parseDate()), cho kết quả giống hệt.
+     */
+    static std::size_t parseDatesScalar(const std::string_view* texts, std::size_t count,
+                                        CivilDate* dates, std::uint64_t* invalidMask);
+
+    /**
+     * @brief Chuyển chuỗi loại ngày ("normal", "overtime", ...) thành AttendanceDayType.
+     * @param text Chuỗi loại ngày.
+     * @return Giá trị enum tương ứng, hoặc AttendanceDayType::Unknown nếu không nhận ra.
+     */
+    static AttendanceDayType parseDayType(std::string_view text);
+
+    /**
+     * @brief Lấy chuỗi tên của một loại ngày (ngược lại với parseDayType).
+     * @param type Loại ngày.
+     * @return Tên loại ngày; chuỗi rỗng với AttendanceDayType::Unknown.
+     */
+    static const char* dayTypeName(AttendanceDayType type);
+
+    /**
+     * @brief Tính số ngày kể từ 1970-01-01 của một ngày dương lịch.
+     */
+    static std::int32_t daysFromCivil(int year, int month, int day);
+
+    /**
+     * @brief Tính ngày dương lịch từ số ngày kể từ 1970-01-01.
+     */
+    static void civilFromDays(std::int32_t days, int& year, int& month, int& day);
+
+    /**
+     * @brief Mã kỳ lương (tháng) của một cặp tháng/năm: year * 12 + (month - 1).
+     */
+    static std::int32_t periodOf(int year, int month) { return year * 12 + (month - 1); }
+
+    /**
+     * @brief Mã kỳ lương (tháng) chứa một ngày cho dưới dạng số ngày kể từ 1970-01-01.
+     */
+    static std::int32_t periodOfDay(std::int32_t days);
+
+    /**
+     * @brief Định dạng số ngày kể từ 1970-01-01 thành chuỗi "YYYY-MM-DD".
+     */
+    static std::string formatDate(std::int32_t days);
+
+    /**
+     * @brief Định dạng số giây kể từ đầu ngày thành chuỗi "H:MM:SS" (giờ không có số 0 ở đầu,
+     * giống định dạng trong attendance.csv, ví dụ "9:00:00").
+     */
+    static std::string formatTime(std::int32_t seconds);
+};
+
+#endif // ATTENDANCE_PARSER_H
@@ -0,0 +1,164 @@
+﻿#include "AttendancePartitions.h"
+#include "AttendanceParser.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+    /**
+     * @brief Lấy trường ngày làm việc (trường thứ hai) của một dòng CSV, bỏ khoảng trắng cuối
+     * (cùng cách tách trường với các hàm tải của AttendanceManager).
+     */
+    std::string_view workDateField(std::string_view line) {
+        std::size_t first = line.find(',');
+        if (first == std::string_view::npos) return std::string_view();
+        std::size_t second = line.find(',', first + 1);
+        if (second == std::string_view::npos) second = line.size();
+        std::string_view field = line.substr(first + 1, second - first - 1);
+        std::size_t end = field.find_last_not_of(" \n\r\t");
+        return (end == std::string_view::npos) ? std::string_view() : field.substr(0, end + 1);
+    }
+
+    /**
+     * @brief Mở (tạo mới) một file đích và ghi dòng tiêu đề.
+     */
+    std::unique_ptr<std::ofstream> createPartition(const std::filesystem::path& path, std::string_view header) {
+        auto out = std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc);
+        if (*out) {
+            out->write(header.data(), static_cast<std::streamsize>(header.size()));
+            out->put('\n');
+        }
+        return out;
+    }
+
+    /**
+     * @brief Lấy kích thước và thời điểm sửa đổi (đơn vị của std::filesystem::file_time_type) của một file.
+     */
+    bool fileStamp(const std::string& filename, std::uintmax_t& size, std::int64_t& modified) {
+        std::error_code error;
+        const std::filesystem::path path = std::filesystem::u8path(filename);
+        size = std::filesystem::file_size(path, error);
+        if (error) return false;
+        auto time = std::filesystem::last_write_time(path, error);
+        if (error) return false;
+        modified = static_cast<std::int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+} // namespace
+
+/**
+ * @brief Đường dẫn file của một kỳ lương.
+ */
+std::string AttendancePartitions::pathFor(const std::string& directory, int month, int year) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "%04d-%02d.csv", year, month);
+    return directory + "/" + name;
+}
+
+/**
+ * @brief Kiểm tra thư mục phân vùng có tồn tại hay không.
+ */
+bool AttendancePartitions::isPartitioned(const std::string& directory) {
+    std::error_code error;
+    return std::filesystem::is_directory(std::filesystem::u8path(directory), error);
+}
+
+/**
+ * @brief Kiểm tra file gốc có thay đổi sau lần chia hay không.
+ */
+bool AttendancePartitions::isCurrent(const std::string& directory, const std::string& sourceFile) {
+    std::uintmax_t size = 0;
+    std::int64_t modified = 0;
+    if (!fileStamp(sourceFile, size, modified)) return true; // Chỉ còn các file theo tháng
+
+    std::ifstream in(std::filesystem::u8path(directory) / STAMP_FILE);
+    std::uintmax_t splitSize = 0;
+    std::int64_t splitModified = 0;
+    char comma = 0;
+    if (!(in >> splitSize >> comma >> splitModified) || comma != ',') return false;
+    return splitSize == size && splitModified == modified;
+}
+
+/**
+ * @brief Chia file chấm công thành các file theo tháng.
+ */
+bool AttendancePartitions::split(const std::string& sourceFile, const std::string& directory, PartitionSplitReport& report) {
+    report = PartitionSplitReport();
+    std::uintmax_t sourceSize = 0;
+    std::int64_t sourceModified = 0;
+    const bool hasStamp = fileStamp(sourceFile, sourceSize, sourceModified); // Trước khi đọc: sửa trong lúc chia sẽ bị coi là cũ
+    MappedFile file;
+    if (!file.open(sourceFile)) {
+        std::cerr << "Loi: Khong the mo file cham cong: " << sourceFile << std::endl;
+        return false;
+    }
+    std::error_code error;
+    const std::filesystem::path root = std::filesystem::u8path(directory);
+    std::filesystem::create_directories(root, error);
+    if (error) {
+        std::cerr << "Loi: Khong the tao thu muc: " << directory << std::endl;
+        return false;
+    }
+
+    std::string_view content = file.view();
+    std::size_t headerEnd = content.find('\n');
+    std::string_view header = content.substr(0, headerEnd);
+    if (!header.empty() && header.back() == '\r') header.remove_suffix(1);
+    std::string_view body = (headerEnd == std::string_view::npos) ? std::string_view() : content.substr(headerEnd + 1);
+
+    std::map<std::int32_t, std::unique_ptr<std::ofstream>> partitions; // Mã kỳ lương -> file đích
+    std::unique_ptr<std::ofstream> invalid;
+    std::size_t lineStart = 0;
+    while (lineStart < body.size()) {
+        std::size_t lineEnd = body.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = body.size();
+        std::string_view line = body.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        int year = 0, month = 0, day = 0;
+        std::ofstream* out = nullptr;
+        if (AttendanceParser::parseDate(workDateField(line), year, month, day)) {
+            auto& partition = partitions[AttendanceParser::periodOf(year, month)];
+            if (!partition) {
+                partition = createPartition(std::filesystem::u8path(pathFor(directory, month, year)), header);
+            }
+            out = partition.get();
+            ++report.recordCount;
+        } else {
+            if (!invalid) {
+                invalid = createPartition(root / INVALID_FILE, header);
+            }
+            out = invalid.get();
+            ++report.invalidCount;
+        }
+        out->write(line.data(), static_cast<std::streamsize>(line.size()));
+        out->put('\n');
+    }
+
+    bool ok = !invalid || static_cast<bool>(*invalid);
+    for (auto& partition : partitions) {
+        partition.second->close();
+        ok = ok && !partition.second->fail();
+    }
+    report.partitionCount = partitions.size();
+    if (ok && hasStamp) {
+        std::ofstream stamp(root / STAMP_FILE, std::ios::trunc);
+        stamp << sourceSize << ',' << sourceModified << '\n';
+        ok = static_cast<bool>(stamp);
+    }
+    if (!ok) {
+        std::cerr << "Loi: Khong the ghi file vao thu muc: " << directory << std::endl;
+    }
+    return ok;
+}
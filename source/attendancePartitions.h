@@ -0,0 +1,81 @@
+﻿#ifndef ATTENDANCE_PARTITIONS_H
+#define ATTENDANCE_PARTITIONS_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @file AttendancePartitions.h
+ * @brief Định nghĩa lớp AttendancePartitions, quy ước lưu dữ liệu chấm công theo từng kỳ lương (tháng).
+ */
+
+/**
+ * @struct PartitionSplitReport
+ * @brief Kết quả của việc chia file chấm công thành các file theo tháng.
+ */
+struct PartitionSplitReport {
+    std::size_t partitionCount = 0;   ///< @brief Số file tháng đã ghi.
+    std::size_t recordCount = 0;      ///< @brief Số dòng dữ liệu đã chia vào các file tháng.
+    std::size_t invalidCount = 0;     ///< @brief Số dòng có ngày không hợp lệ (ghi vào file INVALID_FILE).
+};
+
+/**
+ * @class AttendancePartitions
+ * @brief Các hàm tiện ích cho dữ liệu chấm công được chia theo kỳ lương.
+ *
+ * Mỗi kỳ lương được lưu trong một file CSV riêng `<thư mục>/YYYY-MM.csv` có cùng định dạng
+ * (và cùng dòng tiêu đề) với attendance.csv, nên có thể tải bằng mọi hàm tải của AttendanceManager.
+ * Tính lương một tháng chỉ cần đọc file của tháng đó.
+ *
+ * Khi chia, kích thước và thời điểm sửa đổi của file gốc được ghi vào STAMP_FILE; isCurrent() dùng
+ * nó để biết file gốc có bị sửa sau lần chia hay không (khi đó các file tháng đã cũ).
+ */
+class AttendancePartitions {
+public:
+    /** @brief Thư mục chứa các file theo tháng (tương đối với thư mục làm việc). */
+    static constexpr const char* DEFAULT_DIRECTORY = "attendance";
+
+    /** @brief Tên file (trong thư mục phân vùng) chứa các dòng có ngày không hợp lệ. */
+    static constexpr const char* INVALID_FILE = "invalid.csv";
+
+    /** @brief Tên file (trong thư mục phân vùng) ghi kích thước và thời điểm sửa đổi của file gốc lúc chia. */
+    static constexpr const char* STAMP_FILE = "source.stamp";
+
+    /**
+     * @brief Lấy đường dẫn file của một kỳ lương.
+     * @param directory Thư mục chứa các file theo tháng.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @return Đường dẫn dạng "<directory>/YYYY-MM.csv".
+     */
+    static std::string pathFor(const std::string& directory, int month, int year);
+
+    /**
+     * @brief Kiểm tra thư mục phân vùng có tồn tại hay không.
+     */
+    static bool isPartitioned(const std::string& directory);
+
+    /**
+     * @brief Kiểm tra các file theo tháng còn khớp với file gốc đã được chia ra chúng.
+     * @param directory Thư mục chứa các file theo tháng.
+     * @param sourceFile File CSV chấm công gốc.
+     * @return true nếu file gốc không còn tồn tại hoặc có đúng kích thước và thời điểm sửa đổi ghi trong
+     * STAMP_FILE; false nếu file gốc đã thay đổi sau lần chia (hoặc thư mục không có STAMP_FILE).
+     */
+    static bool isCurrent(const std::string& directory, const std::string& sourceFile);
+
+    /**
+     * @brief Chia một file chấm công thành các file theo tháng (công cụ chuyển đổi một lần).
+     * Mỗi dòng được chép nguyên văn vào file của tháng chứa ngày làm việc, giữ đúng thứ tự trong
+     * file gốc; mỗi file tháng bắt đầu bằng dòng tiêu đề của file gốc. Các dòng có ngày không
+     * hợp lệ được ghi vào INVALID_FILE. File tháng đã có sẽ bị ghi đè. Khi thành công, STAMP_FILE
+     * được ghi lại theo trạng thái của file gốc lúc bắt đầu đọc.
+     * @param sourceFile File CSV chấm công gốc.
+     * @param directory Thư mục đích (được tạo nếu chưa có).
+     * @param report Biến nhận kết quả chia file.
+     * @return true nếu thành công, false nếu không đọc được file gốc hoặc không ghi được file đích.
+     */
+    static bool split(const std::string& sourceFile, const std::string& directory, PartitionSplitReport& report);
+};
+
+#endif // ATTENDANCE_PARTITIONS_H
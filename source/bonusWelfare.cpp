@@ -1,7 +1,6 @@
 ﻿#include "bonusWelfare.h"
 #include "attendanceManager.h"
 #include "IEmployee.h" // Cần thiết để truy cập thông tin nhân viên
-#include <set>
 #include <string>
 #include <sstream>
 #include "globalDefinitions.h" // Để sử dụng WelfareType và WelfareDetails
@@ -15,7 +14,7 @@
  * @param revenueAmount Số tiền thưởng doanh thu.
  */
 BonusWelfare::BonusWelfare(double revenueAmount)
-    : revenueBonusAmount(revenueAmount)
+    : revenueBonusAmount(Money::fromDouble(revenueAmount))
 {
     details.type = WelfareType::Bonus;
     details.name = "Các khoản thưởng";
@@ -38,11 +37,11 @@ const WelfareDetails& BonusWelfare::getDetails() const
  * @param employee Tham chiếu hằng đến đối tượng IEmployee.
  * @return Giá trị tác động lên lương (tổng số tiền thưởng đủ điều kiện).
  */
-double BonusWelfare::calculateImpact(const IEmployee& employee) const
+Money BonusWelfare::calculateImpact(const IEmployee& employee) const
 {
     // TODO: Có thể là nếu đi làm đủ 5 ngày/tuần thì được thưởng....
 
-    double totalBonus = revenueBonusAmount;
+    Money totalBonus = revenueBonusAmount;
 
     return totalBonus; // Trả về tổng tác động
 }
@@ -59,32 +58,38 @@ double BonusWelfare::calculateImpact(const IEmployee& employee) const
  */
 bool BonusWelfare::isEligible(const IEmployee& employee, const AttendanceManager& attendanceManager, 
                               int targetMonth, int targetYear) const {
-    std::set<std::string> foundDayTypes;
-    const auto& allRecords = attendanceManager.getRecords();
+    // Số liệu tổng hợp của nhân viên trong đúng tháng/năm (tra cứu qua chỉ mục hoặc dữ liệu tổng hợp)
+    return isEligible(attendanceManager.summarize(employee.getEmployeeId(), targetMonth, targetYear));
+}
 
-    for (const auto& record : allRecords) {
-        if (record.employeeId == employee.getEmployeeId()) {
-            int recYear = 0, recMonth = 0;
-            if (record.workDate.length() == 10 && record.workDate[4] == '-' && record.workDate[7] == '-') {
-                 try {
-                    recYear = std::stoi(record.workDate.substr(0, 4));
-                    recMonth = std::stoi(record.workDate.substr(5, 2));
-                } catch (const std::exception& e) {
-                    // std::cerr << "LOI phan tich ngay (YYYY-MM-DD) trong BonusWelfare '" << record.workDate << "': " << e.what() << std::endl;
-                    continue; 
-                }
-            } else {
-                // std::cerr << "CANH BAO: Dinh dang ngay trong record khong dung YYYY-MM-DD (BonusWelfare): " << record.workDate << ". Bo qua." << std::endl;
-                continue;
-            }
+/**
+ * @brief Kiểm tra điều kiện nhận thưởng của nhân viên từ số liệu chấm công tổng hợp.
+ */
+bool BonusWelfare::isEligible(const IEmployee&, const AttendanceSummary& summary) const {
+    return isEligible(summary);
+}
 
-            if (recYear == targetYear && recMonth == targetMonth) {
-                foundDayTypes.insert(record.dayType);
-            }
-        }
+/**
+ * @brief Kiểm tra điều kiện nhận thưởng từ số liệu chấm công tổng hợp.
+ *
+ * @param summary Số liệu chấm công tổng hợp của kỳ lương.
+ * @return true nếu nhân viên đủ điều kiện, false ngược lại.
+ */
+bool BonusWelfare::isEligible(const AttendanceSummary& summary) const {
+    return summary.hasDayTypes(REQUIRED_DAY_TYPES);
+}
+
+/**
+ * @brief Xét điều kiện nhận thưởng của mọi nhân viên trong một kỳ lương.
+ */
+std::size_t BonusWelfare::evaluateEligibility(const AttendanceManager& attendanceManager, int month, int year,
+                                              std::vector<std::uint8_t>& eligible) const {
+    // Đổi bitmask loại ngày thành cờ đủ điều kiện ngay trên cùng vùng nhớ
+    attendanceManager.dayTypeMasksForPeriod(month, year, eligible);
+    std::size_t count = 0;
+    for (std::uint8_t& flag : eligible) {
+        flag = (flag & REQUIRED_DAY_TYPES) == REQUIRED_DAY_TYPES ? 1 : 0;
+        count += flag;
     }
-    bool hasNormal = foundDayTypes.count("normal") > 0;
-    bool hasOvertime = foundDayTypes.count("overtime") > 0;
-    bool hasHoliday = foundDayTypes.count("holiday") > 0;
-    return (hasNormal && hasOvertime && hasHoliday);
-}
\ No newline at end of file
+    return count;
+}
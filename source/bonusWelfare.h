@@ -3,6 +3,9 @@
 
 #include "IWelfare.h" // Bao gồm định nghĩa của IWelfare
 #include "IEmployee.h" // Bao gồm định nghĩa của IEmployee
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 /**
  * @file BonusWelfare.h
@@ -21,15 +24,32 @@ class BonusWelfare : public IWelfare
 {
 private:
     WelfareDetails details;         ///< @brief Thông tin chi tiết về phúc lợi Thưởng (tên, mô tả, loại).
-    double revenueBonusAmount;      ///< @brief Số tiền thưởng cố định (ví dụ: thưởng doanh thu). Giá trị này được thiết lập khi khởi tạo.
+    Money revenueBonusAmount;       ///< @brief Số tiền thưởng cố định (ví dụ: thưởng doanh thu). Giá trị này được thiết lập khi khởi tạo.
 public:
+    /** @brief Các loại ngày phải có trong kỳ lương để được thưởng: normal, overtime và holiday. */
+    static constexpr std::uint8_t REQUIRED_DAY_TYPES = attendanceDayTypeBit(AttendanceDayType::Normal)
+                                                     | attendanceDayTypeBit(AttendanceDayType::Overtime)
+                                                     | attendanceDayTypeBit(AttendanceDayType::Holiday);
+
     /**
      * @brief Constructor cho lớp BonusWelfare.
-     * Khởi tạo phúc lợi thưởng với một số tiền thưởng cố định.
+     * Khởi tạo phúc lợi thưởng với một số tiền thưởng cố định (làm tròn tới đồng).
      * @param revenueAmount Số tiền thưởng. Mặc định là 0.0.
      */
     BonusWelfare(double revenueAmount = 0.0);
 
+    /**
+     * @brief Lấy số tiền thưởng cố định.
+     * @return Số tiền thưởng (đồng).
+     */
+    Money getRevenueBonusAmount() const { return revenueBonusAmount; }
+
+    /**
+     * @brief Đặt lại số tiền thưởng cố định (khi tải lại bảng đơn giá).
+     * @param revenueAmount Số tiền thưởng (làm tròn tới đồng).
+     */
+    void setRevenueBonusAmount(double revenueAmount) { revenueBonusAmount = Money::fromDouble(revenueAmount); }
+
     /**
      * @brief Lấy thông tin chi tiết (tên, mô tả, loại) của phúc lợi Thưởng.
      * @return Tham chiếu hằng đến đối tượng WelfareDetails.
@@ -42,7 +62,7 @@ public:
      * @param employee Tham chiếu hằng đến đối tượng IEmployee. (Hiện tại không được sử dụng trong logic tính toán này).
      * @return Số tiền thưởng.
      */
-    double calculateImpact(const IEmployee& employee) const override;
+    Money calculateImpact(const IEmployee& employee) const override;
 
     /**
      * @brief Kiểm tra xem nhân viên có đủ điều kiện nhận thưởng hay không cho một kỳ lương cụ thể.
@@ -56,6 +76,33 @@ public:
      * @return true nếu nhân viên đủ điều kiện nhận thưởng, false nếu ngược lại.
      */
     bool isEligible(const IEmployee& employee, const AttendanceManager& attendanceManager, int targetMonth, int targetYear) const override;
+
+    /**
+     * @brief Kiểm tra điều kiện nhận thưởng của nhân viên từ số liệu chấm công tổng hợp.
+     * @param employee Tham chiếu hằng đến đối tượng IEmployee (không dùng trong điều kiện hiện tại).
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @return true nếu kỳ lương có đủ ngày "normal", "overtime" và "holiday".
+     */
+    bool isEligible(const IEmployee& employee, const AttendanceSummary& summary) const override;
+
+    /**
+     * @brief Kiểm tra điều kiện nhận thưởng từ số liệu chấm công tổng hợp của kỳ lương.
+     * @param summary Số liệu chấm công tổng hợp (xem AttendanceManager::summarize).
+     * @return true nếu kỳ lương có đủ ngày "normal", "overtime" và "holiday".
+     */
+    bool isEligible(const AttendanceSummary& summary) const;
+
+    /**
+     * @brief Xét điều kiện nhận thưởng của mọi nhân viên trong một kỳ lương cùng lúc.
+     * Mỗi nhân viên chỉ cần một lần tra bitmask loại ngày và một phép AND (xem AttendanceManager::dayTypeMasksForPeriod()).
+     * @param attendanceManager Dữ liệu chấm công đã tải.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @param eligible Vector kết quả theo khóa nhân viên (xem AttendanceManager::getEmployeeIds()): 1 nếu đủ điều kiện, 0 nếu không.
+     * @return Số nhân viên đủ điều kiện.
+     */
+    std::size_t evaluateEligibility(const AttendanceManager& attendanceManager, int month, int year,
+                                    std::vector<std::uint8_t>& eligible) const;
 };
 
 #endif // _BONUS_WELFARE_H_
\ No newline at end of file
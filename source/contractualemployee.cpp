@@ -1,5 +1,5 @@
 ﻿#include "contractualemployee.h"
-#include "SalaryCalculator.h"
+#include "PayPolicy.h"
 #include "AttendanceManager.h"
 #include <sstream>
 
@@ -33,14 +33,16 @@ int ContractualEmployee::getMonthsWorked() const {
  * được quy đổi từ lương hợp đồng.
  * @return Đối tượng SalaryDetails chứa thông tin lương chi tiết.
  */
-SalaryDetails ContractualEmployee::calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const {
-    const double hourlyRate = 23800; //
-    const double overtimeRate = 0.0; //
-    const double holidayRate = 0.0;  //
+SalaryDetails ContractualEmployee::calculateSalary(const AttendanceManager& attendance, int month, int year, Money bonuses, Money allowances, Money deductions) const {
+    // Số liệu tổng hợp của đúng nhân viên và kỳ lương (month, year)
+    return calculateSalary(attendance.summarize(_employeeId, month, year), bonuses, allowances, deductions);
+}
 
-    SalaryCalculator calculator(hourlyRate, overtimeRate, holidayRate); //
-    // Truyền month, year vào hàm của SalaryCalculator
-    return calculator.calculateSalary(attendance, _employeeId, month, year, _contractAmount, bonuses, allowances, deductions);
+/**
+ * @brief Tính lương cho nhân viên hợp đồng từ số liệu chấm công tổng hợp.
+ */
+SalaryDetails ContractualEmployee::calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const {
+    return calculatePay<ContractualPayPolicy>(summary, PayRateTable::active().of(ContractualPayPolicy::CATEGORY), ContractualPayPolicy::basePay(*this), bonuses, allowances, deductions);
 }
 
 std::string ContractualEmployee::toCsvString() const {
@@ -17,7 +17,7 @@
  * nhất định, hoặc là một khoản cố định hàng tháng tùy theo logic cài đặt trong `calculateSalary`.
  * Lớp này kế thừa từ IEmployee và cài đặt các phương thức ảo cần thiết.
  */
-class ContractualEmployee : public IEmployee {
+class ContractualEmployee final : public IEmployee {
 private:
     double _contractAmount;  ///< @brief Số tiền lương thỏa thuận trong hợp đồng. Đây là lương cơ bản cố định của nhân viên hợp đồng.
     int _monthsWorked;       ///< @brief Số tháng đã làm việc của nhân viên.
@@ -43,7 +43,7 @@ public:
 
     /**
      * @brief Tính toán chi tiết lương cho nhân viên hợp đồng trong một kỳ lương cụ thể.
-     * Sử dụng SalaryCalculator để tính các thành phần lương dựa trên giờ làm việc thực tế (nếu có)
+     * Sử dụng chính sách ContractualPayPolicy (PayPolicy.h) để tính các thành phần lương dựa trên giờ làm việc thực tế (nếu có)
      * và lương hợp đồng cố định.
      * @param attendance Đối tượng quản lý chấm công.
      * @param month Tháng cần tính lương (1-12).
@@ -53,13 +53,29 @@ public:
      * @param deductions Tổng tiền khấu trừ.
      * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
      */
-    SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const override;
+    SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, Money bonuses, Money allowances, Money deductions) const override;
+
+    /**
+     * @brief Tính toán chi tiết lương cho nhân viên hợp đồng từ số liệu chấm công tổng hợp của kỳ lương.
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @param bonuses Tổng tiền thưởng.
+     * @param allowances Tổng tiền phụ cấp.
+     * @param deductions Tổng tiền khấu trừ.
+     * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
+     */
+    SalaryDetails calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const override;
     
     /**
      * @brief Lấy mức lương cơ bản theo hợp đồng.
      * @return Giá trị lương cơ bản (_contractAmount).
      */
     double getBaseSalary() const override;
+
+    /**
+     * @brief Nhóm tính lương của nhân viên.
+     * @return EmployeeCategory::Contractual.
+     */
+    EmployeeCategory getCategory() const override { return EmployeeCategory::Contractual; }
     
     /**
      * @brief Lấy số tháng đã làm việc.
@@ -0,0 +1,74 @@
+﻿#include "EmployeeIdPool.h"
+#include <algorithm>
+
+namespace {
+
+    /**
+     * @brief Băm FNV-1a 64-bit của một mã nhân viên.
+     */
+    std::uint64_t hashId(std::string_view employeeId) {
+        std::uint64_t hash = 0xCBF29CE484222325ULL;
+        for (unsigned char c : employeeId) {
+            hash = (hash ^ c) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+} // namespace
+
+/**
+ * @brief Tìm ô của một mã nhân viên (hoặc ô trống đầu tiên trên chuỗi dò).
+ */
+std::size_t EmployeeIdPool::slotOf(std::string_view employeeId) const {
+    const std::size_t mask = _slots.size() - 1;
+    std::size_t pos = static_cast<std::size_t>(hashId(employeeId)) & mask;
+    while (_slots[pos] != npos && _ids[_slots[pos]] != employeeId) {
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+/**
+ * @brief Dựng lại bảng băm với số ô mới.
+ */
+void EmployeeIdPool::rehash(std::size_t slotCount) {
+    _slots.assign(slotCount, npos);
+    for (std::uint32_t key = 0; key < _ids.size(); ++key) {
+        _slots[slotOf(_ids[key])] = key;
+    }
+}
+
+/**
+ * @brief Lấy (hoặc cấp mới) khóa cho một mã nhân viên.
+ */
+std::uint32_t EmployeeIdPool::intern(std::string_view employeeId) {
+    if (_slots.empty()) rehash(64);
+    std::size_t pos = slotOf(employeeId);
+    if (_slots[pos] != npos) {
+        return _slots[pos];
+    }
+    if ((_ids.size() + 1) * 2 > _slots.size()) { // Giữ hệ số tải <= 1/2
+        rehash(_slots.size() * 2);
+        pos = slotOf(employeeId);
+    }
+    const std::uint32_t key = static_cast<std::uint32_t>(_ids.size());
+    _ids.push_back(_chars.copy(employeeId));
+    _slots[pos] = key;
+    return key;
+}
+
+/**
+ * @brief Tìm khóa của một mã nhân viên.
+ */
+std::uint32_t EmployeeIdPool::find(std::string_view employeeId) const {
+    return _slots.empty() ? npos : _slots[slotOf(employeeId)];
+}
+
+/**
+ * @brief Xóa toàn bộ bảng mã nhân viên; bộ nhớ của arena, danh sách và bảng băm được giữ lại.
+ */
+void EmployeeIdPool::clear() {
+    _ids.clear();
+    std::fill(_slots.begin(), _slots.end(), npos);
+    _chars.reset();
+}
@@ -0,0 +1,88 @@
+﻿#ifndef EMPLOYEE_ID_POOL_H
+#define EMPLOYEE_ID_POOL_H
+
+#include "MonotonicArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file EmployeeIdPool.h
+ * @brief Định nghĩa lớp EmployeeIdPool, bảng "intern" mã nhân viên thành khóa số 32-bit.
+ */
+
+/**
+ * @class EmployeeIdPool
+ * @brief Ánh xạ hai chiều giữa mã nhân viên (chuỗi) và khóa số nguyên 32-bit.
+ *
+ * Mỗi mã nhân viên chỉ được lưu một lần; các bản ghi chấm công dạng nén chỉ giữ khóa số.
+ * Khóa được cấp theo thứ tự xuất hiện lần đầu (0, 1, 2, ...).
+ *
+ * Ký tự của các mã được lưu liền nhau trong một MonotonicArena và bảng tra cứu là bảng băm
+ * địa chỉ mở trên một vector, nên không có cấp phát heap riêng cho từng mã; clear() thu hồi
+ * tất cả một lần và giữ lại bộ nhớ cho lần tải lại sau.
+ */
+class EmployeeIdPool {
+private:
+    MonotonicArena _chars;               ///< @brief Ký tự của các mã nhân viên.
+    std::vector<std::string_view> _ids;  ///< @brief Danh sách mã nhân viên theo khóa (trỏ vào _chars).
+    std::vector<std::uint32_t> _slots;   ///< @brief Bảng băm địa chỉ mở (dò tuyến tính): khóa, hoặc npos nếu ô trống.
+
+    /**
+     * @brief Tìm ô chứa mã nhân viên, hoặc ô trống nơi mã sẽ được thêm vào.
+     */
+    std::size_t slotOf(std::string_view employeeId) const;
+
+    /**
+     * @brief Dựng lại bảng băm với số ô mới (lũy thừa của 2).
+     */
+    void rehash(std::size_t slotCount);
+
+public:
+    /** @brief Giá trị khóa biểu thị "không tìm thấy". */
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    EmployeeIdPool() = default;
+    EmployeeIdPool(const EmployeeIdPool&) = delete;            // _ids trỏ vào _chars nên không sao chép nông được
+    EmployeeIdPool& operator=(const EmployeeIdPool&) = delete;
+    EmployeeIdPool(EmployeeIdPool&&) = default;                // Di chuyển arena giữ nguyên địa chỉ các ký tự
+    EmployeeIdPool& operator=(EmployeeIdPool&&) = default;
+
+    /**
+     * @brief Lấy khóa của một mã nhân viên, cấp khóa mới nếu mã chưa có.
+     * @param employeeId Mã nhân viên.
+     * @return Khóa số của mã nhân viên.
+     */
+    std::uint32_t intern(std::string_view employeeId);
+
+    /**
+     * @brief Tìm khóa của một mã nhân viên mà không thêm mới.
+     * @param employeeId Mã nhân viên.
+     * @return Khóa số, hoặc EmployeeIdPool::npos nếu mã chưa có trong bảng.
+     */
+    std::uint32_t find(std::string_view employeeId) const;
+
+    /**
+     * @brief Lấy mã nhân viên tương ứng với một khóa.
+     * @param key Khóa số (phải nhỏ hơn size()).
+     * @return Mã nhân viên (hợp lệ tới lần clear() tiếp theo).
+     */
+    std::string_view idOf(std::uint32_t key) const { return _ids[key]; }
+
+    /** @brief Số mã nhân viên đang có trong bảng. */
+    std::uint32_t size() const { return static_cast<std::uint32_t>(_ids.size()); }
+
+    /** @brief Xóa toàn bộ bảng (giữ lại bộ nhớ để dùng lại). */
+    void clear();
+
+    /** @brief Số byte ký tự của các mã nhân viên. */
+    std::size_t charBytes() const { return _chars.bytesUsed(); }
+
+    /** @brief Tổng số byte bộ nhớ đang giữ (arena, danh sách mã và bảng băm). */
+    std::size_t memoryBytes() const {
+        return _chars.bytesReserved() + _ids.capacity() * sizeof(std::string_view) + _slots.capacity() * sizeof(std::uint32_t);
+    }
+};
+
+#endif // EMPLOYEE_ID_POOL_H
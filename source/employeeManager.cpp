@@ -5,10 +5,12 @@
 #include "SocialInsuranceWelfare.h"
 #include "BonusWelfare.h"
 #include "transportationWelfare.h"
+#include "AttendancePartitions.h"
 #include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include "utils.h"
 #include <conio.h>
 
@@ -16,10 +18,46 @@
  * @brief Constructor, khởi tạo các phúc lợi mặc định.
  */
 EmployeeManager::EmployeeManager() : _payrollPrinter("vi-VN") {
-    // Khởi tạo các phúc lợi mặc định cho toàn hệ thống
-    _welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(0.105)); // 10.5% BHXH
-    _welfareManager.addWelfare(std::make_unique<BonusWelfare>(2000000.0)); // Thưởng 2 triệu
-    _welfareManager.addWelfare(std::make_unique<TransportationWelfare>(4000.0)); // Phụ cấp 4000 VND/km
+    // Khởi tạo các phúc lợi mặc định cho toàn hệ thống (mặc định: BHXH 10.5%, thưởng 2 triệu, 4000 VND/km)
+    const PayRateTable& rates = PayRateTable::active();
+    _welfareManager.addWelfare(std::make_unique<SocialInsuranceWelfare>(rates.socialInsuranceRate));
+    _welfareManager.addWelfare(std::make_unique<BonusWelfare>(rates.revenueBonus));
+    _welfareManager.addWelfare(std::make_unique<TransportationWelfare>(rates.transportRatePerKm));
+}
+
+/**
+ * @brief Đọc lại bảng đơn giá và áp dụng ngay.
+ */
+bool EmployeeManager::reloadPayRates(const std::string& filename) {
+    PayRateTable table = PayRateTable::defaults();
+    if (!table.loadFromFile(filename)) {
+        return false;
+    }
+    if (table != PayRateTable::active()) {
+        PayRateTable::setActive(table);
+        applyWelfareRates(table);
+        _payrollCache.clear(); // Mọi kết quả lương đã lưu được tính theo đơn giá cũ
+    }
+    return true;
+}
+
+/**
+ * @brief Áp tham số phúc lợi của bảng đơn giá vào các phúc lợi chuẩn.
+ */
+void EmployeeManager::applyWelfareRates(const PayRateTable& table) {
+    bool bonusSet = false, insuranceSet = false, transportSet = false;
+    for (const auto& welfare : _welfareManager.getWelfareList()) {
+        if (auto* bonus = dynamic_cast<BonusWelfare*>(welfare.get()); bonus && !bonusSet) {
+            bonus->setRevenueBonusAmount(table.revenueBonus);
+            bonusSet = true;
+        } else if (auto* insurance = dynamic_cast<SocialInsuranceWelfare*>(welfare.get()); insurance && !insuranceSet) {
+            insurance->setEmployeeContributionRate(table.socialInsuranceRate);
+            insuranceSet = true;
+        } else if (auto* transport = dynamic_cast<TransportationWelfare*>(welfare.get()); transport && !transportSet) {
+            transport->setRatePerKm(table.transportRatePerKm);
+            transportSet = true;
+        }
+    }
 }
 
 /**
@@ -35,6 +73,7 @@ bool EmployeeManager::addEmployee(std::shared_ptr<IEmployee> emp) {
         return false; // Thêm không thành công do trùng ID
     }
     _employeeList.push_back(emp);
+    _payrollCache.syncEmployee(emp->getEmployeeId(), recordFingerprint(*emp));
     return true; // Thêm thành công
 }
 
@@ -222,11 +261,14 @@ bool EmployeeManager::loadFromFile(const std::string& filename) {
     }
 
     _employeeList.clear(); // Xóa danh sách cũ trước khi tải danh sách mới
+    _loadDiagnostics.reset(filename);
 
     std::string line;
+    std::size_t lineNumber = 0;
     // Bỏ qua dòng tiêu đề nếu có (dựa trên file employee_list.txt của bạn có dòng comment #)
     if (std::getline(inFile, line) && !line.empty() && line[0] == '#') {
         // Dòng tiêu đề đã được bỏ qua
+        lineNumber = 1;
     } else {
         // Nếu không có dòng tiêu đề hoặc file trống, xử lý dòng đầu tiên (nếu có)
         // Hoặc tua lại nếu dòng đầu tiên là dữ liệu
@@ -238,6 +280,7 @@ bool EmployeeManager::loadFromFile(const std::string& filename) {
 
 
     while (std::getline(inFile, line)) {
+        ++lineNumber;
         if (line.empty()) continue; // Bỏ qua dòng trống
         
         std::stringstream ss(line);
@@ -257,25 +300,28 @@ bool EmployeeManager::loadFromFile(const std::string& filename) {
 
         // Kiểm tra xem có đọc thiếu trường nào không
         if (ss.fail() && !ss.eof() && type.empty()) { // Nếu type rỗng và ss fail (trừ eof) -> dòng lỗi
-            std::cerr << "Loi doc dong: " << line << std::endl;
+            _loadDiagnostics.record(IngestIssue::MalformedLine, lineNumber, line);
             continue; 
         }
 
 
         double baseSalary = 0.0;
-        int monthsWorked = stoi(monthsWorkedStr);
+        int monthsWorked = 0;
 
         try {
             if (!baseSalaryStr.empty()) {
                 baseSalary = std::stod(baseSalaryStr);
             }
-        } catch (const std::invalid_argument& ia) {
-            std::cerr << "CANH BAO: Luong co ban khong hop le cho MaNV " << id << ": '" << baseSalaryStr << "'. Dat bang 0." << std::endl;
-            baseSalary = 0.0;
-        } catch (const std::out_of_range& oor) {
-            std::cerr << "CANH BAO: Luong co ban qua lon cho MaNV " << id << ": '" << baseSalaryStr << "'. Dat bang 0." << std::endl;
+        } catch (const std::exception&) { // invalid_argument hoặc out_of_range
+            _loadDiagnostics.record(IngestIssue::InvalidNumber, lineNumber, baseSalaryStr, id);
             baseSalary = 0.0;
         }
+        try {
+            monthsWorked = std::stoi(monthsWorkedStr);
+        } catch (const std::exception&) { // Thâm niên rỗng hoặc không phải số
+            _loadDiagnostics.record(IngestIssue::InvalidNumber, lineNumber, monthsWorkedStr, id);
+            monthsWorked = 0;
+        }
         
         std::shared_ptr<IEmployee> emp = nullptr;
         if (type == "Full-time Employee") { // So sánh với chuỗi đầy đủ trong file
@@ -285,7 +331,7 @@ bool EmployeeManager::loadFromFile(const std::string& filename) {
         } else if (type == "Contractual Employee") { //
             emp = std::make_shared<ContractualEmployee>(id, name, address, phone, email, info, expiryDateStr, baseSalary, monthsWorked);
         } else {
-            std::cerr << "Loai nhan vien khong duoc ho tro: " << type << " cho ID: " << id << std::endl;
+            _loadDiagnostics.record(IngestIssue::UnsupportedType, lineNumber, type, id);
             continue;
         }
 
@@ -296,12 +342,14 @@ bool EmployeeManager::loadFromFile(const std::string& filename) {
             // Nếu muốn kiểm tra, bạn có thể gọi findEmployeeById trước.
             if (this->findEmployeeById(emp->getEmployeeId()) == nullptr) {
                  _employeeList.push_back(emp);
+                 _payrollCache.syncEmployee(emp->getEmployeeId(), recordFingerprint(*emp));
             } else {
-                std::cerr << "Canh bao: Ma nhan vien " << emp->getEmployeeId() << " bi trung khi tai file. Bo qua ban ghi trung." << std::endl;
+                _loadDiagnostics.record(IngestIssue::DuplicateId, lineNumber, emp->getEmployeeId());
             }
         }
     }
     inFile.close();
+    _loadDiagnostics.printSummary(std::cerr);
     return true;
 }
 
@@ -325,7 +373,35 @@ bool EmployeeManager::deleteEmployee(const std::string& empId) { //
  * @brief Thêm một bản ghi chấm công.
  */
 void EmployeeManager::addAttendanceRecord(const AttendanceRecord& record) {
-    _attendanceManager.addRecord(record);
+    if (_attendanceManager.addRecord(record)) syncPayrollCache();
+}
+
+/**
+ * @brief Xóa một bản ghi chấm công.
+ */
+bool EmployeeManager::removeAttendanceRecord(const AttendanceRecord& record) {
+    if (!_attendanceManager.removeRecord(record)) return false;
+    syncPayrollCache();
+    return true;
+}
+
+/**
+ * @brief Đồng bộ bộ nhớ đệm bảng lương với dữ liệu chấm công.
+ */
+void EmployeeManager::syncPayrollCache() {
+    const std::uint64_t version = _attendanceManager.getDataVersion();
+    if (version == _payrollCache.getAttendanceVersion()) return;
+    if (!_attendanceManager.getChangesSince(_payrollCache.getAttendanceVersion(), _attendanceChanges)) {
+        _payrollCache.syncAttendanceVersion(version); // Dữ liệu được tải lại: mọi kết quả hết hiệu lực
+        return;
+    }
+    // Thay đổi gia tăng: chỉ kết quả của đúng (nhân viên, kỳ lương) bị ảnh hưởng phải tính lại
+    const EmployeeIdPool& ids = _attendanceManager.getEmployeeIds();
+    for (const AttendanceChange& change : _attendanceChanges) {
+        _payrollCache.invalidatePeriod(std::string(ids.idOf(change.employeeKey)),
+                                       change.period % 12 + 1, change.period / 12);
+    }
+    _payrollCache.acceptAttendanceVersion(version);
 }
 
 /**
@@ -335,12 +411,69 @@ void EmployeeManager::loadAttendanceFromFile(const std::string& filename) {
     _attendanceManager.loadFromFile(filename);
 }
 
+/**
+ * @brief Ghi lại cache chấm công còn chờ ghi.
+ */
+void EmployeeManager::flushAttendanceCache() {
+    _attendanceManager.flushCache();
+}
+
+/**
+ * @brief Kiểm tra thư mục phân vùng có dùng được (tồn tại và không cũ hơn attendance.csv).
+ */
+bool EmployeeManager::usePartitions() {
+    if (!AttendancePartitions::isPartitioned(AttendancePartitions::DEFAULT_DIRECTORY)) return false;
+    if (AttendancePartitions::isCurrent(AttendancePartitions::DEFAULT_DIRECTORY, "attendance.csv")) {
+        _stalePartitionsReported = false;
+        return true;
+    }
+    if (!_stalePartitionsReported) {
+        std::cerr << "CANH BAO: attendance.csv da thay doi sau khi chia vao thu muc "
+                  << AttendancePartitions::DEFAULT_DIRECTORY
+                  << "; dung attendance.csv (chay lai attendanceSplitter de dung cac file theo thang)." << std::endl;
+        _stalePartitionsReported = true;
+    }
+    return false;
+}
+
+/**
+ * @brief Cập nhật dữ liệu chấm công cho kỳ lương (ưu tiên file theo tháng nếu đã chia).
+ */
+bool EmployeeManager::refreshAttendance(int month, int year) {
+    if (usePartitions()) {
+        _attendanceManager.refreshPartition(AttendancePartitions::DEFAULT_DIRECTORY, month, year);
+    } else {
+        _attendanceManager.refreshFromFile("attendance.csv");
+    }
+    return !_attendanceManager.isRejected();
+}
+
+/**
+ * @brief Dấu vân tay hồ sơ nhân viên.
+ */
+std::uint64_t EmployeeManager::recordFingerprint(const IEmployee& emp) {
+    return PayrollHistory::recordFingerprint(emp);
+}
+
+/**
+ * @brief Cập nhật dữ liệu chấm công của cả năm.
+ */
+bool EmployeeManager::refreshAttendanceYear(int year) {
+    if (usePartitions()) {
+        _attendanceManager.loadPartitionYear(AttendancePartitions::DEFAULT_DIRECTORY, year);
+    } else {
+        _attendanceManager.refreshFromFile("attendance.csv");
+    }
+    return !_attendanceManager.isRejected();
+}
+
 void EmployeeManager::printPayroll(const std::string& empId, int month, int year) {
-    _attendanceManager.loadFromFile("attendance.csv");
+    const bool attendanceLoaded = refreshAttendance(month, year);
+    syncPayrollCache();
 
     auto emp = findEmployeeById(empId);
     // ... (phần kiểm tra emp và báo lỗi nếu không tìm thấy như cũ) ...
-    if (!emp) {
+    if (!emp || !attendanceLoaded) {
         clearScreen(); 
         int w, h;
         getConsoleWindowSize(w, h);
@@ -357,15 +490,25 @@ void EmployeeManager::printPayroll(const std::string& empId, int month, int year
         drawBorder(frameX1, frameY1, frameX2, frameY2);
         printCenteredText("LOI: IN PHIEU LUONG", frameY1 + FRAME_TITLE_Y_OFFSET, w);
         gotoXY(frameX1 + FRAME_CONTENT_START_X_OFFSET, frameY1 + FRAME_CONTENT_START_Y_OFFSET +1); 
-        std::cout << "Khong tim thay nhan vien voi ma ID: " << empId;
+        if (!emp) {
+            std::cout << "Khong tim thay nhan vien voi ma ID: " << empId;
+        } else {
+            std::cout << "Du lieu cham cong bi tu choi (ban ghi trung lap/chong gio), khong tinh luong.";
+        }
         cDelay(2000);
         return; 
     }
 
 
-    double bonuses = 0.0, allowances = 0.0, deductions = 0.0;
-    _welfareManager.calculateAllWelfareForEmployee(*emp, _attendanceManager, month, year, bonuses, allowances, deductions);
-    SalaryDetails details = emp->calculateSalary(_attendanceManager, month, year, bonuses, allowances, deductions);
+    SalaryDetails details;
+    if (const SalaryDetails* cached = _payrollCache.find(empId, month, year)) {
+        details = *cached;
+    } else {
+        Money bonuses, allowances, deductions;
+        _welfareManager.calculateAllWelfareForEmployee(*emp, _attendanceManager, month, year, bonuses, allowances, deductions);
+        details = emp->calculateSalary(_attendanceManager, month, year, bonuses, allowances, deductions);
+        _payrollCache.store(empId, month, year, details);
+    }
 
     // Chuẩn bị màn hình cho phiếu lương console
     clearScreen(); 
@@ -377,7 +520,7 @@ void EmployeeManager::printPayroll(const std::string& empId, int month, int year
     int payslipFrameY2 = windowHeight - 1 - FRAME_MARGIN_Y -1; // Trừ 1 dòng cho footer
 
     if (payslipFrameX2 <= payslipFrameX1 + 55) payslipFrameX2 = payslipFrameX1 + 55; 
-    if (payslipFrameY2 <= payslipFrameY1 + 18) payslipFrameY2 = payslipFrameY1 + 18; 
+    if (payslipFrameY2 <= payslipFrameY1 + 21) payslipFrameY2 = payslipFrameY1 + 21; 
     if (payslipFrameX2 >= windowWidth) payslipFrameX2 = windowWidth -1;
     if (payslipFrameY2 >= windowHeight -1) payslipFrameY2 = windowHeight -2;
 
@@ -387,24 +530,28 @@ void EmployeeManager::printPayroll(const std::string& empId, int month, int year
     printCenteredText(separator, payslipFrameY1 + FRAME_TITLE_Y_OFFSET + 1, windowWidth); // +1 để xuống dòng
 
     // In ra console
-    _payrollPrinter.printPaySlip(emp, details); 
+    const AttendanceTotals attendance = _attendanceManager.getAttendanceTotals(empId, month, year);
+    const int payslipEndY = _payrollPrinter.printPaySlip(emp, details, attendance); 
 
     // Tạo tên file và xuất ra file txt
     std::ostringstream ossFilename;
     ossFilename << emp->getEmployeeId() << "_" << month << "_" << year << ".txt";
-    _payrollPrinter.printPaySlipToFile(emp, details, ossFilename.str());
+    _payrollPrinter.printPaySlipToFile(emp, details, attendance, ossFilename.str());
 
     // Hiển thị thông báo đã xuất file ở cuối màn hình console, bên trong khung
 
     int tab = windowWidth / 4 + 2 ;
 
-    gotoXY(payslipFrameX1 + FRAME_CONTENT_START_X_OFFSET + tab, payslipFrameY2 - 10); // Gần cuối khung
     std::string exportMsg = "Da xuat phieu luong ra file: " + ossFilename.str();
     // Tính toán vị trí X để căn giữa thông báo này, hoặc đặt ở vị trí cố định
     int msgX = payslipFrameX1 + FRAME_CONTENT_START_X_OFFSET;
-    if (payslipFrameY2 -1 > payslipFrameY1 + 18) { // Đảm bảo có chỗ cho thông báo
-         gotoXY(msgX+tab, payslipFrameY2 - 10 ); // Gần cuối khung
+    int msgY = payslipEndY + 1; // Ngay dưới phiếu lương
+    if (msgY + 1 < payslipFrameY2) { // Đảm bảo có chỗ cho thông báo
+         gotoXY(msgX+tab, msgY);
          std::cout << exportMsg; // Xóa phần dư
+         const PayrollCacheStats stats = _payrollCache.getStats();
+         gotoXY(msgX+tab, msgY + 1);
+         std::cout << "Bo nho dem bang luong: " << stats.hits << " lan dung lai, " << stats.misses << " lan tinh moi";
     }
     // App::run() sẽ chờ getch()
 }
@@ -413,10 +560,13 @@ const std::vector<std::shared_ptr<IEmployee>>& EmployeeManager::getEmployees() c
     return _employeeList;
 }
 
-void EmployeeManager::printAllPayrolls(const std::string& filename, int month, int year) {
+bool EmployeeManager::printAllPayrolls(const std::string& filename, int month, int year, bool replacePaid) {
     // 1. Tải dữ liệu chấm công mới nhất
     //    Hàm loadFromFile của AttendanceManager sẽ in ra thông báo "Da tai X ban ghi..."
-    _attendanceManager.loadFromFile("attendance.csv");
+    //    Dữ liệu bị từ chối: dừng lại, không ghi lương bằng 0 vào file và lịch sử chi trả
+    const bool attendanceLoaded = refreshAttendance(month, year);
+    syncPayrollCache();
+    if (!attendanceLoaded) return false;
 
     std::vector<std::pair<std::shared_ptr<IEmployee>, SalaryDetails>> payrollData;
 
@@ -425,25 +575,147 @@ void EmployeeManager::printAllPayrolls(const std::string& filename, int month, i
         // Ghi file rỗng hoặc file chỉ có tiêu đề
     }
 
-    // 2. Lặp qua từng nhân viên để tính lương
+    // 2. Lấy kết quả còn hiệu lực từ bộ nhớ đệm, gom các nhân viên cần tính lại
+    std::vector<std::shared_ptr<IEmployee>> pending;
+    payrollData.reserve(_employeeList.size());
     for (const auto& emp : _employeeList) {
-        if (!emp) continue; // Bỏ qua nếu con trỏ null (dù không nên xảy ra)
+        if (!emp) continue;
+        if (const SalaryDetails* cached = _payrollCache.find(emp->getEmployeeId(), month, year)) {
+            payrollData.emplace_back(emp, *cached);
+        } else {
+            payrollData.emplace_back(emp, SalaryDetails());
+            pending.push_back(emp);
+        }
+    }
 
-        // 3. Tính toán các khoản phúc lợi cho tháng/năm cụ thể
-        double bonuses = 0.0, allowances = 0.0, deductions = 0.0;
-        // Giả định WelfareManager::calculateAllWelfareForEmployee đã được cập nhật để nhận month, year
-        _welfareManager.calculateAllWelfareForEmployee(*emp, _attendanceManager, month, year, bonuses, allowances, deductions);
-        
-        // 4. Tính toán chi tiết lương cho tháng/năm cụ thể
-        // Giả định các lớp con của IEmployee đã cập nhật calculateSalary để nhận month, year
-        SalaryDetails details = emp->calculateSalary(_attendanceManager, month, year, bonuses, allowances, deductions);
-        
-        payrollData.push_back({emp, details});
+    // 3-4. Tính phúc lợi và lương của các nhân viên còn lại cho tháng/năm cụ thể:
+    //      dữ liệu chấm công của kỳ chỉ được quét một lần cho cả danh sách (xem PayrollEngine),
+    //      kết quả giống hệt việc gọi calculateAllWelfareForEmployee/calculateSalary cho từng người.
+    if (!pending.empty()) {
+        std::vector<std::pair<std::shared_ptr<IEmployee>, SalaryDetails>> computed;
+        _payrollEngine.calculateAll(pending, _attendanceManager, _welfareManager, month, year, computed);
+        std::size_t next = 0;
+        for (auto& entry : payrollData) {
+            if (next == computed.size()) break;
+            if (entry.first != computed[next].first) continue;
+            entry.second = computed[next].second;
+            _payrollCache.store(entry.first->getEmployeeId(), month, year, entry.second);
+            ++next;
+        }
     }
 
     // 5. Gọi PayrollPrinter để xuất dữ liệu ra file
     // Hàm printToFile của PayrollPrinter đã được sửa để in thêm các cột lương giờ, OT, lễ.
     _payrollPrinter.printToFile(payrollData, filename);
-    
+
+    // 6. Ghi nhận bảng lương đã chi trả cùng dấu vân tay dữ liệu đầu vào (cho printRetroactiveAdjustments).
+    //    Kỳ đã có lịch sử giữ nguyên mốc chi trả, nếu không thì các khoản chênh lệch chưa trả sẽ mất.
+    PayrollHistory& history = payrollHistory();
+    if (!replacePaid && history.findPeriod(month, year)) return true;
+
+    std::vector<AttendanceSummary> summaries;
+    _attendanceManager.summarizePeriod(month, year, summaries);
+    const EmployeeIdPool& ids = _attendanceManager.getEmployeeIds();
+    const AttendanceSummary empty;
+    const std::uint64_t rateFingerprint = PayrollHistory::rateFingerprint(PayRateTable::active());
+    std::vector<PaidPayroll> paid;
+    paid.reserve(payrollData.size());
+    for (const auto& entry : payrollData) {
+        const std::uint32_t key = ids.find(entry.first->getEmployeeId());
+        PaidPayroll record;
+        record.employeeId = entry.first->getEmployeeId();
+        record.attendanceFingerprint = PayrollHistory::attendanceFingerprint(key != EmployeeIdPool::npos ? summaries[key] : empty);
+        record.recordFingerprint = recordFingerprint(*entry.first);
+        record.rateFingerprint = rateFingerprint;
+        record.details = entry.second;
+        paid.push_back(std::move(record));
+    }
+    history.recordPeriod(month, year, std::move(paid));
+    history.saveToFile(PayrollHistory::DEFAULT_FILE);
+
     // App.cpp sẽ hiển thị thông báo "Da xuat file..." sau khi hàm này trả về.
+    return true;
+}
+
+/**
+ * @brief Tính chênh lệch lương của các kỳ đã chi trả trong một năm.
+ */
+RetroPayStats EmployeeManager::printRetroactiveAdjustments(const std::string& filename, int year) {
+    // 1. Dữ liệu chấm công hiện tại của cả năm (một lần tải)
+    const bool attendanceLoaded = refreshAttendanceYear(year);
+    syncPayrollCache();
+    if (!attendanceLoaded) return RetroPayStats();
+
+    // 2. Chỉ các (nhân viên, kỳ) có dữ liệu đầu vào khác lúc chi trả mới được tính lại
+    PayrollHistory& history = payrollHistory();
+    std::vector<PayAdjustment> adjustments;
+    const RetroPayStats stats = _retroPayEngine.calculate(history, _employeeList, _attendanceManager, _welfareManager, year, adjustments);
+    _payrollPrinter.printAdjustmentsToFile(adjustments, stats, year, filename);
+
+    // 3. Các khoản chênh lệch được coi là đã chi trả
+    if (!adjustments.empty()) {
+        RetroPayEngine::accept(history, adjustments);
+        history.saveToFile(PayrollHistory::DEFAULT_FILE);
+    }
+    return stats;
+}
+
+/**
+ * @brief Kiểm tra kỳ lương đã có trong lịch sử chi trả.
+ */
+bool EmployeeManager::isPeriodPaid(int month, int year) {
+    return payrollHistory().findPeriod(month, year) != nullptr;
+}
+
+/**
+ * @brief Lịch sử chi trả, đọc từ file ở lần gọi đầu tiên.
+ */
+PayrollHistory& EmployeeManager::payrollHistory() {
+    if (!_payrollHistoryLoaded) {
+        _payrollHistory.loadFromFile(PayrollHistory::DEFAULT_FILE); // Chưa có file: lịch sử rỗng
+        _payrollHistoryLoaded = true;
+    }
+    return _payrollHistory;
+}
+
+/**
+ * @brief Tính và xuất bảng lương cả năm.
+ */
+bool EmployeeManager::printYearPayroll(const std::string& matrixFilename, const std::string& summaryFilename, int year) {
+    // 1. Một lần tải dữ liệu chấm công của cả năm (thay cho 12 lần tải theo tháng)
+    const bool attendanceLoaded = refreshAttendanceYear(year);
+    syncPayrollCache();
+    if (!attendanceLoaded) return false;
+
+    // 2. Một lần duyệt số liệu tổng hợp của năm, tính ma trận nhân viên x 12 tháng
+    PayrollYear payrollYear;
+    _payrollEngine.calculateYear(_employeeList, _attendanceManager, _welfareManager, year, payrollYear);
+
+    // 3. Xuất ma trận và bản tổng hợp
+    _payrollPrinter.printYearToFile(payrollYear, matrixFilename);
+    _payrollPrinter.printYearSummaryToFile(payrollYear, summaryFilename);
+    return true;
+}
+
+/**
+ * @brief Mô phỏng chi phí lương theo các kịch bản trong file.
+ */
+std::size_t EmployeeManager::simulatePayRates(const std::string& scenarioFilename, const std::string& reportFilename, int month, int year) {
+    if (!refreshAttendance(month, year)) return 0;
+
+    // 1. Một lần tổng hợp giờ công và dựng dữ liệu theo cột
+    _payrollSimulator.load(_employeeList, _attendanceManager, _welfareManager, month, year);
+
+    // 2. Kịch bản hiện hành luôn đứng đầu để làm mốc so sánh
+    const PayScenario current = _payrollSimulator.baseline();
+    std::vector<PayScenario> scenarios(1, current);
+    if (!PayrollSimulator::loadScenarios(scenarioFilename, current, scenarios)) {
+        return 0;
+    }
+
+    // 3. Đánh giá mọi kịch bản và xuất kết quả
+    std::vector<ScenarioResult> results;
+    _payrollSimulator.evaluate(scenarios, results);
+    _payrollPrinter.printSimulationToFile(scenarios, results, _payrollSimulator.getEmployeeCount(), month, year, reportFilename);
+    return scenarios.size();
 }
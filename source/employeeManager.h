@@ -5,6 +5,13 @@
 #include "AttendanceManager.h"
 #include "WelfareManager.h"
 #include "PayrollPrinter.h"
+#include "PayrollEngine.h"
+#include "PayrollCache.h"
+#include "PayrollSimulator.h"
+#include "PayRateTable.h"
+#include "PayrollHistory.h"
+#include "RetroPayEngine.h"
+#include "IngestDiagnostics.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -28,12 +35,67 @@ private:
     AttendanceManager _attendanceManager;                   ///< @brief Đối tượng quản lý dữ liệu chấm công.
     WelfareManager _welfareManager;                         ///< @brief Đối tượng quản lý các loại phúc lợi.
     PayrollPrinter _payrollPrinter;                         ///< @brief Đối tượng dùng để in phiếu lương và các báo cáo.
+    PayrollEngine _payrollEngine;                           ///< @brief Bộ tính lương hàng loạt cho printAllPayrolls().
+    PayrollCache _payrollCache;                             ///< @brief Kết quả tính lương đã có theo (nhân viên, kỳ lương).
+    PayrollSimulator _payrollSimulator;                     ///< @brief Bộ mô phỏng chi phí lương theo kịch bản đơn giá.
+    PayrollHistory _payrollHistory;                         ///< @brief Lịch sử chi trả (đọc từ file ở lần dùng đầu tiên).
+    bool _payrollHistoryLoaded = false;                     ///< @brief Đã đọc PayrollHistory::DEFAULT_FILE hay chưa.
+    RetroPayEngine _retroPayEngine;                         ///< @brief Bộ tính chênh lệch lương của các kỳ đã chi trả.
+    IngestDiagnostics _loadDiagnostics;                     ///< @brief Các dòng lỗi của lần tải danh sách nhân viên gần nhất.
+
+    bool _stalePartitionsReported = false;                  ///< @brief Đã cảnh báo thư mục phân vùng cũ hơn "attendance.csv".
+
+    /**
+     * @brief Kiểm tra có dùng thư mục phân vùng theo tháng (AttendancePartitions::DEFAULT_DIRECTORY) được không.
+     * Nếu "attendance.csv" đã thay đổi sau lần chia (AttendancePartitions::isCurrent()), các file tháng
+     * không còn đủ dữ liệu: trả về false để đọc "attendance.csv", kèm một cảnh báo (một lần) ra std::cerr.
+     */
+    bool usePartitions();
+
+    /**
+     * @brief Cập nhật dữ liệu chấm công cần cho kỳ lương tháng/năm.
+     * Nếu dùng được thư mục phân vùng (usePartitions()) thì chỉ đọc file của tháng đó; nếu không thì
+     * đọc "attendance.csv". Dữ liệu chỉ được đọc lại khi file thay đổi.
+     * @return false nếu dữ liệu bị từ chối (AttendanceManager::isRejected()); khi đó không được tính lương.
+     */
+    bool refreshAttendance(int month, int year);
+
+    /**
+     * @brief Cập nhật dữ liệu chấm công của cả năm: đọc các file theo tháng của năm (nếu usePartitions())
+     * trong một lần tải, nếu không thì đọc "attendance.csv" (chỉ khi file thay đổi).
+     * @return false nếu dữ liệu bị từ chối (AttendanceManager::isRejected()); khi đó không được tính lương.
+     */
+    bool refreshAttendanceYear(int year);
+
+    /**
+     * @brief Dấu vân tay các trường hồ sơ của nhân viên (dòng lưu file và thâm niên) dùng cho PayrollCache.
+     */
+    static std::uint64_t recordFingerprint(const IEmployee& emp);
+
+    /**
+     * @brief Đồng bộ bộ nhớ đệm bảng lương với dữ liệu chấm công hiện tại: nếu dữ liệu chỉ thay đổi
+     * gia tăng thì chỉ xóa kết quả của các (nhân viên, kỳ lương) bị ảnh hưởng, ngược lại xóa tất cả.
+     */
+    void syncPayrollCache();
+
+    /**
+     * @brief Áp tham số phúc lợi của bảng đơn giá vào các phúc lợi chuẩn (phần tử đầu tiên của mỗi
+     * loại BonusWelfare, SocialInsuranceWelfare, TransportationWelfare trong WelfareManager).
+     */
+    void applyWelfareRates(const PayRateTable& table);
+
+    /**
+     * @brief Lịch sử chi trả, đọc từ PayrollHistory::DEFAULT_FILE ở lần gọi đầu tiên.
+     */
+    PayrollHistory& payrollHistory();
+
+    std::vector<AttendanceChange> _attendanceChanges; ///< @brief Vùng nhớ dùng lại cho syncPayrollCache().
 
 public:
     /**
      * @brief Constructor của EmployeeManager.
      * Khởi tạo đối tượng PayrollPrinter và tự động thêm các phúc lợi mặc định
-     * vào WelfareManager (ví dụ: BHXH, Thưởng, Phụ cấp đi lại).
+     * vào WelfareManager (ví dụ: BHXH, Thưởng, Phụ cấp đi lại) với tham số của bảng đơn giá đang áp dụng.
      */
     EmployeeManager();
 
@@ -91,25 +153,49 @@ public:
 
     /**
      * @brief Tải danh sách nhân viên từ file, thay thế danh sách hiện tại.
-     * Xử lý lỗi đọc file và chuyển đổi dữ liệu.
+     * Xử lý lỗi đọc file và chuyển đổi dữ liệu: các dòng lỗi được ghi nhận theo loại (xem
+     * getLoadDiagnostics()) và in thành một bản tóm tắt duy nhất khi tải xong.
      * @param filename Tên file chứa dữ liệu nhân viên (thường là "employee_list.txt").
      * @return true nếu tải thành công (có thể không có bản ghi nào được thêm nếu file lỗi), false nếu không mở được file.
      */
     bool loadFromFile(const std::string& filename);
 
+    /**
+     * @brief Lấy các lỗi dữ liệu của lần tải danh sách nhân viên gần nhất.
+     * @return Tham chiếu hằng đến bộ thu thập lỗi.
+     */
+    const IngestDiagnostics& getLoadDiagnostics() const { return _loadDiagnostics; }
+
     // --- Quản lý Chấm công ---
     /**
     * @brief Thêm một bản ghi chấm công thủ công.
+    * Số liệu tổng hợp của đúng nhân viên và kỳ lương được cập nhật O(1), nên phiếu lương của cặp đó
+    * được tính lại ngay lần in sau; các kết quả lương đã lưu khác vẫn được dùng lại.
     * @param record Bản ghi AttendanceRecord cần thêm.
     */
     void addAttendanceRecord(const AttendanceRecord& record);
 
+    /**
+    * @brief Xóa một bản ghi chấm công (ví dụ bản ghi nhập nhầm).
+    * Số liệu tổng hợp và điều kiện phúc lợi (như thưởng đủ 3 loại ngày) của đúng nhân viên và kỳ lương
+    * được cập nhật O(1); chỉ kết quả lương đã lưu của cặp đó bị tính lại.
+    * @param record Bản ghi cần xóa.
+    * @return true nếu đã xóa, false nếu không tìm thấy.
+    */
+    bool removeAttendanceRecord(const AttendanceRecord& record);
+
     /**
     * @brief Tải dữ liệu chấm công từ file CSV.
     * @param filename Tên file CSV (ví dụ: "attendance.csv").
     */
     void loadAttendanceFromFile(const std::string& filename);
 
+    /**
+    * @brief Ghi lại cache nhị phân của file chấm công nếu đã có dòng được nối thêm từ lần ghi cache trước
+    * (gọi khi thoát chương trình, xem AttendanceManager::flushCache()).
+    */
+    void flushAttendanceCache();
+
 
     // --- Tính toán & In Lương ---
     /**
@@ -117,6 +203,8 @@ public:
      * Đồng thời xuất phiếu lương này ra một file TXT riêng.
      * Tự động tải dữ liệu chấm công mới nhất trước khi tính.
      * Tự quản lý việc xóa màn hình và vẽ giao diện cho phiếu lương.
+     * Kết quả được lấy từ bộ nhớ đệm nếu hồ sơ nhân viên và dữ liệu chấm công chưa đổi từ lần tính trước.
+     * Nếu dữ liệu chấm công bị từ chối (DuplicatePolicy::Reject) thì chỉ hiển thị lỗi, không xuất phiếu lương.
      * @param empId Mã của nhân viên cần in phiếu lương.
      * @param month Tháng tính lương (1-12).
      * @param year Năm tính lương.
@@ -126,11 +214,95 @@ public:
     /**
      * @brief Tính toán và xuất bảng lương tổng hợp của tất cả nhân viên ra file cho một kỳ lương.
      * Tự động tải dữ liệu chấm công mới nhất trước khi tính.
+     * Danh sách lớn được tính song song (xem setPayrollThreadCount()); file xuất ra giống hệt khi tính tuần tự.
+     * Chỉ các nhân viên chưa có kết quả còn hiệu lực trong bộ nhớ đệm mới được tính lại.
+     * Lần xuất đầu tiên của một kỳ được ghi nhận là đã chi trả trong lịch sử chi trả (PayrollHistory::DEFAULT_FILE);
+     * các lần xuất sau giữ nguyên lịch sử (chênh lệch được tính bằng printRetroactiveAdjustments()),
+     * trừ khi replacePaid = true.
      * @param filename Tên file để xuất bảng lương (ví dụ: "payroll_export.txt").
      * @param month Tháng tính lương (1-12).
      * @param year Năm tính lương.
+     * @param replacePaid true: ghi đè lịch sử chi trả đã có của kỳ bằng bảng lương vừa xuất.
+     * @return false nếu dữ liệu chấm công bị từ chối: không tính lương, không ghi file và không ghi lịch sử chi trả.
+     */
+    bool printAllPayrolls(const std::string& filename, int month, int year, bool replacePaid = false); // Thêm month, year
+
+    /**
+     * @brief Kiểm tra kỳ lương đã được ghi nhận chi trả trong lịch sử chi trả hay chưa.
+     */
+    bool isPeriodPaid(int month, int year);
+
+    /**
+     * @brief Tính bảng lương 12 tháng của tất cả nhân viên trong một năm bằng một lần tải và một lần
+     * duyệt dữ liệu chấm công của cả năm (PayrollEngine::calculateYear()), rồi xuất ma trận lương ròng
+     * (nhân viên x tháng) và bản tổng hợp cả năm ra file.
+     * @param matrixFilename Tên file ma trận (ví dụ: "payroll_year_2025.txt").
+     * @param summaryFilename Tên file tổng hợp (ví dụ: "payroll_year_2025_summary.txt").
+     * @param year Năm tính lương.
+     * @return false nếu dữ liệu chấm công bị từ chối (không ghi file nào).
+     */
+    bool printYearPayroll(const std::string& matrixFilename, const std::string& summaryFilename, int year);
+
+    /**
+     * @brief Mô phỏng chi phí lương của một kỳ theo các kịch bản đơn giá/hệ số/phúc lợi trong file
+     * (PayrollSimulator::loadScenarios()) và xuất chênh lệch so với mức hiện hành ra file.
+     * Số liệu giờ công của kỳ được tổng hợp một lần cho mọi kịch bản.
+     * @param scenarioFilename Tên file kịch bản (ví dụ: "pay_scenarios.txt").
+     * @param reportFilename Tên file kết quả (ví dụ: "payroll_simulation.txt").
+     * @param month Tháng của số liệu chấm công.
+     * @param year Năm của số liệu chấm công.
+     * @return Số kịch bản đã đánh giá (kể cả kịch bản hiện hành); 0 nếu không mở được file kịch bản
+     * hoặc dữ liệu chấm công bị từ chối (xem isAttendanceRejected()).
+     */
+    std::size_t simulatePayRates(const std::string& scenarioFilename, const std::string& reportFilename, int month, int year);
+
+    /**
+     * @brief Tính chênh lệch lương của các kỳ đã chi trả trong một năm khi dữ liệu chấm công hoặc hồ sơ
+     * nhân viên đã thay đổi sau khi chi trả (RetroPayEngine), xuất các khoản chênh lệch ra file và ghi nhận
+     * chúng là đã chi trả (lần tính sau chỉ còn các thay đổi mới).
+     * @param filename Tên file chênh lệch (ví dụ: "payroll_adjustments_2025.txt").
+     * @param year Năm cần xét.
+     * @return Số liệu của lần tính (số kỳ, số dòng đã xét/tính lại/có chênh lệch, tổng chênh lệch);
+     * rỗng nếu dữ liệu chấm công bị từ chối (xem isAttendanceRejected()), khi đó lịch sử không bị đổi.
+     */
+    RetroPayStats printRetroactiveAdjustments(const std::string& filename, int year);
+
+    /**
+     * @brief Kiểm tra lần tải dữ liệu chấm công gần nhất có bị từ chối theo DuplicatePolicy::Reject hay không.
+     */
+    bool isAttendanceRejected() const { return _attendanceManager.isRejected(); }
+
+    /**
+     * @brief Đọc lại bảng đơn giá (PayRateTable::loadFromFile(), tham số không ghi lấy giá trị mặc định)
+     * và áp dụng ngay cho mọi phép tính lương sau đó, không cần khởi động lại chương trình.
+     * Nếu bảng thay đổi, các phúc lợi chuẩn được cập nhật và mọi kết quả lương đã lưu được tính lại.
+     * @param filename Tên file bảng đơn giá (thường là PayRateTable::DEFAULT_FILE).
+     * @return false nếu không mở được file (bảng đơn giá đang áp dụng giữ nguyên).
+     */
+    bool reloadPayRates(const std::string& filename);
+
+    /**
+     * @brief Đặt số luồng dùng để tính bảng lương trong printAllPayrolls().
+     * @param threadCount Số luồng; 0 = theo số lõi CPU (mặc định), 1 = luôn tính tuần tự.
+     */
+    void setPayrollThreadCount(unsigned threadCount) { _payrollEngine.setThreadCount(threadCount); }
+
+    /**
+     * @brief Lấy số luồng tính bảng lương đã cấu hình (0 = theo số lõi CPU).
+     */
+    unsigned getPayrollThreadCount() const { return _payrollEngine.getThreadCount(); }
+
+    /**
+     * @brief Báo cho bộ nhớ đệm bảng lương biết hồ sơ một nhân viên vừa được sửa:
+     * mọi kết quả lương đã lưu của nhân viên đó (và chỉ của nhân viên đó) sẽ được tính lại.
+     * @param empId Mã nhân viên (gọi cho cả mã cũ và mã mới nếu mã bị đổi).
+     */
+    void invalidateEmployee(const std::string& empId) { _payrollCache.invalidateEmployee(empId); }
+
+    /**
+     * @brief Lấy số lần trúng/trượt và số kết quả của bộ nhớ đệm bảng lương.
      */
-    void printAllPayrolls(const std::string& filename, int month, int year); // Thêm month, year
+    PayrollCacheStats getPayrollCacheStats() const { return _payrollCache.getStats(); }
 
 };
 
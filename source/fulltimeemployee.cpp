@@ -1,5 +1,5 @@
 ﻿#include "FulltimeEmployee.h"
-#include "SalaryCalculator.h"
+#include "PayPolicy.h"
 #include "AttendanceManager.h"
 #include <sstream>
 
@@ -30,14 +30,16 @@ int FulltimeEmployee::getMonthsWorked() const {
 /**
  * @brief Tính lương cho nhân viên chính thức.
  */
-SalaryDetails FulltimeEmployee::calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const {
-    const double hourlyRate = 23800; //
-    const double overtimeRate = hourlyRate * 1.5; //
-    const double holidayRate = hourlyRate * 3.0; //
-
-    SalaryCalculator calculator(hourlyRate, overtimeRate, holidayRate); //
-    // Truyền month, year vào SalaryCalculator
-    return calculator.calculateSalary(attendance, _employeeId, month, year, _baseSalary, bonuses, allowances, deductions);
+SalaryDetails FulltimeEmployee::calculateSalary(const AttendanceManager& attendance, int month, int year, Money bonuses, Money allowances, Money deductions) const {
+    // Số liệu tổng hợp của đúng nhân viên và kỳ lương (month, year)
+    return calculateSalary(attendance.summarize(_employeeId, month, year), bonuses, allowances, deductions);
+}
+
+/**
+ * @brief Tính lương cho nhân viên chính thức từ số liệu chấm công tổng hợp.
+ */
+SalaryDetails FulltimeEmployee::calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const {
+    return calculatePay<FulltimePayPolicy>(summary, PayRateTable::active().of(FulltimePayPolicy::CATEGORY), FulltimePayPolicy::basePay(*this), bonuses, allowances, deductions);
 }
 
 std::string FulltimeEmployee::toCsvString() const {
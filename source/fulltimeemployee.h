@@ -18,7 +18,7 @@
  * phụ cấp và khấu trừ.
  * Lớp này kế thừa từ IEmployee và cài đặt các phương thức ảo cần thiết.
  */
-class FulltimeEmployee : public IEmployee {
+class FulltimeEmployee final : public IEmployee {
 private:
     double _baseSalary;     ///< @brief Lương cơ bản cố định hàng tháng của nhân viên.
     int _monthsWorked;      ///< @brief Số tháng đã làm việc (thâm niên) của nhân viên.
@@ -44,7 +44,7 @@ public:
 
     /**
      * @brief Tính toán chi tiết lương cho nhân viên chính thức trong một kỳ lương cụ thể.
-     * Sử dụng SalaryCalculator để tính các thành phần lương dựa trên giờ làm việc thực tế,
+     * Sử dụng chính sách FulltimePayPolicy (PayPolicy.h) để tính các thành phần lương dựa trên giờ làm việc thực tế,
      * lương cơ bản, thưởng, phụ cấp và khấu trừ.
      * @param attendance Đối tượng quản lý chấm công.
      * @param month Tháng cần tính lương (1-12).
@@ -54,7 +54,17 @@ public:
      * @param deductions Tổng tiền khấu trừ.
      * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
      */
-    SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const override;
+    SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, Money bonuses, Money allowances, Money deductions) const override;
+
+    /**
+     * @brief Tính toán chi tiết lương cho nhân viên chính thức từ số liệu chấm công tổng hợp của kỳ lương.
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @param bonuses Tổng tiền thưởng.
+     * @param allowances Tổng tiền phụ cấp.
+     * @param deductions Tổng tiền khấu trừ.
+     * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
+     */
+    SalaryDetails calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const override;
     
     /**
      * @brief Lấy mức lương cơ bản cố định của nhân viên.
@@ -62,6 +72,12 @@ public:
      */
     double getBaseSalary() const override;
 
+    /**
+     * @brief Nhóm tính lương của nhân viên.
+     * @return EmployeeCategory::Fulltime.
+     */
+    EmployeeCategory getCategory() const override { return EmployeeCategory::Fulltime; }
+
     /**
      * @brief Lấy số tháng đã làm việc (thâm niên).
      * @return Số tháng đã làm việc.
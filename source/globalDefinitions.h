@@ -1,6 +1,9 @@
 ﻿#ifndef GLOBAL_DEFINITIONS_H
 #define GLOBAL_DEFINITIONS_H
 
+#include <cstddef>
+#include <cstdint>
+#include "Money.h"
 #include <string>
 #include <vector>
 
@@ -15,6 +18,21 @@ enum class WelfareType
     Bonus              // Thưởng
 };
 
+/**
+ * @brief Nhóm nhân viên theo cách tính lương (mỗi lớp con của IEmployee thuộc đúng một nhóm).
+ * Mỗi nhóm có một chính sách lương biên dịch sẵn (xem PayPolicy.h).
+ */
+enum class EmployeeCategory : std::uint8_t
+{
+    Fulltime,       // Nhân viên chính thức (FulltimeEmployee)
+    Contractual,    // Nhân viên hợp đồng (ContractualEmployee)
+    Intern,         // Thực tập sinh (Intern)
+    Count           // Số nhóm (không phải một nhóm)
+};
+
+/** @brief Số nhóm nhân viên có chính sách lương (EmployeeCategory::Count). */
+constexpr std::size_t PAY_CATEGORY_COUNT = static_cast<std::size_t>(EmployeeCategory::Count);
+
 /**
  * @brief Cấu trúc lưu trữ một bản ghi chấm công.
  * Chứa thông tin về một lần chấm công của nhân viên.
@@ -27,18 +45,91 @@ struct AttendanceRecord {
     std::string dayType;        // // Loại ngày ("normal", "overtime", "leave", "holiday", "leave_unpaid")
 };
 
+/**
+ * @brief Định nghĩa các loại ngày chấm công (dạng nén 1 byte của AttendanceRecord::dayType).
+ */
+enum class AttendanceDayType : std::uint8_t
+{
+    Normal,         // "normal"
+    Overtime,       // "overtime"
+    Holiday,        // "holiday"
+    Leave,          // "leave"
+    LeaveUnpaid,    // "leave_unpaid"
+    Unknown         // Chuỗi loại ngày không nhận ra
+};
+
+/**
+ * @brief Các cờ trạng thái của PackedAttendanceRecord::flags.
+ */
+enum AttendanceRecordFlags : std::uint8_t
+{
+    ATTENDANCE_HAS_CHECK_IN = 1 << 0,   // Bản ghi có giờ check-in (chuỗi gốc không rỗng)
+    ATTENDANCE_HAS_CHECK_OUT = 1 << 1,  // Bản ghi có giờ check-out (chuỗi gốc không rỗng)
+    ATTENDANCE_FIXED_HOLIDAY = 1 << 2   // Ngày làm việc trùng ngày lễ cố định (xem AttendanceManager::isHoliday)
+};
+
+/**
+ * @brief Cấu trúc lưu trữ một bản ghi chấm công ở dạng nén, kích thước cố định 16 byte.
+ * Mã nhân viên được thay bằng khóa 32-bit (xem EmployeeIdPool), ngày là số ngày kể từ
+ * 1970-01-01, giờ vào/ra là số giây kể từ đầu ngày.
+ */
+struct PackedAttendanceRecord {
+    std::uint32_t employeeKey;      // Khóa của mã nhân viên trong EmployeeIdPool
+    std::int32_t checkInSeconds;    // Giờ check-in (giây kể từ 00:00:00)
+    std::int32_t checkOutSeconds;   // Giờ check-out (giây kể từ 00:00:00)
+    std::uint16_t workDay;          // Ngày làm việc (số ngày kể từ 1970-01-01, đủ đến năm 2149)
+    AttendanceDayType dayType;      // Loại ngày
+    std::uint8_t flags;             // Tổ hợp các cờ AttendanceRecordFlags
+};
+
+static_assert(sizeof(PackedAttendanceRecord) == 16, "PackedAttendanceRecord phai co kich thuoc 16 byte");
+
+/**
+ * @brief Số loại ngày chấm công (số giá trị của AttendanceDayType, kể cả Unknown).
+ */
+constexpr std::size_t ATTENDANCE_DAY_TYPE_COUNT = 6;
+
+/**
+ * @brief Bit của một loại ngày trong AttendanceSummary::dayTypeMask.
+ */
+constexpr std::uint8_t attendanceDayTypeBit(AttendanceDayType type) {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(type));
+}
+
+/**
+ * @brief Số liệu chấm công tổng hợp của một nhân viên trong một kỳ lương (tháng/năm).
+ * Được cộng dồn từng bản ghi (xem AttendanceManager::accumulate) nên có thể dựng mà
+ * không cần giữ lại các bản ghi gốc; đủ để tính lương và xét điều kiện thưởng.
+ * Thời gian tính bằng giây (số nguyên) để phép cộng dồn không phụ thuộc thứ tự bản ghi.
+ */
+struct AttendanceSummary {
+    std::int64_t paidNormalSeconds = 0;    // Số giây tính lương giờ thường (normal, không trùng ngày lễ cố định)
+    std::int64_t paidOvertimeSeconds = 0;  // Số giây tính lương tăng ca (overtime, không trùng ngày lễ cố định)
+    std::int64_t paidHolidaySeconds = 0;   // Số giây tính lương ngày lễ (holiday hoặc trùng ngày lễ cố định)
+    std::int64_t workedSeconds[ATTENDANCE_DAY_TYPE_COUNT] = {}; // Số giây làm việc theo loại ngày (giờ ra < giờ vào tính là 0)
+    std::uint32_t dayCounts[ATTENDANCE_DAY_TYPE_COUNT] = {};    // Số bản ghi theo loại ngày
+    std::uint8_t dayTypeMask = 0;          // Bit attendanceDayTypeBit(t) bật khi dayCounts[t] > 0 (cập nhật cùng dayCounts)
+
+    /** @brief Kiểm tra kỳ lương có ít nhất một bản ghi thuộc loại ngày đã cho. */
+    bool hasDayType(AttendanceDayType type) const { return (dayTypeMask & attendanceDayTypeBit(type)) != 0; }
+
+    /** @brief Kiểm tra kỳ lương có đủ mọi loại ngày trong `mask` (một phép AND). */
+    bool hasDayTypes(std::uint8_t mask) const { return (dayTypeMask & mask) == mask; }
+};
+
 /**
  * @brief Cấu trúc chứa thông tin chi tiết về lương.
- * Được sử dụng để trả về kết quả tính lương từ SalaryCalculator.
+ * Được sử dụng để trả về kết quả tính lương từ calculatePay() (PayPolicy.h).
+ * Mọi thành phần là số nguyên đồng (Money), nên totalSalary bằng đúng tổng các thành phần in ra.
  */
 struct SalaryDetails {
-    double basicSalary = 0.0;     // Lương cơ bản theo giờ làm việc
-    double overtimeSalary = 0.0;  // Lương làm thêm giờ
-    double holidaySalary = 0.0;   // Lương làm trong ngày lễ
-    double bonuses = 0.0;         // Tổng các khoản thưởng
-    double allowances = 0.0;      // Tổng các khoản trợ cấp
-    double deductions = 0.0;      // Tổng các khoản khấu trừ
-    double totalSalary = 0.0;     // Lương cuối cùng (lương ròng)
+    Money basicSalary;     // Lương cơ bản theo giờ làm việc
+    Money overtimeSalary;  // Lương làm thêm giờ
+    Money holidaySalary;   // Lương làm trong ngày lễ
+    Money bonuses;         // Tổng các khoản thưởng
+    Money allowances;      // Tổng các khoản trợ cấp
+    Money deductions;      // Tổng các khoản khấu trừ
+    Money totalSalary;     // Lương cuối cùng (lương ròng)
 };
 
 #endif // GLOBAL_DEFINITIONS_H
\ No newline at end of file
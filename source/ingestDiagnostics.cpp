@@ -0,0 +1,96 @@
+﻿#include "IngestDiagnostics.h"
+
+/**
+ * @brief Constructor.
+ */
+IngestDiagnostics::IngestDiagnostics(std::size_t exampleLimit) : _exampleLimit(exampleLimit) {}
+
+/**
+ * @brief Xóa mọi lỗi đã ghi nhận.
+ */
+void IngestDiagnostics::reset(const std::string& source) {
+    _source = source;
+    _counts.fill(0);
+    _examples.clear();
+}
+
+/**
+ * @brief Ghi nhận một dòng lỗi.
+ */
+void IngestDiagnostics::record(IngestIssue issue, std::size_t line, std::string_view value, std::string_view employeeId) {
+    ++_counts[static_cast<std::size_t>(issue)];
+    if (_examples.size() < _exampleLimit) {
+        Example& example = _examples.emplace_back();
+        example.issue = issue;
+        example.line = line;
+        example.value.assign(value);
+        example.employeeId.assign(employeeId);
+    }
+}
+
+/**
+ * @brief Gộp lỗi của một đoạn file vào cuối bộ thu thập này.
+ */
+void IngestDiagnostics::merge(const IngestDiagnostics& other, std::size_t lineOffset) {
+    for (std::size_t i = 0; i < _counts.size(); ++i) {
+        _counts[i] += other._counts[i];
+    }
+    // Mỗi đoạn giữ các ví dụ đầu tiên của nó, nên gộp lần lượt vẫn cho đúng các ví dụ đầu tiên của cả file
+    for (const auto& example : other._examples) {
+        if (_examples.size() >= _exampleLimit) break;
+        _examples.push_back(example);
+        _examples.back().line += lineOffset;
+    }
+}
+
+/**
+ * @brief Tổng số dòng lỗi.
+ */
+std::size_t IngestDiagnostics::totalCount() const {
+    std::size_t total = 0;
+    for (std::size_t value : _counts) total += value;
+    return total;
+}
+
+/**
+ * @brief In bản tóm tắt các lỗi.
+ */
+void IngestDiagnostics::printSummary(std::ostream& out) const {
+    const std::size_t total = totalCount();
+    if (total == 0) return;
+
+    out << "CANH BAO: " << _source << " co " << total << " dong loi (";
+    bool first = true;
+    for (std::size_t i = 0; i < _counts.size(); ++i) {
+        if (_counts[i] == 0) continue;
+        out << (first ? "" : ", ") << issueName(static_cast<IngestIssue>(i)) << ": " << _counts[i];
+        first = false;
+    }
+    out << ").\n";
+    for (const auto& example : _examples) {
+        out << "  - Dong " << example.line << ": " << issueName(example.issue) << " '" << example.value << "'";
+        if (!example.employeeId.empty()) out << " (NV " << example.employeeId << ")";
+        out << "\n";
+    }
+    if (total > _examples.size()) {
+        out << "  ... va " << (total - _examples.size()) << " dong loi khac.\n";
+    }
+    out.flush();
+}
+
+/**
+ * @brief Mô tả ngắn của một loại lỗi.
+ */
+const char* IngestDiagnostics::issueName(IngestIssue issue) {
+    switch (issue) {
+        case IngestIssue::InvalidDate:       return "ngay khong dung YYYY-MM-DD";
+        case IngestIssue::MissingEmployeeId: return "thieu ma nhan vien";
+        case IngestIssue::MalformedLine:     return "dong khong doc duoc";
+        case IngestIssue::InvalidNumber:     return "so khong hop le";
+        case IngestIssue::UnsupportedType:   return "loai nhan vien khong duoc ho tro";
+        case IngestIssue::DuplicateId:       return "ma nhan vien bi trung";
+        case IngestIssue::DuplicateRecord:   return "ban ghi cham cong trung lap";
+        case IngestIssue::OverlappingRecord: return "ban ghi chong gio";
+        default:                             return "loi khac";
+    }
+}
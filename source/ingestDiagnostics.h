@@ -0,0 +1,136 @@
+﻿#ifndef INGEST_DIAGNOSTICS_H
+#define INGEST_DIAGNOSTICS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file IngestDiagnostics.h
+ * @brief Định nghĩa lớp IngestDiagnostics, thu thập các lỗi dữ liệu gặp phải khi tải file.
+ */
+
+/**
+ * @enum IngestIssue
+ * @brief Các loại lỗi của một dòng dữ liệu khi tải file.
+ */
+enum class IngestIssue : std::uint8_t {
+    InvalidDate,       ///< @brief Ngày không đúng định dạng YYYY-MM-DD (hoặc ngoài phạm vi lưu trữ); dòng bị bỏ qua.
+    MissingEmployeeId, ///< @brief Dòng không có mã nhân viên; dòng bị bỏ qua.
+    MalformedLine,     ///< @brief Dòng không đọc được các trường; dòng bị bỏ qua.
+    InvalidNumber,     ///< @brief Trường số không hợp lệ hoặc quá lớn; giá trị được đặt bằng 0.
+    UnsupportedType,   ///< @brief Loại nhân viên không được hỗ trợ; dòng bị bỏ qua.
+    DuplicateId,       ///< @brief Mã nhân viên bị trùng; bản ghi sau bị bỏ qua.
+    DuplicateRecord,   ///< @brief Bản ghi chấm công trùng hoàn toàn với một bản ghi trước đó.
+    OverlappingRecord, ///< @brief Bản ghi chấm công chồng giờ với một bản ghi cùng nhân viên, cùng ngày.
+    Count              ///< @brief Số loại lỗi (không phải một loại lỗi).
+};
+
+/**
+ * @class IngestDiagnostics
+ * @brief Bộ thu thập lỗi của một lần tải file: đếm số lỗi theo từng loại, giữ lại tối đa
+ * `exampleLimit` ví dụ đầu tiên (kèm số dòng) và in một bản tóm tắt duy nhất khi tải xong,
+ * thay vì in một dòng ra std::cerr cho mỗi dòng lỗi.
+ *
+ * Số lỗi có thể được truy vấn qua count()/totalCount() để chương trình chạy theo lô dừng sớm
+ * khi dữ liệu đầu vào có lỗi. Các bộ thu thập riêng của từng đoạn file (khi phân tích song song)
+ * được gộp lại bằng merge() theo đúng thứ tự trong file.
+ */
+class IngestDiagnostics {
+public:
+    /** @brief Số ví dụ được giữ lại mặc định. */
+    static constexpr std::size_t DEFAULT_EXAMPLE_LIMIT = 5;
+
+    /**
+     * @struct Example
+     * @brief Một dòng lỗi được giữ lại làm ví dụ.
+     */
+    struct Example {
+        IngestIssue issue = IngestIssue::MalformedLine; ///< @brief Loại lỗi.
+        std::size_t line = 0;                           ///< @brief Số thứ tự dòng trong file (bắt đầu từ 1).
+        std::string value;                              ///< @brief Giá trị (hoặc nội dung dòng) gây lỗi.
+        std::string employeeId;                         ///< @brief Mã nhân viên của dòng (có thể rỗng).
+    };
+
+    /**
+     * @brief Constructor.
+     * @param exampleLimit Số ví dụ tối đa được giữ lại.
+     */
+    explicit IngestDiagnostics(std::size_t exampleLimit = DEFAULT_EXAMPLE_LIMIT);
+
+    /**
+     * @brief Xóa mọi lỗi đã ghi nhận và bắt đầu thu thập cho một file mới.
+     * @param source Tên file (dùng trong bản tóm tắt).
+     */
+    void reset(const std::string& source);
+
+    /**
+     * @brief Ghi nhận một dòng lỗi. Chuỗi chỉ được sao chép khi còn chỗ cho ví dụ.
+     * @param issue Loại lỗi.
+     * @param line Số thứ tự dòng (bắt đầu từ 1).
+     * @param value Giá trị hoặc nội dung dòng gây lỗi.
+     * @param employeeId Mã nhân viên của dòng (nếu có).
+     */
+    void record(IngestIssue issue, std::size_t line, std::string_view value, std::string_view employeeId = std::string_view());
+
+    /**
+     * @brief Kiểm tra còn chỗ giữ ví dụ hay không (để nơi gọi chỉ dựng chuỗi mô tả khi cần).
+     */
+    bool hasRoomForExample() const { return _examples.size() < _exampleLimit; }
+
+    /**
+     * @brief Gộp các lỗi của một bộ thu thập khác (ví dụ của một đoạn file) vào cuối bộ này.
+     * @param other Bộ thu thập cần gộp (số dòng trong đó tính từ đầu đoạn).
+     * @param lineOffset Số dòng đứng trước đoạn đó trong file, được cộng vào số dòng của các ví dụ.
+     */
+    void merge(const IngestDiagnostics& other, std::size_t lineOffset);
+
+    /**
+     * @brief Số dòng lỗi của một loại.
+     */
+    std::size_t count(IngestIssue issue) const { return _counts[static_cast<std::size_t>(issue)]; }
+
+    /**
+     * @brief Tổng số dòng lỗi (mọi loại).
+     */
+    std::size_t totalCount() const;
+
+    /**
+     * @brief Kiểm tra có lỗi nào được ghi nhận hay không.
+     */
+    bool hasIssues() const { return totalCount() != 0; }
+
+    /**
+     * @brief Lấy các ví dụ đã giữ lại, theo thứ tự được ghi nhận.
+     */
+    const std::vector<Example>& getExamples() const { return _examples; }
+
+    /**
+     * @brief Lấy tên file đang được thu thập lỗi.
+     */
+    const std::string& getSource() const { return _source; }
+
+    /**
+     * @brief In bản tóm tắt: tổng số lỗi theo từng loại, các ví dụ và số lỗi không được liệt kê.
+     * Không in gì nếu không có lỗi.
+     * @param out Luồng xuất (thường là std::cerr).
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * @brief Lấy mô tả ngắn (không dấu) của một loại lỗi.
+     */
+    static const char* issueName(IngestIssue issue);
+
+private:
+    std::string _source;                                                   ///< @brief Tên file đang tải.
+    std::size_t _exampleLimit;                                             ///< @brief Số ví dụ tối đa.
+    std::array<std::size_t, static_cast<std::size_t>(IngestIssue::Count)> _counts{}; ///< @brief Số lỗi theo loại.
+    std::vector<Example> _examples;                                        ///< @brief Các ví dụ đầu tiên.
+};
+
+#endif // INGEST_DIAGNOSTICS_H
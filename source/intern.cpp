@@ -1,5 +1,6 @@
 ﻿#include "Intern.h"
 #include "AttendanceManager.h"
+#include "PayPolicy.h"
 #include <sstream>
 
 /**
@@ -32,18 +33,18 @@ int Intern::getMonthsWorked() const {
  * và phụ cấp khác nếu có.
  * @return Đối tượng SalaryDetails chứa thông tin lương chi tiết.
  */
-SalaryDetails Intern::calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const {
-    // Thân hàm có thể không cần dùng đến month, year nếu lương Intern là cố định
-    // nhưng vẫn phải nhận đủ tham số để override đúng.
-    SalaryDetails details;
-    details.basicSalary = _stipend; 
-    details.overtimeSalary = 0; // Intern thường không có lương OT
-    details.holidaySalary = 0;  // Intern thường không có lương ngày lễ
-    details.bonuses = bonuses;
-    details.allowances = allowances;
-    details.deductions = deductions; 
-    details.totalSalary = details.basicSalary + details.bonuses + details.allowances - details.deductions;
-    return details;
+SalaryDetails Intern::calculateSalary(const AttendanceManager&, int, int, Money bonuses, Money allowances, Money deductions) const {
+    // Trợ cấp cố định không phụ thuộc chấm công của kỳ nên không cần tra AttendanceManager
+    return calculateSalary(AttendanceSummary(), bonuses, allowances, deductions);
+}
+
+/**
+ * @brief Tính lương cho thực tập sinh từ số liệu chấm công tổng hợp.
+ * Trợ cấp cố định nên số liệu chấm công không được sử dụng.
+ */
+SalaryDetails Intern::calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const {
+    // Intern chỉ nhận trợ cấp cố định, không có lương theo giờ, OT hay ngày lễ
+    return calculatePay<InternPayPolicy>(summary, PayRateTable::active().of(InternPayPolicy::CATEGORY), InternPayPolicy::basePay(*this), bonuses, allowances, deductions);
 }
 
 std::string Intern::toCsvString() const {
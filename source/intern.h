@@ -18,7 +18,7 @@
  * phụ cấp (nếu có) và trừ đi các khoản khấu trừ (nếu có).
  * Lớp này kế thừa từ IEmployee và cài đặt các phương thức ảo cần thiết.
  */
-class Intern : public IEmployee {
+class Intern final : public IEmployee {
 private:
     double _stipend;         ///< @brief Khoản trợ cấp cố định hàng tháng của thực tập sinh. Đây được coi là lương cơ bản của họ.
     int _monthsWorked;       ///< @brief Số tháng đã thực tập hoặc làm việc.
@@ -55,7 +55,17 @@ public:
      * @param deductions Tổng tiền khấu trừ đã được tính từ WelfareManager.
      * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
      */
-    SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, double bonuses, double allowances, double deductions) const override;
+    SalaryDetails calculateSalary(const AttendanceManager& attendance, int month, int year, Money bonuses, Money allowances, Money deductions) const override;
+
+    /**
+     * @brief Tính toán chi tiết lương cho thực tập sinh từ số liệu chấm công tổng hợp của kỳ lương.
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @param bonuses Tổng tiền thưởng.
+     * @param allowances Tổng tiền phụ cấp.
+     * @param deductions Tổng tiền khấu trừ.
+     * @return Đối tượng SalaryDetails chứa các thành phần lương chi tiết.
+     */
+    SalaryDetails calculateSalary(const AttendanceSummary& summary, Money bonuses, Money allowances, Money deductions) const override;
     
     /**
      * @brief Lấy mức lương cơ bản của thực tập sinh, chính là khoản trợ cấp hàng tháng.
@@ -63,6 +73,12 @@ public:
      */
     double getBaseSalary() const override;
 
+    /**
+     * @brief Nhóm tính lương của nhân viên.
+     * @return EmployeeCategory::Intern.
+     */
+    EmployeeCategory getCategory() const override { return EmployeeCategory::Intern; }
+
     /**
      * @brief Lấy số tháng đã làm việc/thực tập.
      * @return Số tháng đã làm việc.
@@ -0,0 +1,118 @@
+﻿#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        _data = other._data;
+        _size = other._size;
+        _isOpen = other._isOpen;
+#ifdef _WIN32
+        _fileHandle = other._fileHandle;
+        _mappingHandle = other._mappingHandle;
+        other._fileHandle = nullptr;
+        other._mappingHandle = nullptr;
+#else
+        _fd = other._fd;
+        other._fd = -1;
+#endif
+        other._data = nullptr;
+        other._size = 0;
+        other._isOpen = false;
+    }
+    return *this;
+}
+
+/**
+ * @brief Mở và ánh xạ file vào bộ nhớ.
+ */
+bool MappedFile::open(const std::string& filename) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    _fileHandle = file;
+    _size = static_cast<std::size_t>(fileSize.QuadPart);
+    if (_size > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            close();
+            return false;
+        }
+        _mappingHandle = mapping;
+        _data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (_data == nullptr) {
+            close();
+            return false;
+        }
+    }
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    _fd = fd;
+    _size = static_cast<std::size_t>(st.st_size);
+    if (_size > 0) {
+        void* addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            close();
+            return false;
+        }
+        madvise(addr, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(addr);
+    }
+#endif
+    _isOpen = true;
+    return true;
+}
+
+/**
+ * @brief Hủy ánh xạ và đóng file.
+ */
+void MappedFile::close() {
+#ifdef _WIN32
+    if (_data) UnmapViewOfFile(_data);
+    if (_mappingHandle) CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    if (_fileHandle) CloseHandle(static_cast<HANDLE>(_fileHandle));
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+#else
+    if (_data) munmap(const_cast<char*>(_data), _size);
+    if (_fd >= 0) ::close(_fd);
+    _fd = -1;
+#endif
+    _data = nullptr;
+    _size = 0;
+    _isOpen = false;
+}
@@ -0,0 +1,75 @@
+﻿#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @file MappedFile.h
+ * @brief Định nghĩa lớp MappedFile, ánh xạ (memory-map) một file vào bộ nhớ ở chế độ chỉ đọc.
+ */
+
+/**
+ * @class MappedFile
+ * @brief Lớp bao bọc việc ánh xạ file vào bộ nhớ (Windows: MapViewOfFile, POSIX: mmap).
+ *
+ * Cho phép đọc toàn bộ nội dung file thông qua một con trỏ liền mạch mà không cần
+ * sao chép vào bộ đệm riêng. Vùng nhớ được giải phóng tự động khi đối tượng bị hủy.
+ * Đối tượng không thể sao chép nhưng có thể di chuyển (move).
+ */
+class MappedFile {
+private:
+    const char* _data = nullptr; ///< @brief Con trỏ đến vùng nhớ đã ánh xạ (nullptr nếu file rỗng hoặc chưa mở).
+    std::size_t _size = 0;       ///< @brief Kích thước file (byte).
+    bool _isOpen = false;        ///< @brief Cờ cho biết file đã được mở thành công.
+#ifdef _WIN32
+    void* _fileHandle = nullptr;    ///< @brief HANDLE của file (Windows).
+    void* _mappingHandle = nullptr; ///< @brief HANDLE của đối tượng file mapping (Windows).
+#else
+    int _fd = -1;                   ///< @brief File descriptor (POSIX).
+#endif
+
+public:
+    /**
+     * @brief Constructor mặc định. Tạo đối tượng chưa ánh xạ file nào.
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief Destructor, tự động hủy ánh xạ và đóng file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Mở và ánh xạ file vào bộ nhớ ở chế độ chỉ đọc.
+     * File rỗng vẫn được coi là mở thành công (data() trả về nullptr, size() bằng 0).
+     * @param filename Đường dẫn file cần ánh xạ.
+     * @return true nếu thành công, false nếu không mở được hoặc không ánh xạ được file.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Hủy ánh xạ và đóng file (nếu đang mở).
+     */
+    void close();
+
+    /** @brief Kiểm tra file đã được mở thành công hay chưa. */
+    bool isOpen() const { return _isOpen; }
+
+    /** @brief Lấy con trỏ đến byte đầu tiên của file. */
+    const char* data() const { return _data; }
+
+    /** @brief Lấy kích thước file (byte). */
+    std::size_t size() const { return _size; }
+
+    /** @brief Lấy toàn bộ nội dung file dưới dạng string_view (không sao chép). */
+    std::string_view view() const { return std::string_view(_data, _size); }
+};
+
+#endif // MAPPED_FILE_H
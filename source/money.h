@@ -0,0 +1,95 @@
+﻿#ifndef MONEY_H
+#define MONEY_H
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @file Money.h
+ * @brief Định nghĩa kiểu Money, số tiền chính xác tính bằng số nguyên đồng (64-bit).
+ */
+
+/**
+ * @class Money
+ * @brief Số tiền lưu dưới dạng số nguyên đồng (int64), dùng cho mọi thành phần lương và phúc lợi.
+ *
+ * Quy tắc làm tròn: chỉ làm tròn khi một số tiền được tạo ra từ số thực (fromDouble, scaled)
+ * hoặc từ phép chia (forSeconds), luôn tới đồng gần nhất, nửa đồng làm tròn ra xa số 0
+ * (12,5 -> 13; -12,5 -> -13). Mọi phép cộng/trừ sau đó là phép tính số nguyên chính xác, nên:
+ * - tổng lương in ra luôn bằng đúng tổng các thành phần in trên phiếu lương;
+ * - cộng dồn theo thứ tự bất kỳ (kể cả song song, hoặc bằng lệnh vector) cho cùng một kết quả.
+ */
+class Money {
+public:
+    /** @brief Số tiền 0 đồng. */
+    constexpr Money() = default;
+
+    /**
+     * @brief Tạo số tiền từ số nguyên đồng (không làm tròn).
+     */
+    static constexpr Money fromDong(std::int64_t dong) { return Money(dong); }
+
+    /**
+     * @brief Tạo số tiền từ số thực, làm tròn tới đồng gần nhất (nửa đồng ra xa số 0).
+     */
+    static Money fromDouble(double amount) { return Money(static_cast<std::int64_t>(std::llround(amount))); }
+
+    /**
+     * @brief Tiền công của `seconds` giây với đơn giá `hourlyRate` mỗi giờ:
+     * seconds x hourlyRate / 3600, làm tròn tới đồng gần nhất (nửa đồng ra xa số 0) bằng phép chia số nguyên.
+     */
+    static constexpr Money forSeconds(std::int64_t seconds, Money hourlyRate) {
+        return Money(divideRounded(seconds * hourlyRate._dong, 3600));
+    }
+
+    /**
+     * @brief Số tiền nhân với một hệ số thực (ví dụ tỷ lệ đóng BHXH), làm tròn theo quy tắc chung.
+     */
+    Money scaled(double factor) const { return fromDouble(static_cast<double>(_dong) * factor); }
+
+    /** @brief Số đồng. */
+    constexpr std::int64_t dong() const { return _dong; }
+
+    /** @brief Giá trị dạng số thực (chỉ dùng để hiển thị hoặc tính tỷ lệ). */
+    constexpr double toDouble() const { return static_cast<double>(_dong); }
+
+    /** @brief Giá trị tuyệt đối. */
+    constexpr Money abs() const { return Money(_dong < 0 ? -_dong : _dong); }
+
+    constexpr Money operator-() const { return Money(-_dong); }
+    constexpr Money operator+(Money other) const { return Money(_dong + other._dong); }
+    constexpr Money operator-(Money other) const { return Money(_dong - other._dong); }
+    Money& operator+=(Money other) { _dong += other._dong; return *this; }
+    Money& operator-=(Money other) { _dong -= other._dong; return *this; }
+
+    constexpr bool operator==(Money other) const { return _dong == other._dong; }
+    constexpr bool operator!=(Money other) const { return _dong != other._dong; }
+    constexpr bool operator<(Money other) const { return _dong < other._dong; }
+    constexpr bool operator>(Money other) const { return _dong > other._dong; }
+    constexpr bool operator<=(Money other) const { return _dong <= other._dong; }
+    constexpr bool operator>=(Money other) const { return _dong >= other._dong; }
+
+    /**
+     * @brief Chia số nguyên và làm tròn tới số gần nhất, nửa đơn vị ra xa số 0.
+     * @param numerator Số bị chia.
+     * @param denominator Số chia (phải dương).
+     */
+    static constexpr std::int64_t divideRounded(std::int64_t numerator, std::int64_t denominator) {
+        const std::int64_t quotient = numerator / denominator;
+        const std::int64_t remainder = numerator % denominator;
+        if (2 * (remainder < 0 ? -remainder : remainder) >= denominator) {
+            return quotient + (numerator < 0 ? -1 : 1);
+        }
+        return quotient;
+    }
+
+private:
+    explicit constexpr Money(std::int64_t dong) : _dong(dong) {}
+
+    std::int64_t _dong = 0; ///< @brief Số tiền (đồng).
+};
+
+static_assert(Money::divideRounded(5, 10) == 1 && Money::divideRounded(-5, 10) == -1 && Money::divideRounded(4, 10) == 0,
+              "Money phai lam tron nua don vi ra xa so 0");
+
+#endif // MONEY_H
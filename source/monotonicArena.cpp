@@ -0,0 +1,76 @@
+﻿#include "MonotonicArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Constructor.
+ */
+MonotonicArena::MonotonicArena(std::size_t firstBlockBytes)
+    : _nextBlockBytes(firstBlockBytes > 0 ? firstBlockBytes : DEFAULT_FIRST_BLOCK_BYTES) {}
+
+/**
+ * @brief Thêm một khối mới.
+ */
+void MonotonicArena::addBlock(std::size_t minBytes) {
+    Block block;
+    block.size = (std::max)(_nextBlockBytes, minBytes);
+    block.data.reset(new char[block.size]);
+    _reserved += block.size;
+    _blocks.push_back(std::move(block));
+    _offset = 0;
+    _nextBlockBytes = (std::min)(_nextBlockBytes * 2, MAX_GROWTH_BLOCK_BYTES);
+}
+
+/**
+ * @brief Cấp phát bằng cách dịch con trỏ trong khối đang dùng.
+ */
+void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment) {
+    if (!_blocks.empty()) {
+        const Block& block = _blocks.back();
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const std::size_t start = static_cast<std::size_t>(((base + _offset + alignment - 1) & ~(alignment - 1)) - base);
+        if (start + bytes <= block.size) {
+            _used += start + bytes - _offset;
+            _offset = start + bytes;
+            return block.data.get() + start;
+        }
+    }
+    // Khối mới được cấp phát bằng new[] nên đã được căn lề theo max_align_t
+    addBlock(bytes + alignment);
+    return allocate(bytes, alignment);
+}
+
+/**
+ * @brief Sao chép một chuỗi vào arena.
+ */
+std::string_view MonotonicArena::copy(std::string_view text) {
+    if (text.empty()) return std::string_view();
+    char* stored = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(stored, text.data(), text.size());
+    return std::string_view(stored, text.size());
+}
+
+/**
+ * @brief Thu hồi dữ liệu, gộp các khối thành một khối để dùng lại.
+ */
+void MonotonicArena::reset() {
+    if (_blocks.size() > 1) {
+        const std::size_t total = _reserved;
+        _blocks.clear();
+        _reserved = 0;
+        addBlock(total);
+    }
+    _offset = 0;
+    _used = 0;
+}
+
+/**
+ * @brief Thu hồi dữ liệu và trả toàn bộ bộ nhớ.
+ */
+void MonotonicArena::release() {
+    std::vector<Block>().swap(_blocks);
+    _offset = 0;
+    _used = 0;
+    _reserved = 0;
+}
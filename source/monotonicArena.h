@@ -0,0 +1,103 @@
+﻿#ifndef MONOTONIC_ARENA_H
+#define MONOTONIC_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file MonotonicArena.h
+ * @brief Định nghĩa lớp MonotonicArena, vùng nhớ cấp phát tuần tự được giải phóng một lần.
+ */
+
+/**
+ * @class MonotonicArena
+ * @brief Vùng nhớ "monotonic": cấp phát bằng cách dịch con trỏ trong các khối lớn liên tiếp,
+ * không giải phóng từng phần tử; toàn bộ được thu hồi một lần bằng reset().
+ *
+ * Dùng cho dữ liệu được tải lại cả khối (ví dụ mã nhân viên của dữ liệu chấm công): thay vì
+ * mỗi chuỗi là một lần cấp phát heap riêng, các ký tự nằm liền nhau trong vài khối lớn.
+ * reset() gộp các khối thành một khối duy nhất đủ chứa dữ liệu lần trước, nên từ lần tải lại
+ * thứ hai trở đi (với dữ liệu cùng cỡ) không phát sinh cấp phát heap nào.
+ *
+ * Con trỏ/string_view trả về chỉ hợp lệ tới lần reset()/release() tiếp theo; di chuyển
+ * (move) đối tượng không làm thay đổi địa chỉ dữ liệu.
+ */
+class MonotonicArena {
+public:
+    /** @brief Kích thước khối đầu tiên mặc định (byte). */
+    static constexpr std::size_t DEFAULT_FIRST_BLOCK_BYTES = 4096;
+
+    /** @brief Kích thước tối đa của một khối mới khi vùng nhớ tự tăng (byte). */
+    static constexpr std::size_t MAX_GROWTH_BLOCK_BYTES = 1 << 20;
+
+    /**
+     * @brief Constructor. Chưa cấp phát khối nào cho tới lần allocate() đầu tiên.
+     * @param firstBlockBytes Kích thước khối đầu tiên; mỗi khối sau gấp đôi khối trước (tối đa MAX_GROWTH_BLOCK_BYTES).
+     */
+    explicit MonotonicArena(std::size_t firstBlockBytes = DEFAULT_FIRST_BLOCK_BYTES);
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    MonotonicArena(MonotonicArena&&) = default;
+    MonotonicArena& operator=(MonotonicArena&&) = default;
+
+    /**
+     * @brief Cấp phát một vùng nhớ trong arena.
+     * @param bytes Số byte cần cấp phát.
+     * @param alignment Căn lề (lũy thừa của 2).
+     * @return Con trỏ tới vùng nhớ (không được giải phóng riêng).
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Sao chép một chuỗi vào arena.
+     * @param text Chuỗi cần sao chép.
+     * @return string_view trỏ vào bản sao trong arena.
+     */
+    std::string_view copy(std::string_view text);
+
+    /**
+     * @brief Thu hồi toàn bộ dữ liệu đã cấp phát nhưng giữ lại bộ nhớ để dùng lại:
+     * nếu đang có nhiều khối thì chúng được thay bằng một khối duy nhất có tổng kích thước.
+     */
+    void reset();
+
+    /**
+     * @brief Thu hồi dữ liệu và trả toàn bộ bộ nhớ về hệ thống.
+     */
+    void release();
+
+    /** @brief Số byte đã cấp phát (kể cả phần đệm căn lề) kể từ lần reset() gần nhất. */
+    std::size_t bytesUsed() const { return _used; }
+
+    /** @brief Tổng kích thước các khối đang giữ. */
+    std::size_t bytesReserved() const { return _reserved; }
+
+    /** @brief Số khối đang giữ. */
+    std::size_t blockCount() const { return _blocks.size(); }
+
+private:
+    /**
+     * @struct Block
+     * @brief Một khối nhớ liên tiếp của arena.
+     */
+    struct Block {
+        std::unique_ptr<char[]> data; ///< @brief Vùng nhớ của khối.
+        std::size_t size = 0;         ///< @brief Kích thước khối.
+    };
+
+    std::vector<Block> _blocks;    ///< @brief Các khối theo thứ tự cấp phát; khối cuối là khối đang dùng.
+    std::size_t _offset = 0;       ///< @brief Vị trí trống đầu tiên trong khối đang dùng.
+    std::size_t _used = 0;         ///< @brief Số byte đã cấp phát.
+    std::size_t _reserved = 0;     ///< @brief Tổng kích thước các khối.
+    std::size_t _nextBlockBytes;   ///< @brief Kích thước khối tiếp theo khi cần tăng.
+
+    /**
+     * @brief Thêm một khối mới đủ chứa `minBytes` byte.
+     */
+    void addBlock(std::size_t minBytes);
+};
+
+#endif // MONOTONIC_ARENA_H
@@ -3,6 +3,7 @@
 #include <iomanip>
 #include <cmath> // Để dùng std::abs
 #include <algorithm> // Để dùng std::reverse
+#include <cstdint>
 
 /**
  * @brief Định dạng một số kiểu int.
@@ -11,6 +12,30 @@ std::string NumberFormatter::format(int number, const CultureInfo& culture) cons
     return format(static_cast<double>(number), culture);
 }
 
+/**
+ * @brief Định dạng một số tiền (số nguyên đồng).
+ */
+std::string NumberFormatter::format(Money amount, const CultureInfo& culture) const {
+    const std::int64_t dong = amount.dong();
+    // Lấy trị tuyệt đối ở dạng không dấu để không tràn số với giá trị nhỏ nhất của int64
+    const std::uint64_t magnitude = dong < 0 ? 0 - static_cast<std::uint64_t>(dong) : static_cast<std::uint64_t>(dong);
+    std::string numStr = std::to_string(magnitude);
+
+    // Chèn dấu phân cách hàng nghìn
+    int insertPosition = static_cast<int>(numStr.length()) - 3;
+    while (insertPosition > 0) {
+        numStr.insert(insertPosition, 1, culture.thousandSeparator);
+        insertPosition -= 3;
+    }
+
+    // Thêm dấu âm nếu số là số âm
+    if (dong < 0) {
+        numStr.insert(0, "-");
+    }
+
+    return numStr;
+}
+
 /**
  * @brief Định dạng một số kiểu double.
  */
@@ -2,6 +2,7 @@
 #define NUMBERFORMATTER_H
 
 #include "CultureInfo.h"
+#include "Money.h"
 #include <string>
 
 /**
@@ -25,6 +26,15 @@ public:
      * @return Chuỗi đã được định dạng.
      */
     std::string format(int number, const CultureInfo& culture) const;
+
+    /**
+     * @brief Định dạng một số tiền (số nguyên đồng) thành chuỗi.
+     * Không đi qua số thực nên không làm tròn thêm lần nào: chuỗi in ra đúng bằng số đồng.
+     * @param amount Số tiền cần định dạng.
+     * @param culture Thông tin văn hóa để sử dụng.
+     * @return Chuỗi đã được định dạng.
+     */
+    std::string format(Money amount, const CultureInfo& culture) const;
 };
 
 #endif // NUMBER_FORMATTER_H
\ No newline at end of file
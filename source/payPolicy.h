@@ -0,0 +1,127 @@
+﻿#ifndef PAY_POLICY_H
+#define PAY_POLICY_H
+
+#include "GlobalDefinitions.h"
+#include "FulltimeEmployee.h"
+#include "contractualemployee.h"
+#include "Intern.h"
+#include "PayRateTable.h"
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+/**
+ * @file PayPolicy.h
+ * @brief Các chính sách lương biên dịch sẵn (constexpr), mỗi nhóm nhân viên một chính sách.
+ *
+ * Mỗi chính sách là một kiểu rỗng khai báo:
+ * - `Employee`: lớp nhân viên của nhóm (lớp `final`, nên lời gọi hàm qua nó không cần bảng ảo);
+ * - `CATEGORY`: nhóm EmployeeCategory tương ứng;
+ * - `DEFAULT_HOURLY_RATE`, `DEFAULT_OVERTIME_RATE`, `DEFAULT_HOLIDAY_RATE`: đơn giá mặc định mỗi giờ
+ *   (đồng); đơn giá thực tế lấy từ PayRateTable (file cấu hình `pay_rates.txt`);
+ * - `PAYS_HOURS`: true nếu lương ròng = lương cơ bản + lương theo giờ công, false nếu nhân viên
+ *   chỉ nhận khoản cố định (hiển thị ở cột lương làm việc);
+ * - `basePay(employee)`: lương cơ bản/khoản cố định của nhân viên.
+ * Thêm một nhóm nhân viên: thêm giá trị vào EmployeeCategory, định nghĩa chính sách mới và
+ * thêm nó vào PayPolicies (đúng vị trí của nhóm); static_assert bên dưới kiểm tra điều này.
+ */
+
+/**
+ * @struct FulltimePayPolicy
+ * @brief Nhân viên chính thức: lương cơ bản + lương theo giờ công (mặc định giờ thường 23.800 đ, tăng ca 1,5 lần, ngày lễ 3 lần).
+ */
+struct FulltimePayPolicy {
+    using Employee = FulltimeEmployee;
+    static constexpr EmployeeCategory CATEGORY = EmployeeCategory::Fulltime;
+    static constexpr Money DEFAULT_HOURLY_RATE = Money::fromDong(23800);
+    static constexpr Money DEFAULT_OVERTIME_RATE = Money::fromDong(23800 * 3 / 2);
+    static constexpr Money DEFAULT_HOLIDAY_RATE = Money::fromDong(23800 * 3);
+    static constexpr bool PAYS_HOURS = true;
+    static Money basePay(const Employee& employee) { return Money::fromDouble(employee.getBaseSalary()); }
+};
+
+/**
+ * @struct ContractualPayPolicy
+ * @brief Nhân viên hợp đồng: lương hợp đồng + lương theo giờ công (mặc định giờ thường 23.800 đ; tăng ca và ngày lễ không được trả thêm).
+ */
+struct ContractualPayPolicy {
+    using Employee = ContractualEmployee;
+    static constexpr EmployeeCategory CATEGORY = EmployeeCategory::Contractual;
+    static constexpr Money DEFAULT_HOURLY_RATE = Money::fromDong(23800);
+    static constexpr Money DEFAULT_OVERTIME_RATE = Money::fromDong(0);
+    static constexpr Money DEFAULT_HOLIDAY_RATE = Money::fromDong(0);
+    static constexpr bool PAYS_HOURS = true;
+    static Money basePay(const Employee& employee) { return Money::fromDouble(employee.getBaseSalary()); }
+};
+
+/**
+ * @struct InternPayPolicy
+ * @brief Thực tập sinh: chỉ nhận trợ cấp cố định, không tính theo giờ công.
+ */
+struct InternPayPolicy {
+    using Employee = Intern;
+    static constexpr EmployeeCategory CATEGORY = EmployeeCategory::Intern;
+    static constexpr Money DEFAULT_HOURLY_RATE = Money::fromDong(0);
+    static constexpr Money DEFAULT_OVERTIME_RATE = Money::fromDong(0);
+    static constexpr Money DEFAULT_HOLIDAY_RATE = Money::fromDong(0);
+    static constexpr bool PAYS_HOURS = false;
+    static Money basePay(const Employee& employee) { return Money::fromDouble(employee.getBaseSalary()); }
+};
+
+/**
+ * @brief Danh sách chính sách, phần tử thứ k là chính sách của nhóm EmployeeCategory có giá trị k.
+ */
+using PayPolicies = std::tuple<FulltimePayPolicy, ContractualPayPolicy, InternPayPolicy>;
+
+/**
+ * @brief Kiểm tra (lúc biên dịch) phần tử thứ k của PayPolicies ứng với nhóm k.
+ */
+template <std::size_t... Index>
+constexpr bool payPoliciesMatchCategories(std::index_sequence<Index...>) {
+    return ((std::tuple_element_t<Index, PayPolicies>::CATEGORY == static_cast<EmployeeCategory>(Index)) && ...);
+}
+
+static_assert(std::tuple_size_v<PayPolicies> == static_cast<std::size_t>(EmployeeCategory::Count)
+              && payPoliciesMatchCategories(std::make_index_sequence<std::tuple_size_v<PayPolicies>>()),
+              "Moi EmployeeCategory phai co dung mot chinh sach luong trong PayPolicies, theo dung thu tu");
+
+/**
+ * @brief Tính lương theo một chính sách (được biên dịch riêng và inline cho từng chính sách).
+ * Mỗi phần lương theo giờ được làm tròn tới đồng (Money::forSeconds); lương ròng là tổng chính xác.
+ * @tparam Policy Chính sách lương.
+ * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+ * @param rates Đơn giá của nhóm (PayRateTable::active().of(Policy::CATEGORY)).
+ * @param basePay Lương cơ bản/khoản cố định (Policy::basePay()).
+ * @param bonuses Tổng thưởng.
+ * @param allowances Tổng phụ cấp.
+ * @param deductions Tổng khấu trừ.
+ * @return Chi tiết lương.
+ */
+template <class Policy>
+inline SalaryDetails calculatePay(const AttendanceSummary& summary, const CategoryPayRates& rates, Money basePay, Money bonuses, Money allowances, Money deductions) {
+    SalaryDetails details;
+    if constexpr (Policy::PAYS_HOURS) {
+        details.basicSalary = Money::forSeconds(summary.paidNormalSeconds, rates.hourlyRate);
+        details.overtimeSalary = Money::forSeconds(summary.paidOvertimeSeconds, rates.overtimeRate);
+        details.holidaySalary = Money::forSeconds(summary.paidHolidaySeconds, rates.holidayRate);
+    } else {
+        details.basicSalary = basePay; // Khoản cố định được hiển thị ở cột lương làm việc
+        basePay = Money();
+    }
+    details.bonuses = bonuses;
+    details.allowances = allowances;
+    details.deductions = deductions;
+    details.totalSalary = basePay + details.basicSalary + details.overtimeSalary + details.holidaySalary
+                        + details.bonuses + details.allowances - details.deductions;
+    return details;
+}
+
+/**
+ * @brief Gọi `visitor(Policy{})` cho từng chính sách trong PayPolicies (mở rộng lúc biên dịch).
+ */
+template <class Visitor>
+inline void forEachPayPolicy(Visitor&& visitor) {
+    std::apply([&visitor](auto... policy) { (visitor(policy), ...); }, PayPolicies{});
+}
+
+#endif // PAY_POLICY_H
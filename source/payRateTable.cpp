@@ -0,0 +1,151 @@
+﻿#include "PayRateTable.h"
+#include "PayPolicy.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+    /** @brief Tên nhóm nhân viên trong file cấu hình, theo thứ tự EmployeeCategory. */
+    const char* const CATEGORY_KEYS[PAY_CATEGORY_COUNT] = { "fulltime", "contractual", "intern" };
+
+    /**
+     * @struct RawRates
+     * @brief Đơn giá của một nhóm như được ghi trong file (đơn giá giờ thường và các hệ số), trước khi quy đổi.
+     */
+    struct RawRates {
+        double hourlyRate = 0.0;
+        double overtimeMultiplier = 0.0;
+        double holidayMultiplier = 0.0;
+    };
+
+    /**
+     * @brief Cắt khoảng trắng ở hai đầu chuỗi.
+     */
+    std::string trim(const std::string& text) {
+        const std::size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return std::string();
+        const std::size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    /**
+     * @brief Áp một tham số `key=value` vào bảng đang đọc.
+     * @return false nếu tên tham số không hợp lệ.
+     */
+    bool applyParameter(std::array<RawRates, PAY_CATEGORY_COUNT>& rates, PayRateTable& table, const std::string& key, double value) {
+        if (key == "insurance") { table.socialInsuranceRate = value; return true; }
+        if (key == "bonus") { table.revenueBonus = value; return true; }
+        if (key == "km") { table.transportRatePerKm = value; return true; }
+
+        const std::size_t dot = key.find('.');
+        if (dot == std::string::npos) return false;
+        for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+            if (key.compare(0, dot, CATEGORY_KEYS[c]) != 0) continue;
+            const std::string name = key.substr(dot + 1);
+            if (name == "hourly") rates[c].hourlyRate = value;
+            else if (name == "overtime") rates[c].overtimeMultiplier = value;
+            else if (name == "holiday") rates[c].holidayMultiplier = value;
+            else return false;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Bảng đơn giá đang áp dụng.
+     */
+    PayRateTable& activeTable() {
+        static PayRateTable table = PayRateTable::defaults();
+        return table;
+    }
+
+} // namespace
+
+/**
+ * @brief Bảng đơn giá mặc định: đơn giá của các PayPolicy, BHXH 10,5%, thưởng 2 triệu, phụ cấp 4000 đ/km.
+ */
+PayRateTable PayRateTable::defaults() {
+    PayRateTable table;
+    forEachPayPolicy([&](auto policy) {
+        using Policy = decltype(policy);
+        CategoryPayRates& rates = table.categories[static_cast<std::size_t>(Policy::CATEGORY)];
+        rates.hourlyRate = Policy::DEFAULT_HOURLY_RATE;
+        rates.overtimeRate = Policy::DEFAULT_OVERTIME_RATE;
+        rates.holidayRate = Policy::DEFAULT_HOLIDAY_RATE;
+    });
+    table.socialInsuranceRate = 0.105;
+    table.revenueBonus = 2000000.0;
+    table.transportRatePerKm = 4000.0;
+    return table;
+}
+
+/**
+ * @brief Đọc bảng đơn giá từ file văn bản.
+ */
+bool PayRateTable::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    // Đọc theo đơn giá và hệ số (thứ tự các dòng không quan trọng), quy đổi một lần ở cuối
+    std::array<RawRates, PAY_CATEGORY_COUNT> rates;
+    for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+        rates[c].hourlyRate = categories[c].hourlyRate.toDouble();
+        if (categories[c].hourlyRate > Money()) {
+            rates[c].overtimeMultiplier = categories[c].overtimeRate.toDouble() / rates[c].hourlyRate;
+            rates[c].holidayMultiplier = categories[c].holidayRate.toDouble() / rates[c].hourlyRate;
+        }
+    }
+
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        const std::size_t equals = line.find('=');
+        bool valid = equals != std::string::npos;
+        if (valid) {
+            const std::string key = trim(line.substr(0, equals));
+            const std::string text = trim(line.substr(equals + 1));
+            char* end = nullptr;
+            const double value = std::strtod(text.c_str(), &end);
+            valid = !text.empty() && *end == '\0' && std::isfinite(value) && value >= 0.0
+                 && applyParameter(rates, *this, key, value);
+        }
+        if (!valid) {
+            std::cerr << "CANH BAO: " << filename << " dong " << lineNumber << ": tham so khong hop le '"
+                      << line << "', bo qua dong." << std::endl;
+        }
+    }
+
+    for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+        categories[c].hourlyRate = Money::fromDouble(rates[c].hourlyRate);
+        categories[c].overtimeRate = Money::fromDouble(rates[c].hourlyRate * rates[c].overtimeMultiplier);
+        categories[c].holidayRate = Money::fromDouble(rates[c].hourlyRate * rates[c].holidayMultiplier);
+    }
+    return true;
+}
+
+/**
+ * @brief Bảng đơn giá đang áp dụng.
+ */
+const PayRateTable& PayRateTable::active() {
+    return activeTable();
+}
+
+/**
+ * @brief Thay bảng đơn giá đang áp dụng.
+ */
+void PayRateTable::setActive(const PayRateTable& table) {
+    activeTable() = table;
+}
+
+/**
+ * @brief Tên nhóm nhân viên dùng trong file cấu hình.
+ */
+const char* PayRateTable::categoryKey(std::size_t category) {
+    return category < PAY_CATEGORY_COUNT ? CATEGORY_KEYS[category] : "";
+}
@@ -0,0 +1,92 @@
+﻿#ifndef PAY_RATE_TABLE_H
+#define PAY_RATE_TABLE_H
+
+#include "GlobalDefinitions.h"
+#include <array>
+#include <cstddef>
+#include <string>
+
+/**
+ * @file PayRateTable.h
+ * @brief Định nghĩa bảng đơn giá lương PayRateTable, đọc từ file cấu hình và tra cứu O(1) theo nhóm nhân viên.
+ */
+
+/**
+ * @struct CategoryPayRates
+ * @brief Đơn giá mỗi giờ (đã làm tròn tới đồng) của một nhóm nhân viên.
+ */
+struct CategoryPayRates {
+    Money hourlyRate;   ///< @brief Đơn giá giờ thường.
+    Money overtimeRate; ///< @brief Đơn giá giờ tăng ca (0 = không trả).
+    Money holidayRate;  ///< @brief Đơn giá giờ ngày lễ (0 = không trả).
+
+    bool operator==(const CategoryPayRates& other) const {
+        return hourlyRate == other.hourlyRate && overtimeRate == other.overtimeRate && holidayRate == other.holidayRate;
+    }
+};
+
+/**
+ * @struct PayRateTable
+ * @brief Các tham số lương của cả hệ thống: đơn giá theo nhóm nhân viên và tham số của các phúc lợi chuẩn.
+ *
+ * File cấu hình (mặc định DEFAULT_FILE) được đọc và quy đổi một lần thành khối tham số phẳng này:
+ * đơn giá tăng ca/ngày lễ được tính sẵn từ hệ số, mỗi nhóm một phần tử của mảng theo EmployeeCategory.
+ * Khi tính lương chỉ cần `active().of(category)` (một phép đánh chỉ số), không tra chuỗi.
+ * Các giá trị mặc định (defaults()) là các hằng số của PayPolicy.h và các phúc lợi mặc định.
+ */
+struct PayRateTable {
+    std::array<CategoryPayRates, PAY_CATEGORY_COUNT> categories; ///< @brief Đơn giá theo EmployeeCategory.
+    double socialInsuranceRate = 0.0; ///< @brief Tỷ lệ đóng BHXH của nhân viên (SocialInsuranceWelfare).
+    double revenueBonus = 0.0;        ///< @brief Tiền thưởng doanh thu (BonusWelfare).
+    double transportRatePerKm = 0.0;  ///< @brief Phụ cấp đi lại mỗi km (TransportationWelfare).
+
+    /** @brief Tên file bảng đơn giá mặc định. */
+    static constexpr const char* DEFAULT_FILE = "pay_rates.txt";
+
+    /**
+     * @brief Đơn giá của một nhóm nhân viên.
+     * @param category Nhóm nhân viên (phải nhỏ hơn EmployeeCategory::Count).
+     */
+    const CategoryPayRates& of(EmployeeCategory category) const { return categories[static_cast<std::size_t>(category)]; }
+
+    /**
+     * @brief Đọc bảng đơn giá từ file văn bản, mỗi dòng một tham số `ten_tham_so=gia_tri`:
+     * - `<nhom>.hourly` (đồng/giờ), `<nhom>.overtime`, `<nhom>.holiday` (hệ số so với giờ thường),
+     *   với `<nhom>` là `fulltime`, `contractual` hoặc `intern`;
+     * - `insurance` (tỷ lệ BHXH), `bonus` (đồng), `km` (đồng/km).
+     * Tham số không ghi giữ nguyên giá trị hiện có của bảng. Dòng trống và dòng bắt đầu bằng '#'
+     * được bỏ qua; dòng lỗi được cảnh báo và bỏ qua. Đơn giá mỗi giờ được làm tròn tới đồng.
+     * @param filename Tên file.
+     * @return false nếu không mở được file (bảng không thay đổi).
+     */
+    bool loadFromFile(const std::string& filename);
+
+    /**
+     * @brief Bảng đơn giá mặc định (hằng số biên dịch sẵn).
+     */
+    static PayRateTable defaults();
+
+    /**
+     * @brief Bảng đơn giá đang áp dụng cho mọi phép tính lương (ban đầu là defaults()).
+     */
+    static const PayRateTable& active();
+
+    /**
+     * @brief Thay bảng đơn giá đang áp dụng. Không gọi trong khi đang tính lương.
+     */
+    static void setActive(const PayRateTable& table);
+
+    /**
+     * @brief Tên nhóm nhân viên dùng trong file cấu hình và file kịch bản ("fulltime", "contractual", "intern").
+     * @param category Chỉ số nhóm (nhỏ hơn PAY_CATEGORY_COUNT).
+     */
+    static const char* categoryKey(std::size_t category);
+
+    bool operator==(const PayRateTable& other) const {
+        return categories == other.categories && socialInsuranceRate == other.socialInsuranceRate
+            && revenueBonus == other.revenueBonus && transportRatePerKm == other.transportRatePerKm;
+    }
+    bool operator!=(const PayRateTable& other) const { return !(*this == other); }
+};
+
+#endif // PAY_RATE_TABLE_H
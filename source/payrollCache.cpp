@@ -0,0 +1,96 @@
+﻿#include "PayrollCache.h"
+#include "AttendanceParser.h"
+
+/**
+ * @brief Tìm kết quả còn hiệu lực.
+ */
+const SalaryDetails* PayrollCache::find(const std::string& employeeId, int month, int year) {
+    auto employee = _employees.find(employeeId);
+    if (employee != _employees.end()) {
+        const EmployeeState& state = employee->second;
+        auto entry = state.periods.find(AttendanceParser::periodOf(year, month));
+        if (entry != state.periods.end() && entry->second.attendanceVersion >= _attendanceValidFrom
+            && entry->second.employeeVersion == state.version) {
+            ++_hits;
+            return &entry->second.details;
+        }
+    }
+    ++_misses;
+    return nullptr;
+}
+
+/**
+ * @brief Lưu kết quả vừa tính.
+ */
+void PayrollCache::store(const std::string& employeeId, int month, int year, const SalaryDetails& details) {
+    EmployeeState& state = _employees[employeeId];
+    Entry& entry = state.periods[AttendanceParser::periodOf(year, month)];
+    entry.details = details;
+    entry.attendanceVersion = _attendanceVersion;
+    entry.employeeVersion = state.version;
+}
+
+/**
+ * @brief Đồng bộ với phiên bản dữ liệu chấm công.
+ */
+void PayrollCache::syncAttendanceVersion(std::uint64_t version) {
+    if (version == _attendanceVersion) return;
+    _attendanceVersion = version;
+    _attendanceValidFrom = version;
+}
+
+/**
+ * @brief Chấp nhận phiên bản dữ liệu chấm công mới, giữ hiệu lực các kết quả cũ.
+ */
+void PayrollCache::acceptAttendanceVersion(std::uint64_t version) {
+    _attendanceVersion = version;
+}
+
+/**
+ * @brief Đồng bộ dấu vân tay hồ sơ của một nhân viên.
+ */
+void PayrollCache::syncEmployee(const std::string& employeeId, std::uint64_t fingerprint) {
+    EmployeeState& state = _employees[employeeId];
+    if (state.hasFingerprint && state.fingerprint == fingerprint) return;
+    ++state.version; // Hồ sơ mới, đã đổi, hoặc đã bị sửa trong bộ nhớ kể từ lần đồng bộ trước
+    state.fingerprint = fingerprint;
+    state.hasFingerprint = true;
+}
+
+/**
+ * @brief Làm mọi kết quả của một nhân viên hết hiệu lực.
+ */
+void PayrollCache::invalidateEmployee(const std::string& employeeId) {
+    auto employee = _employees.find(employeeId);
+    if (employee == _employees.end()) return;
+    ++employee->second.version;
+    // Kết quả tính sau khi sửa không ứng với dấu vân tay cũ: lần tải lại sau luôn tăng phiên bản
+    employee->second.hasFingerprint = false;
+}
+
+/**
+ * @brief Xóa kết quả của một nhân viên trong một kỳ lương.
+ */
+void PayrollCache::invalidatePeriod(const std::string& employeeId, int month, int year) {
+    auto employee = _employees.find(employeeId);
+    if (employee == _employees.end()) return;
+    employee->second.periods.erase(AttendanceParser::periodOf(year, month));
+}
+
+/**
+ * @brief Xóa toàn bộ kết quả.
+ */
+void PayrollCache::clear() {
+    _employees.clear();
+}
+
+/**
+ * @brief Lấy số liệu thống kê.
+ */
+PayrollCacheStats PayrollCache::getStats() const {
+    PayrollCacheStats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    for (const auto& employee : _employees) stats.entries += employee.second.periods.size();
+    return stats;
+}
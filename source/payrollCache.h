@@ -0,0 +1,129 @@
+﻿#ifndef PAYROLL_CACHE_H
+#define PAYROLL_CACHE_H
+
+#include "GlobalDefinitions.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @file PayrollCache.h
+ * @brief Định nghĩa lớp PayrollCache, bộ nhớ đệm kết quả tính lương theo (nhân viên, kỳ lương).
+ */
+
+/**
+ * @struct PayrollCacheStats
+ * @brief Số liệu thống kê của bộ nhớ đệm bảng lương.
+ */
+struct PayrollCacheStats {
+    std::size_t hits = 0;    ///< @brief Số lần kết quả được dùng lại.
+    std::size_t misses = 0;  ///< @brief Số lần phải tính lại (chưa có hoặc đã cũ).
+    std::size_t entries = 0; ///< @brief Số kết quả đang lưu (kể cả kết quả đã cũ chưa bị ghi đè).
+};
+
+/**
+ * @class PayrollCache
+ * @brief Lưu chi tiết lương đã tính theo khóa (mã nhân viên, tháng, năm), kèm hai "tem" phiên bản:
+ * phiên bản dữ liệu chấm công (AttendanceManager::getDataVersion()) và phiên bản hồ sơ nhân viên.
+ *
+ * Một kết quả chỉ được dùng lại khi cả hai tem còn hiệu lực:
+ * - Dữ liệu chấm công thay đổi (syncAttendanceVersion() với phiên bản mới) làm mọi kết quả tính
+ *   trước đó hết hiệu lực. Nếu nơi gọi biết chính xác kỳ lương nào bị ảnh hưởng (ví dụ thêm một bản
+ *   ghi), nó xóa riêng kết quả đó bằng invalidatePeriod() rồi gọi acceptAttendanceVersion().
+ * - Phiên bản hồ sơ của một nhân viên tăng khi hồ sơ được sửa (invalidateEmployee()) hoặc khi hồ sơ
+ *   tải lại có dấu vân tay khác lần trước (syncEmployee()); chỉ kết quả của nhân viên đó hết hiệu lực.
+ * Kết quả hết hiệu lực không bị xóa ngay mà bị ghi đè ở lần store() tiếp theo.
+ */
+class PayrollCache {
+public:
+    /**
+     * @brief Tìm kết quả còn hiệu lực và cập nhật bộ đếm trúng/trượt.
+     * @param employeeId Mã nhân viên.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @return Con trỏ tới chi tiết lương (hợp lệ tới lần sửa đổi bộ nhớ đệm tiếp theo), nullptr nếu phải tính lại.
+     */
+    const SalaryDetails* find(const std::string& employeeId, int month, int year);
+
+    /**
+     * @brief Lưu kết quả vừa tính, đóng tem bằng phiên bản dữ liệu chấm công và hồ sơ hiện tại.
+     */
+    void store(const std::string& employeeId, int month, int year, const SalaryDetails& details);
+
+    /**
+     * @brief Đồng bộ với phiên bản dữ liệu chấm công; phiên bản khác lần trước làm mọi kết quả hết hiệu lực.
+     * @param version Phiên bản hiện tại (AttendanceManager::getDataVersion()).
+     */
+    void syncAttendanceVersion(std::uint64_t version);
+
+    /**
+     * @brief Chấp nhận phiên bản dữ liệu chấm công mới mà không làm các kết quả cũ hết hiệu lực
+     * (nơi gọi đã tự xóa các kết quả bị ảnh hưởng bằng invalidatePeriod()).
+     * @param version Phiên bản mới.
+     */
+    void acceptAttendanceVersion(std::uint64_t version);
+
+    /**
+     * @brief Phiên bản dữ liệu chấm công mà bộ nhớ đệm đang đồng bộ.
+     */
+    std::uint64_t getAttendanceVersion() const { return _attendanceVersion; }
+
+    /**
+     * @brief Ghi nhận dấu vân tay hồ sơ của một nhân viên vừa được tải/thêm; nếu khác lần trước thì
+     * các kết quả của nhân viên đó hết hiệu lực.
+     * @param employeeId Mã nhân viên.
+     * @param fingerprint Dấu vân tay của các trường hồ sơ ảnh hưởng tới lương.
+     */
+    void syncEmployee(const std::string& employeeId, std::uint64_t fingerprint);
+
+    /**
+     * @brief Làm mọi kết quả của một nhân viên hết hiệu lực (sau khi sửa hồ sơ).
+     */
+    void invalidateEmployee(const std::string& employeeId);
+
+    /**
+     * @brief Xóa kết quả của một nhân viên trong một kỳ lương.
+     */
+    void invalidatePeriod(const std::string& employeeId, int month, int year);
+
+    /**
+     * @brief Xóa toàn bộ kết quả (giữ bộ đếm).
+     */
+    void clear();
+
+    /**
+     * @brief Lấy số liệu thống kê (trúng, trượt, số kết quả đang lưu).
+     */
+    PayrollCacheStats getStats() const;
+
+private:
+    /**
+     * @struct Entry
+     * @brief Một kết quả đã tính và các tem phiên bản của nó.
+     */
+    struct Entry {
+        SalaryDetails details;
+        std::uint64_t attendanceVersion = 0; ///< @brief Phiên bản dữ liệu chấm công lúc tính.
+        std::uint64_t employeeVersion = 0;   ///< @brief Phiên bản hồ sơ nhân viên lúc tính.
+    };
+
+    /**
+     * @struct EmployeeState
+     * @brief Phiên bản hồ sơ và các kết quả (theo mã kỳ lương) của một nhân viên.
+     */
+    struct EmployeeState {
+        std::uint64_t version = 0;     ///< @brief Phiên bản hồ sơ hiện tại.
+        std::uint64_t fingerprint = 0; ///< @brief Dấu vân tay hồ sơ lần đồng bộ gần nhất.
+        bool hasFingerprint = false;   ///< @brief Đã từng đồng bộ dấu vân tay hay chưa.
+        std::unordered_map<std::int32_t, Entry> periods;
+    };
+
+    std::unordered_map<std::string, EmployeeState> _employees;
+    std::uint64_t _attendanceVersion = 0;   ///< @brief Phiên bản dữ liệu chấm công hiện tại.
+    std::uint64_t _attendanceValidFrom = 0; ///< @brief Kết quả có tem chấm công nhỏ hơn giá trị này đã hết hiệu lực.
+    std::size_t _hits = 0;
+    std::size_t _misses = 0;
+};
+
+#endif // PAYROLL_CACHE_H
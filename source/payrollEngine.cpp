@@ -0,0 +1,146 @@
+﻿#include "PayrollEngine.h"
+#include "AttendanceManager.h"
+#include "IEmployee.h"
+#include "PayPolicy.h"
+#include "WelfareManager.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * @brief Tính lương của mọi nhân viên trong một kỳ lương.
+ */
+void PayrollEngine::calculateAll(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+                                 const WelfareManager& welfareManager, int month, int year, std::vector<PayrollEntry>& payrollData) {
+    // 1. Một lần quét dữ liệu chấm công của kỳ: số liệu tổng hợp của mọi nhân viên
+    attendance.summarizePeriod(month, year, _summaries);
+
+    // 2-4. Phúc lợi và lương của từng nhân viên, theo nhóm tính lương
+    const bool parallel = prepare(employees, attendance.getEmployeeIds());
+    _details.assign(employees.size(), SalaryDetails());
+    calculateGroups(employees, _summaries.data(), 0, 1, welfareManager, _details.data(), parallel);
+
+    // 5. Bảng lương theo đúng thứ tự danh sách nhân viên, bỏ các con trỏ null
+    payrollData.clear();
+    payrollData.reserve(employees.size());
+    for (std::size_t i = 0; i < employees.size(); ++i) {
+        if (employees[i]) payrollData.emplace_back(employees[i], _details[i]);
+    }
+}
+
+/**
+ * @brief Tính bảng lương 12 tháng của mọi nhân viên trong một năm.
+ */
+void PayrollEngine::calculateYear(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+                                  const WelfareManager& welfareManager, int year, PayrollYear& result) {
+    // 1. Một lần duyệt số liệu chấm công của cả năm: ma trận tháng x khóa nhân viên
+    attendance.summarizeYear(year, _summaries);
+    const std::size_t keyCount = attendance.getEmployeeIds().size();
+
+    result.year = year;
+    result.employees.clear();
+    for (const auto& emp : employees) {
+        if (emp) result.employees.push_back(emp);
+    }
+    result.cells.assign(result.employees.size() * PayrollYear::MONTHS, SalaryDetails());
+
+    // 2. Khóa nhân viên và nhóm tính lương chỉ được xác định một lần cho cả năm
+    const bool parallel = prepare(result.employees, attendance.getEmployeeIds());
+
+    // 3. Mỗi nhân viên được tính liền 12 tháng vào hàng của mình: đối tượng nhân viên và tác động
+    //    phúc lợi (không phụ thuộc tháng) được dùng lại cho cả 12 ô
+    calculateGroups(result.employees, _summaries.data(), keyCount, PayrollYear::MONTHS, welfareManager,
+                    result.cells.data(), parallel);
+}
+
+/**
+ * @brief Tra khóa chấm công, gom nhân viên theo nhóm tính lương và chuẩn bị nhóm luồng.
+ */
+bool PayrollEngine::prepare(const std::vector<std::shared_ptr<IEmployee>>& employees, const EmployeeIdPool& ids) {
+    _keys.assign(employees.size(), EmployeeIdPool::npos);
+    for (auto& group : _groups) group.clear();
+    for (std::size_t i = 0; i < employees.size(); ++i) {
+        if (!employees[i]) continue;
+        _keys[i] = ids.find(employees[i]->getEmployeeId());
+        // Giữ nguyên thứ tự danh sách trong mỗi nhóm
+        const std::size_t category = static_cast<std::size_t>(employees[i]->getCategory());
+        _groups[(std::min)(category, OTHER_GROUP)].push_back(static_cast<std::uint32_t>(i));
+    }
+
+    const unsigned threads = ThreadPool::resolveThreadCount(_threadCount);
+    const bool parallel = threads > 1 && employees.size() >= PARALLEL_MIN_EMPLOYEES;
+    if (parallel && (!_pool || _pool->size() != threads)) {
+        _pool.reset(); // Dừng nhóm luồng cũ trước khi tạo nhóm mới
+        _pool = std::make_unique<ThreadPool>(threads);
+    }
+    return parallel;
+}
+
+/**
+ * @brief Tính phúc lợi và lương của mọi nhân viên đã được gom nhóm.
+ */
+void PayrollEngine::calculateGroups(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceSummary* summaries,
+                                    std::size_t summaryStride, std::size_t months, const WelfareManager& welfareManager,
+                                    SalaryDetails* out, bool parallel) {
+    const AttendanceSummary empty;
+    auto summaryOf = [&](std::uint32_t i, std::size_t m) -> const AttendanceSummary& {
+        return (_keys[i] != EmployeeIdPool::npos) ? summaries[m * summaryStride + _keys[i]] : empty;
+    };
+
+    // Mỗi nhân viên chỉ ghi vào phần tử của mình nên các đoạn của một nhóm có thể chạy song song
+    auto runGroup = [&](const std::vector<std::uint32_t>& group, const std::function<void(std::size_t, std::size_t)>& calculateRange) {
+        if (parallel && group.size() > PARALLEL_GRAIN) {
+            _pool->parallelFor(group.size(), PARALLEL_GRAIN, calculateRange);
+        } else {
+            calculateRange(0, group.size());
+        }
+    };
+
+    // Mỗi nhóm có chính sách: vòng lặp riêng cho đúng lớp nhân viên, lương tính bằng calculatePay<Policy>
+    // với đơn giá của nhóm lấy một lần từ bảng đơn giá đang áp dụng
+    const PayRateTable& payRates = PayRateTable::active();
+    forEachPayPolicy([&](auto policy) {
+        using Policy = decltype(policy);
+        using Employee = typename Policy::Employee;
+        const auto& group = _groups[static_cast<std::size_t>(Policy::CATEGORY)];
+        const CategoryPayRates& rates = payRates.of(Policy::CATEGORY);
+        runGroup(group, [&](std::size_t begin, std::size_t end) {
+            WelfareImpactCache impacts;
+            for (std::size_t n = begin; n < end; ++n) {
+                const std::uint32_t i = group[n];
+                const Employee& emp = static_cast<const Employee&>(*employees[i]);
+                const Money basePay = Policy::basePay(emp);
+                welfareManager.resetImpactCache(impacts);
+                for (std::size_t m = 0; m < months; ++m) {
+                    const AttendanceSummary& summary = summaryOf(i, m);
+                    Money bonuses, allowances, deductions;
+                    welfareManager.calculateAllWelfareForEmployee(emp, summary, impacts, bonuses, allowances, deductions);
+                    out[i * months + m] = calculatePay<Policy>(summary, rates, basePay, bonuses, allowances, deductions);
+                }
+            }
+        });
+    });
+
+    // Nhóm không có chính sách: tính qua hàm ảo
+    const auto& others = _groups[OTHER_GROUP];
+    runGroup(others, [&](std::size_t begin, std::size_t end) {
+        WelfareImpactCache impacts;
+        for (std::size_t n = begin; n < end; ++n) {
+            const std::uint32_t i = others[n];
+            const IEmployee& emp = *employees[i];
+            welfareManager.resetImpactCache(impacts);
+            for (std::size_t m = 0; m < months; ++m) {
+                const AttendanceSummary& summary = summaryOf(i, m);
+                Money bonuses, allowances, deductions;
+                welfareManager.calculateAllWelfareForEmployee(emp, summary, impacts, bonuses, allowances, deductions);
+                out[i * months + m] = emp.calculateSalary(summary, bonuses, allowances, deductions);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Đặt số luồng dùng để tính lương.
+ */
+void PayrollEngine::setThreadCount(unsigned threadCount) {
+    _threadCount = threadCount;
+}
@@ -0,0 +1,144 @@
+﻿#ifndef PAYROLL_ENGINE_H
+#define PAYROLL_ENGINE_H
+
+#include "GlobalDefinitions.h"
+#include "ThreadPool.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class IEmployee;
+class AttendanceManager;
+class WelfareManager;
+class EmployeeIdPool;
+
+/**
+ * @file PayrollEngine.h
+ * @brief Định nghĩa lớp PayrollEngine, tính lương hàng loạt cho mọi nhân viên trong một kỳ lương.
+ */
+
+/**
+ * @struct PayrollYear
+ * @brief Bảng lương cả năm: ma trận nhân viên x 12 tháng (PayrollEngine::calculateYear()).
+ */
+struct PayrollYear {
+    /** @brief Số tháng (số cột) của ma trận. */
+    static constexpr std::size_t MONTHS = 12;
+
+    int year = 0;                                      ///< @brief Năm của bảng lương.
+    std::vector<std::shared_ptr<IEmployee>> employees; ///< @brief Các hàng của ma trận, theo thứ tự danh sách nhân viên.
+    std::vector<SalaryDetails> cells;                  ///< @brief employees.size() x MONTHS ô, lưu theo hàng.
+
+    /**
+     * @brief Chi tiết lương của nhân viên ở hàng `row` trong tháng `month` (1-12).
+     */
+    const SalaryDetails& at(std::size_t row, int month) const {
+        return cells[row * MONTHS + static_cast<std::size_t>(month - 1)];
+    }
+};
+
+/**
+ * @class PayrollEngine
+ * @brief Tính bảng lương của cả danh sách nhân viên bằng một lần quét dữ liệu chấm công của kỳ.
+ *
+ * Thay vì để mỗi phúc lợi và mỗi lần tính lương tự tra cứu AttendanceManager cho từng nhân viên,
+ * PayrollEngine tổng hợp trước số liệu (giờ thường, tăng ca, ngày lễ và các loại ngày có mặt)
+ * của mọi nhân viên qua AttendanceManager::summarizePeriod(), rồi tính phúc lợi và lương của
+ * từng nhân viên từ số liệu đó. Tổng chi phí là O(số bản ghi của kỳ + số nhân viên).
+ *
+ * Kết quả giống hệt (từng bit) cách tính từng nhân viên bằng
+ * WelfareManager::calculateAllWelfareForEmployee() và IEmployee::calculateSalary() với AttendanceManager.
+ * Vùng nhớ của số liệu tổng hợp được giữ lại giữa các lần tính.
+ *
+ * Nhân viên được gom theo nhóm tính lương (IEmployee::getCategory()); mỗi nhóm có một chính sách
+ * lương biên dịch sẵn (PayPolicy.h) và được tính bằng một vòng lặp riêng, biên dịch cho đúng lớp
+ * nhân viên `final` của nhóm, nên phần tính lương được inline hoàn toàn, không qua hàm ảo.
+ * Nhóm không có chính sách (giá trị ngoài EmployeeCategory) vẫn được tính qua IEmployee::calculateSalary().
+ *
+ * Với danh sách lớn (từ PARALLEL_MIN_EMPLOYEES nhân viên) và số luồng khác 1, lương của các
+ * nhân viên được tính song song trên ThreadPool (chia đoạn, cân bằng bằng lấy trộm công việc).
+ * Các luồng chỉ đọc số liệu tổng hợp, danh sách phúc lợi và nhân viên; mỗi nhân viên được ghi
+ * vào đúng vị trí của mình trong bảng lương, nên thứ tự và từng con số giống hệt khi tính tuần tự.
+ */
+class PayrollEngine {
+public:
+    /** @brief Một dòng bảng lương: nhân viên và chi tiết lương (cùng kiểu với PayrollPrinter::printToFile). */
+    using PayrollEntry = std::pair<std::shared_ptr<IEmployee>, SalaryDetails>;
+
+    /**
+     * @brief Tính lương của mọi nhân viên trong kỳ lương tháng/năm.
+     * @param employees Danh sách nhân viên (con trỏ null bị bỏ qua).
+     * @param attendance Dữ liệu chấm công đã tải.
+     * @param welfareManager Danh sách phúc lợi.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @param payrollData Bảng lương kết quả, theo đúng thứ tự của `employees` (được xóa trước khi ghi).
+     */
+    void calculateAll(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+                      const WelfareManager& welfareManager, int month, int year, std::vector<PayrollEntry>& payrollData);
+
+    /**
+     * @brief Tính bảng lương 12 tháng của mọi nhân viên trong một năm.
+     * Số liệu chấm công của cả năm được lấy bằng một lần duyệt (AttendanceManager::summarizeYear()),
+     * khóa chấm công và nhóm tính lương của nhân viên chỉ được xác định một lần; mỗi ô giống hệt
+     * kết quả calculateAll() của tháng tương ứng.
+     * @param employees Danh sách nhân viên (con trỏ null bị bỏ qua).
+     * @param attendance Dữ liệu chấm công đã tải (phải chứa dữ liệu của cả năm).
+     * @param welfareManager Danh sách phúc lợi.
+     * @param year Năm.
+     * @param result Ma trận kết quả (được ghi đè).
+     */
+    void calculateYear(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+                       const WelfareManager& welfareManager, int year, PayrollYear& result);
+
+    /**
+     * @brief Đặt số luồng dùng để tính lương (có hiệu lực từ lần tính tiếp theo).
+     * @param threadCount Số luồng; 0 = theo số lõi CPU, 1 = luôn tính tuần tự.
+     */
+    void setThreadCount(unsigned threadCount);
+
+    /**
+     * @brief Lấy số luồng đã cấu hình (0 = theo số lõi CPU).
+     */
+    unsigned getThreadCount() const { return _threadCount; }
+
+    /** @brief Số nhân viên tối thiểu để tính song song (danh sách nhỏ hơn được tính tuần tự). */
+    static constexpr std::size_t PARALLEL_MIN_EMPLOYEES = 2048;
+
+    /** @brief Số nhân viên trong mỗi đoạn công việc khi tính song song. */
+    static constexpr std::size_t PARALLEL_GRAIN = 512;
+
+private:
+    std::vector<AttendanceSummary> _summaries; ///< @brief Số liệu tổng hợp theo khóa nhân viên của kỳ (hoặc năm) đang tính.
+    std::vector<SalaryDetails> _details;       ///< @brief Chi tiết lương theo vị trí trong danh sách nhân viên (calculateAll()).
+    std::vector<std::uint32_t> _keys;          ///< @brief Khóa chấm công của từng nhân viên (EmployeeIdPool::npos nếu không có).
+    unsigned _threadCount = 0;                 ///< @brief Số luồng đã cấu hình (0 = theo số lõi CPU).
+    std::unique_ptr<ThreadPool> _pool;         ///< @brief Nhóm luồng, tạo ở lần tính song song đầu tiên và dùng lại.
+
+    /** @brief Vị trí nhóm "khác" (nhân viên có nhóm ngoài EmployeeCategory, tính qua hàm ảo). */
+    static constexpr std::size_t OTHER_GROUP = static_cast<std::size_t>(EmployeeCategory::Count);
+
+    /** @brief Chỉ số nhân viên (trong danh sách) của từng nhóm tính lương; vùng nhớ được giữ lại giữa các lần tính. */
+    std::array<std::vector<std::uint32_t>, OTHER_GROUP + 1> _groups;
+
+    /**
+     * @brief Tra khóa chấm công (_keys), gom nhân viên theo nhóm tính lương (_groups) và tạo nhóm luồng nếu cần.
+     * @return true nếu danh sách đủ lớn để tính song song.
+     */
+    bool prepare(const std::vector<std::shared_ptr<IEmployee>>& employees, const EmployeeIdPool& ids);
+
+    /**
+     * @brief Tính phúc lợi và lương của mọi nhân viên đã được prepare(), lần lượt `months` kỳ lương
+     * liên tiếp cho mỗi nhân viên (tác động phúc lợi của nhân viên được tính một lần cho mọi kỳ).
+     * @param summaries Số liệu tổng hợp của kỳ m và khóa k ở summaries[m * summaryStride + k].
+     * @param out Kết quả kỳ m của nhân viên thứ i được ghi vào out[i * months + m].
+     */
+    void calculateGroups(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceSummary* summaries,
+                         std::size_t summaryStride, std::size_t months, const WelfareManager& welfareManager,
+                         SalaryDetails* out, bool parallel);
+};
+
+#endif // PAYROLL_ENGINE_H
@@ -0,0 +1,219 @@
+﻿#include "PayrollHistory.h"
+#include "AttendanceCache.h"
+#include "IEmployee.h"
+#include "PayRateTable.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+    /** @brief Số trường của một dòng trong file lịch sử. */
+    constexpr std::size_t FIELD_COUNT = 12;
+
+    /** @brief Số trường của một dòng trong file lịch sử cũ (chưa có dấu vân tay bảng đơn giá). */
+    constexpr std::size_t LEGACY_FIELD_COUNT = 11;
+
+    /**
+     * @brief Mã kỳ lương dùng làm khóa.
+     */
+    inline std::int32_t periodKey(int month, int year) {
+        return year * 12 + (month - 1);
+    }
+
+    /**
+     * @brief Đọc một số nguyên có dấu (cả trường), theo cơ số đã cho.
+     * @return false nếu trường rỗng hoặc có ký tự thừa.
+     */
+    bool parseInteger(const std::string& text, int base, long long& value) {
+        if (text.empty()) return false;
+        errno = 0;
+        char* end = nullptr;
+        value = std::strtoll(text.c_str(), &end, base);
+        return errno == 0 && *end == '\0';
+    }
+
+    /**
+     * @brief Đọc một số nguyên không dấu 64-bit dạng thập lục phân.
+     */
+    bool parseHex(const std::string& text, std::uint64_t& value) {
+        if (text.empty()) return false;
+        errno = 0;
+        char* end = nullptr;
+        value = std::strtoull(text.c_str(), &end, 16);
+        return errno == 0 && *end == '\0';
+    }
+
+    /**
+     * @brief Tách một dòng theo dấu phẩy vào `fields` (dùng lại dung lượng cũ).
+     */
+    void splitLine(const std::string& line, std::vector<std::string>& fields) {
+        fields.clear();
+        std::size_t start = 0;
+        while (true) {
+            const std::size_t comma = line.find(',', start);
+            fields.emplace_back(line, start, comma == std::string::npos ? std::string::npos : comma - start);
+            if (comma == std::string::npos) break;
+            start = comma + 1;
+        }
+    }
+
+} // namespace
+
+/**
+ * @brief Đọc lịch sử chi trả từ file.
+ */
+bool PayrollHistory::loadFromFile(const std::string& filename) {
+    _periods.clear();
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    std::string line;
+    std::vector<std::string> fields;
+    std::size_t lineNumber = 0, invalidLines = 0, firstInvalid = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        splitLine(line, fields);
+        const bool legacy = fields.size() == LEGACY_FIELD_COUNT;
+        bool valid = (fields.size() == FIELD_COUNT || legacy) && fields[0].size() == 7 && fields[0][4] == '-' && !fields[1].empty();
+        long long year = 0, month = 0;
+        PaidPayroll entry;
+        if (valid) {
+            valid = parseInteger(fields[0].substr(0, 4), 10, year) && parseInteger(fields[0].substr(5), 10, month)
+                 && month >= 1 && month <= 12
+                 && parseHex(fields[2], entry.attendanceFingerprint) && parseHex(fields[3], entry.recordFingerprint)
+                 && (legacy || parseHex(fields[4], entry.rateFingerprint));
+        }
+        const std::size_t firstAmount = legacy ? 4 : 5;
+        Money* const amounts[] = { &entry.details.basicSalary, &entry.details.overtimeSalary, &entry.details.holidaySalary,
+                                   &entry.details.bonuses, &entry.details.allowances, &entry.details.deductions,
+                                   &entry.details.totalSalary };
+        for (std::size_t i = 0; valid && i < 7; ++i) {
+            long long dong = 0;
+            valid = parseInteger(fields[firstAmount + i], 10, dong);
+            *amounts[i] = Money::fromDong(dong);
+        }
+        if (!valid) {
+            if (invalidLines++ == 0) firstInvalid = lineNumber;
+            continue;
+        }
+        entry.employeeId = fields[1];
+        _periods[periodKey(static_cast<int>(month), static_cast<int>(year))].push_back(std::move(entry));
+    }
+    if (invalidLines > 0) {
+        std::cerr << "CANH BAO: " << filename << " co " << invalidLines << " dong loi (dong dau tien: "
+                  << firstInvalid << "), cac dong nay bi bo qua." << std::endl;
+    }
+    return true;
+}
+
+/**
+ * @brief Ghi toàn bộ lịch sử ra file.
+ */
+bool PayrollHistory::saveToFile(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Loi: Khong the mo file de ghi: " << filename << std::endl;
+        return false;
+    }
+    file << "#ky,ma_nv,dau_van_tay_cham_cong,dau_van_tay_ho_so,dau_van_tay_don_gia,luong_gio,tang_ca,ngay_le,thuong,phu_cap,khau_tru,luong_rong\n";
+    char period[16];
+    char fingerprints[56];
+    for (const auto& [key, entries] : _periods) {
+        std::snprintf(period, sizeof(period), "%04d-%02d", key / 12, key % 12 + 1);
+        for (const PaidPayroll& entry : entries) {
+            std::snprintf(fingerprints, sizeof(fingerprints), "%016llx,%016llx,%016llx",
+                          static_cast<unsigned long long>(entry.attendanceFingerprint),
+                          static_cast<unsigned long long>(entry.recordFingerprint),
+                          static_cast<unsigned long long>(entry.rateFingerprint));
+            const SalaryDetails& d = entry.details;
+            file << period << ',' << entry.employeeId << ',' << fingerprints
+                 << ',' << d.basicSalary.dong() << ',' << d.overtimeSalary.dong() << ',' << d.holidaySalary.dong()
+                 << ',' << d.bonuses.dong() << ',' << d.allowances.dong() << ',' << d.deductions.dong()
+                 << ',' << d.totalSalary.dong() << '\n';
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Ghi nhận bảng lương đã chi trả của một kỳ.
+ */
+void PayrollHistory::recordPeriod(int month, int year, std::vector<PaidPayroll> entries) {
+    _periods[periodKey(month, year)] = std::move(entries);
+}
+
+/**
+ * @brief Lương đã chi trả của một kỳ.
+ */
+const std::vector<PaidPayroll>* PayrollHistory::findPeriod(int month, int year) const {
+    auto it = _periods.find(periodKey(month, year));
+    return it != _periods.end() ? &it->second : nullptr;
+}
+
+/**
+ * @brief Lương đã chi trả của một kỳ (sửa được).
+ */
+std::vector<PaidPayroll>* PayrollHistory::findPeriod(int month, int year) {
+    auto it = _periods.find(periodKey(month, year));
+    return it != _periods.end() ? &it->second : nullptr;
+}
+
+/**
+ * @brief Tổng số dòng đang lưu.
+ */
+std::size_t PayrollHistory::size() const {
+    std::size_t count = 0;
+    for (const auto& period : _periods) count += period.second.size();
+    return count;
+}
+
+/**
+ * @brief Dấu vân tay của số liệu chấm công tổng hợp.
+ */
+std::uint64_t PayrollHistory::attendanceFingerprint(const AttendanceSummary& summary) {
+    // Chép từng trường vào mảng số nguyên để dấu vân tay không phụ thuộc cách bố trí bộ nhớ của struct
+    std::int64_t fields[3 + 2 * ATTENDANCE_DAY_TYPE_COUNT];
+    std::size_t n = 0;
+    fields[n++] = summary.paidNormalSeconds;
+    fields[n++] = summary.paidOvertimeSeconds;
+    fields[n++] = summary.paidHolidaySeconds;
+    for (std::size_t t = 0; t < ATTENDANCE_DAY_TYPE_COUNT; ++t) {
+        fields[n++] = summary.workedSeconds[t];
+        fields[n++] = summary.dayCounts[t];
+    }
+    return AttendanceCache::checksum(reinterpret_cast<const char*>(fields), sizeof(fields));
+}
+
+/**
+ * @brief Dấu vân tay các trường hồ sơ của nhân viên.
+ */
+std::uint64_t PayrollHistory::recordFingerprint(const IEmployee& employee) {
+    const std::string record = employee.toCsvString() + "," + std::to_string(employee.getMonthsWorked());
+    return AttendanceCache::checksum(record.data(), record.size());
+}
+
+/**
+ * @brief Dấu vân tay của bảng đơn giá.
+ */
+std::uint64_t PayrollHistory::rateFingerprint(const PayRateTable& table) {
+    // Chép từng trường vào mảng số nguyên (giá trị double chép nguyên bit), như attendanceFingerprint()
+    std::int64_t fields[3 * PAY_CATEGORY_COUNT + 3];
+    std::size_t n = 0;
+    for (const CategoryPayRates& rates : table.categories) {
+        fields[n++] = rates.hourlyRate.dong();
+        fields[n++] = rates.overtimeRate.dong();
+        fields[n++] = rates.holidayRate.dong();
+    }
+    for (double value : { table.socialInsuranceRate, table.revenueBonus, table.transportRatePerKm }) {
+        std::memcpy(&fields[n++], &value, sizeof(value));
+    }
+    const std::uint64_t hash = AttendanceCache::checksum(reinterpret_cast<const char*>(fields), sizeof(fields));
+    return hash != 0 ? hash : 1; // 0 dành cho dòng lịch sử không rõ bảng đơn giá
+}
@@ -0,0 +1,98 @@
+﻿#ifndef PAYROLL_HISTORY_H
+#define PAYROLL_HISTORY_H
+
+#include "GlobalDefinitions.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class IEmployee;
+struct PayRateTable;
+
+/**
+ * @file PayrollHistory.h
+ * @brief Định nghĩa lớp PayrollHistory, lưu các bảng lương đã chi trả theo kỳ cùng dấu vân tay dữ liệu đầu vào.
+ */
+
+/**
+ * @struct PaidPayroll
+ * @brief Lương đã chi trả của một nhân viên trong một kỳ và dấu vân tay của dữ liệu dùng để tính.
+ */
+struct PaidPayroll {
+    std::string employeeId;                  ///< @brief Mã nhân viên.
+    std::uint64_t attendanceFingerprint = 0; ///< @brief Dấu vân tay số liệu chấm công tổng hợp của kỳ lúc chi trả.
+    std::uint64_t recordFingerprint = 0;     ///< @brief Dấu vân tay hồ sơ nhân viên lúc chi trả.
+    std::uint64_t rateFingerprint = 0;       ///< @brief Dấu vân tay bảng đơn giá lúc chi trả (0: không rõ, file lịch sử cũ).
+    SalaryDetails details;                   ///< @brief Các khoản đã chi trả.
+};
+
+/**
+ * @class PayrollHistory
+ * @brief Lịch sử chi trả lương: mỗi kỳ (tháng/năm) một danh sách PaidPayroll.
+ *
+ * Dấu vân tay cho phép biết một kỳ đã trả có cần tính lại hay không mà không phải tính lương:
+ * nếu số liệu chấm công tổng hợp, hồ sơ của nhân viên và bảng đơn giá vẫn cho cùng dấu vân tay
+ * thì lương của kỳ đó không đổi. File lưu là văn bản, mỗi dòng một nhân viên một kỳ:
+ * `YYYY-MM,ma_nv,dau_van_tay_cham_cong,dau_van_tay_ho_so,dau_van_tay_don_gia,luong_gio,tang_ca,ngay_le,thuong,phu_cap,khau_tru,luong_rong`.
+ * Dòng của file cũ (không có cột dau_van_tay_don_gia) vẫn được đọc, với rateFingerprint = 0.
+ */
+class PayrollHistory {
+public:
+    /** @brief Tên file lịch sử chi trả mặc định. */
+    static constexpr const char* DEFAULT_FILE = "payroll_history.csv";
+
+    /**
+     * @brief Đọc lịch sử từ file, thay cho dữ liệu hiện có. Dòng lỗi được đếm và cảnh báo một lần.
+     * @param filename Tên file.
+     * @return false nếu không mở được file (lịch sử rỗng).
+     */
+    bool loadFromFile(const std::string& filename);
+
+    /**
+     * @brief Ghi toàn bộ lịch sử ra file (theo thứ tự kỳ lương).
+     * @return false nếu không mở được file để ghi.
+     */
+    bool saveToFile(const std::string& filename) const;
+
+    /**
+     * @brief Ghi nhận bảng lương đã chi trả của một kỳ, thay cho dữ liệu cũ của kỳ đó.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     * @param entries Lương đã chi trả của từng nhân viên.
+     */
+    void recordPeriod(int month, int year, std::vector<PaidPayroll> entries);
+
+    /**
+     * @brief Lương đã chi trả của một kỳ.
+     * @return Con trỏ tới danh sách (hợp lệ tới lần sửa đổi tiếp theo), nullptr nếu kỳ chưa được chi trả.
+     */
+    const std::vector<PaidPayroll>* findPeriod(int month, int year) const;
+
+    /** @brief Phiên bản sửa được của findPeriod(). */
+    std::vector<PaidPayroll>* findPeriod(int month, int year);
+
+    /** @brief Tổng số dòng (nhân viên x kỳ) đang lưu. */
+    std::size_t size() const;
+
+    /**
+     * @brief Dấu vân tay của số liệu chấm công tổng hợp (mọi trường của AttendanceSummary).
+     */
+    static std::uint64_t attendanceFingerprint(const AttendanceSummary& summary);
+
+    /**
+     * @brief Dấu vân tay các trường hồ sơ của nhân viên ảnh hưởng tới lương (dòng lưu file và thâm niên).
+     */
+    static std::uint64_t recordFingerprint(const IEmployee& employee);
+
+    /**
+     * @brief Dấu vân tay của bảng đơn giá (đơn giá mọi nhóm nhân viên và tham số các phúc lợi chuẩn). Khác 0.
+     */
+    static std::uint64_t rateFingerprint(const PayRateTable& table);
+
+private:
+    std::map<std::int32_t, std::vector<PaidPayroll>> _periods; ///< @brief Theo mã kỳ (năm * 12 + tháng - 1).
+};
+
+#endif // PAYROLL_HISTORY_H
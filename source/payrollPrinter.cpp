@@ -1,4 +1,9 @@
 ﻿#include "PayrollPrinter.h"
+#include "PayrollEngine.h"
+#include "PayrollSimulator.h"
+#include "RetroPayEngine.h"
+#include "AttendanceManager.h"
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <iomanip> // Để dùng std::setw
@@ -30,7 +35,7 @@ void PayrollPrinter::printEmployeeDetails(const std::shared_ptr<IEmployee>& emp,
     gotoXY(contentX + 55, currentLineY++); std::cout << std::left << std::setw(labelWidth) << "Email            :   " << emp->getEmail();
     
     // Hiển thị lương cơ bản với định dạng
-    std::string formattedBaseSalary = _formatter.format(emp->getBaseSalary(), _culture) + " VND";
+    std::string formattedBaseSalary = _formatter.format(Money::fromDouble(emp->getBaseSalary()), _culture) + " VND";
     gotoXY(contentX + 55, currentLineY++); std::cout << std::left << std::setw(labelWidth) << "Luong co ban     :   " << formattedBaseSalary;
     
     gotoXY(contentX + 55, currentLineY++); std::cout << std::left << std::setw(labelWidth) << "Thong tin them   :   " << emp->getAdditionInfo();
@@ -42,8 +47,8 @@ void PayrollPrinter::printEmployeeDetails(const std::shared_ptr<IEmployee>& emp,
 /**
  * @brief In phiếu lương chi tiết của một nhân viên ra console.
  */
-void PayrollPrinter::printPaySlip(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details) const {
-    if (!emp) return;
+int PayrollPrinter::printPaySlip(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details, const AttendanceTotals& attendance) const {
+    if (!emp) return 0;
 
     // Tọa độ này là tương đối với màn hình đã được EmployeeManager::printPayroll chuẩn bị
     // EmployeeManager::printPayroll vẽ khung và tiêu đề "PHIEU LUONG NHAN VIEN"
@@ -61,8 +66,18 @@ void PayrollPrinter::printPaySlip(const std::shared_ptr<IEmployee>& emp, const S
     gotoXY(col2X_label+tab+12, currentLineY++); std::cout << "Ma NV: " << emp->getEmployeeId() << " | Ten: " << emp->getName();
     gotoXY(col2X_label+tab, currentLineY++); std::cout << std::string(59, '-'); // Điều chỉnh độ dài
 
+    // Số liệu chấm công của kỳ (tra O(1) từ số liệu tổng hợp)
+    gotoXY(col2X_label+tab, currentLineY); std::cout << std::left << std::setw(23) << "Gio lam BT / tang ca:";
+    gotoXY(col2X_value+tab+15, currentLineY++); std::cout << std::right << std::setw(valueWidth)
+        << (std::to_string(attendance.workHours) + " / " + std::to_string(attendance.overtimeHours)) << " gio";
+    gotoXY(col2X_label+tab, currentLineY); std::cout << std::left << std::setw(23) << "Ngay le / phep / KL:";
+    gotoXY(col2X_value+tab+15, currentLineY++); std::cout << std::right << std::setw(valueWidth)
+        << (std::to_string(attendance.holidayWorkDays) + " / " + std::to_string(attendance.leavePaidDays) + " / "
+            + std::to_string(attendance.leaveUnpaidDays)) << " ngay";
+    currentLineY++;
+
     gotoXY(col2X_label+tab, currentLineY); std::cout << std::left << std::setw(23) << "Luong co ban:"; // Tăng setw
-    gotoXY(col2X_value+tab+15, currentLineY++); std::cout << std::right << std::setw(valueWidth) << _formatter.format(emp->getBaseSalary(), _culture) << " VND";
+    gotoXY(col2X_value+tab+15, currentLineY++); std::cout << std::right << std::setw(valueWidth) << _formatter.format(Money::fromDouble(emp->getBaseSalary()), _culture) << " VND";
     
     gotoXY(col2X_label+tab, currentLineY); std::cout << std::left << std::setw(23) << "Luong lam viec BT:"; 
     gotoXY(col2X_value+tab+15, currentLineY++); std::cout << std::right << std::setw(valueWidth) << _formatter.format(details.basicSalary, _culture) << " VND";
@@ -88,9 +103,11 @@ void PayrollPrinter::printPaySlip(const std::shared_ptr<IEmployee>& emp, const S
     
     gotoXY(col2X_label+tab, currentLineY); std::cout << std::left << std::setw(23) << "TONG LUONG (RONG):";
     gotoXY(col2X_value+tab+15, currentLineY++); std::cout << std::right << std::setw(valueWidth) << _formatter.format(details.totalSalary, _culture) << " VND";
+    return currentLineY;
 }
 
-void PayrollPrinter::printPaySlipToFile(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details, const std::string& filename) const {
+void PayrollPrinter::printPaySlipToFile(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details, const AttendanceTotals& attendance,
+                                        const std::string& filename) const {
     if (!emp) return;
 
     std::ofstream outFile(filename);
@@ -105,7 +122,14 @@ void PayrollPrinter::printPaySlipToFile(const std::shared_ptr<IEmployee>& emp, c
     outFile << "Ma NV: " << emp->getEmployeeId() << " | Ten: " << emp->getName() << "\n";
     outFile << "----------------------------------------\n";
 
-    outFile << std::left << std::setw(20) << "Luong co ban:" << std::right << std::setw(15) << _formatter.format(emp->getBaseSalary(), _culture) << " VND\n";
+    outFile << std::left << std::setw(20) << "Gio lam BT:" << std::right << std::setw(15) << attendance.workHours << " gio\n";
+    outFile << std::left << std::setw(20) << "Gio tang ca:" << std::right << std::setw(15) << attendance.overtimeHours << " gio\n";
+    outFile << std::left << std::setw(20) << "Ngay lam ngay le:" << std::right << std::setw(15) << attendance.holidayWorkDays << " ngay\n";
+    outFile << std::left << std::setw(20) << "Ngay nghi phep:" << std::right << std::setw(15) << attendance.leavePaidDays << " ngay\n";
+    outFile << std::left << std::setw(20) << "Nghi khong luong:" << std::right << std::setw(15) << attendance.leaveUnpaidDays << " ngay\n";
+    outFile << "\n";
+
+    outFile << std::left << std::setw(20) << "Luong co ban:" << std::right << std::setw(15) << _formatter.format(Money::fromDouble(emp->getBaseSalary()), _culture) << " VND\n";
     outFile << std::left << std::setw(20) << "Luong lam viec BT:" << std::right << std::setw(15) << _formatter.format(details.basicSalary, _culture) << " VND\n";
     outFile << std::left << std::setw(20) << "Luong tang ca:" << std::right << std::setw(15) << _formatter.format(details.overtimeSalary, _culture) << " VND\n";
     outFile << std::left << std::setw(20) << "Luong ngay le:" << std::right << std::setw(15) << _formatter.format(details.holidaySalary, _culture) << " VND\n";
@@ -155,7 +179,7 @@ void PayrollPrinter::printToFile(const std::vector<std::pair<std::shared_ptr<IEm
                 << std::setw(8) << emp->getEmployeeId()
                 << std::setw(25) << emp->getName()
                 // Hiển thị Lương Cơ Bản cố định từ đối tượng Employee
-                << std::setw(18) << _formatter.format(emp->getBaseSalary(), _culture)
+                << std::setw(18) << _formatter.format(Money::fromDouble(emp->getBaseSalary()), _culture)
                 // Hiển thị các thành phần lương từ SalaryDetails
                 << std::setw(18) << _formatter.format(details.basicSalary, _culture)    // Lương giờ làm việc bình thường
                 << std::setw(15) << _formatter.format(details.overtimeSalary, _culture) // Lương tăng ca
@@ -170,3 +194,195 @@ void PayrollPrinter::printToFile(const std::vector<std::pair<std::shared_ptr<IEm
     outFile.close();
     //std::cout << "Da xuat bang luong ra file: " << filename << std::endl; // Thêm thông báo này nếu muốn
 }
+
+/**
+ * @brief In ma trận lương ròng cả năm ra file.
+ */
+void PayrollPrinter::printYearToFile(const PayrollYear& payrollYear, const std::string& filename) const {
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        std::cerr << "Loi: Khong the mo file de ghi: " << filename << std::endl;
+        return;
+    }
+
+    const std::string line(8 + 25 + 14 * PayrollYear::MONTHS + 18, '-');
+    outFile << "BANG LUONG CA NAM " << payrollYear.year << " (LUONG RONG THEO THANG)\n";
+    outFile << line << "\n";
+    outFile << std::left << std::setw(8) << "Ma NV" << std::setw(25) << "Ho Ten";
+    for (std::size_t m = 1; m <= PayrollYear::MONTHS; ++m) {
+        outFile << std::setw(14) << ("Thang " + std::to_string(m));
+    }
+    outFile << std::setw(18) << "CA NAM" << "\n";
+    outFile << line << "\n";
+
+    for (std::size_t row = 0; row < payrollYear.employees.size(); ++row) {
+        const auto& emp = payrollYear.employees[row];
+        outFile << std::left << std::setw(8) << emp->getEmployeeId() << std::setw(25) << emp->getName();
+        Money yearTotal;
+        for (int month = 1; month <= static_cast<int>(PayrollYear::MONTHS); ++month) {
+            const Money net = payrollYear.at(row, month).totalSalary;
+            yearTotal += net;
+            outFile << std::setw(14) << _formatter.format(net, _culture);
+        }
+        outFile << std::setw(18) << _formatter.format(yearTotal, _culture) << "\n";
+    }
+}
+
+/**
+ * @brief In bản tổng hợp cả năm ra file.
+ */
+void PayrollPrinter::printYearSummaryToFile(const PayrollYear& payrollYear, const std::string& filename) const {
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        std::cerr << "Loi: Khong the mo file de ghi: " << filename << std::endl;
+        return;
+    }
+
+    // Tổng từng thành phần theo tháng (chỉ số 0-11) và của cả năm (chỉ số 12)
+    SalaryDetails totals[PayrollYear::MONTHS + 1];
+    for (std::size_t row = 0; row < payrollYear.employees.size(); ++row) {
+        for (std::size_t m = 0; m < PayrollYear::MONTHS; ++m) {
+            const SalaryDetails& cell = payrollYear.at(row, static_cast<int>(m + 1));
+            for (SalaryDetails* total : { &totals[m], &totals[PayrollYear::MONTHS] }) {
+                total->basicSalary += cell.basicSalary;
+                total->overtimeSalary += cell.overtimeSalary;
+                total->holidaySalary += cell.holidaySalary;
+                total->bonuses += cell.bonuses;
+                total->allowances += cell.allowances;
+                total->deductions += cell.deductions;
+                total->totalSalary += cell.totalSalary;
+            }
+        }
+    }
+
+    const std::string line(10 + 18 * 7, '-');
+    outFile << "TONG HOP LUONG NAM " << payrollYear.year << "\n";
+    outFile << "So nhan vien: " << payrollYear.employees.size() << "\n";
+    outFile << line << "\n";
+    outFile << std::left << std::setw(10) << "Thang"
+            << std::setw(18) << "L.Lam Viec BT" << std::setw(18) << "L.Tang Ca" << std::setw(18) << "L.Ngay Le"
+            << std::setw(18) << "Thuong" << std::setw(18) << "Phu Cap" << std::setw(18) << "Khau Tru"
+            << std::setw(18) << "LUONG RONG" << "\n";
+    outFile << line << "\n";
+    for (std::size_t m = 0; m <= PayrollYear::MONTHS; ++m) {
+        if (m == PayrollYear::MONTHS) outFile << line << "\n";
+        const SalaryDetails& total = totals[m];
+        outFile << std::left << std::setw(10) << (m < PayrollYear::MONTHS ? std::to_string(m + 1) : std::string("CA NAM"))
+                << std::setw(18) << _formatter.format(total.basicSalary, _culture)
+                << std::setw(18) << _formatter.format(total.overtimeSalary, _culture)
+                << std::setw(18) << _formatter.format(total.holidaySalary, _culture)
+                << std::setw(18) << _formatter.format(total.bonuses, _culture)
+                << std::setw(18) << _formatter.format(total.allowances, _culture)
+                << std::setw(18) << _formatter.format(total.deductions, _culture)
+                << std::setw(18) << _formatter.format(total.totalSalary, _culture) << "\n";
+    }
+}
+
+/**
+ * @brief In kết quả mô phỏng chi phí lương ra file.
+ */
+void PayrollPrinter::printSimulationToFile(const std::vector<PayScenario>& scenarios, const std::vector<ScenarioResult>& results,
+                                           std::size_t employeeCount, int month, int year, const std::string& filename) const {
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        std::cerr << "Loi: Khong the mo file de ghi: " << filename << std::endl;
+        return;
+    }
+    if (scenarios.empty() || results.size() != scenarios.size()) return;
+
+    // Chênh lệch có dấu "+" khi tăng chi phí
+    auto delta = [&](Money value, Money base) {
+        const Money difference = value - base;
+        return (difference > Money() ? "+" : "") + _formatter.format(difference, _culture);
+    };
+    const ScenarioResult& base = results.front();
+    const char* const categoryNames[PAY_CATEGORY_COUNT] = { "CL Chinh thuc", "CL Hop dong", "CL Thuc tap" };
+
+    outFile << "MO PHONG CHI PHI LUONG THEO SO LIEU THANG " << month << "/" << year << "\n";
+    outFile << "So nhan vien: " << employeeCount << ", so kich ban: " << scenarios.size()
+            << ", kich ban goc: " << scenarios.front().name << "\n";
+
+    // 1. Tổng lương ròng và chênh lệch theo nhóm nhân viên
+    const std::string line(32 + 20 * (2 + PAY_CATEGORY_COUNT), '-');
+    outFile << line << "\n";
+    outFile << std::left << std::setw(32) << "Kich ban" << std::setw(20) << "Tong luong rong" << std::setw(20) << "Chenh lech";
+    for (const char* name : categoryNames) outFile << std::setw(20) << name;
+    outFile << "\n" << line << "\n";
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+        const ScenarioResult& result = results[s];
+        outFile << std::left << std::setw(32) << scenarios[s].name.substr(0, 31)
+                << std::setw(20) << _formatter.format(result.total.totalSalary, _culture)
+                << std::setw(20) << delta(result.total.totalSalary, base.total.totalSalary);
+        for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+            outFile << std::setw(20) << delta(result.byCategory[c].totalSalary, base.byCategory[c].totalSalary);
+        }
+        outFile << "\n";
+    }
+
+    // 2. Chênh lệch theo thành phần lương
+    const std::string componentLine(32 + 18 * 6, '-');
+    outFile << "\nCHENH LECH THEO THANH PHAN LUONG\n" << componentLine << "\n";
+    outFile << std::left << std::setw(32) << "Kich ban"
+            << std::setw(18) << "L.Lam Viec BT" << std::setw(18) << "L.Tang Ca" << std::setw(18) << "L.Ngay Le"
+            << std::setw(18) << "Thuong" << std::setw(18) << "Phu Cap" << std::setw(18) << "Khau Tru" << "\n";
+    outFile << componentLine << "\n";
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+        const SalaryDetails& total = results[s].total;
+        outFile << std::left << std::setw(32) << scenarios[s].name.substr(0, 31)
+                << std::setw(18) << delta(total.basicSalary, base.total.basicSalary)
+                << std::setw(18) << delta(total.overtimeSalary, base.total.overtimeSalary)
+                << std::setw(18) << delta(total.holidaySalary, base.total.holidaySalary)
+                << std::setw(18) << delta(total.bonuses, base.total.bonuses)
+                << std::setw(18) << delta(total.allowances, base.total.allowances)
+                << std::setw(18) << delta(total.deductions, base.total.deductions) << "\n";
+    }
+}
+
+/**
+ * @brief In các khoản chênh lệch lương của các kỳ đã chi trả ra file.
+ */
+void PayrollPrinter::printAdjustmentsToFile(const std::vector<PayAdjustment>& adjustments, const RetroPayStats& stats,
+                                            int year, const std::string& filename) const {
+    std::ofstream outFile(filename);
+    if (!outFile) {
+        std::cerr << "Loi: Khong the mo file de ghi: " << filename << std::endl;
+        return;
+    }
+
+    // Chênh lệch có dấu "+" khi phải trả thêm
+    auto signedAmount = [&](Money difference) {
+        return (difference > Money() ? "+" : "") + _formatter.format(difference, _culture);
+    };
+    auto printRow = [&](const std::string& period, const std::string& employeeId, const SalaryDetails& d) {
+        outFile << std::left << std::setw(9) << period << std::setw(8) << employeeId
+                << std::setw(16) << signedAmount(d.basicSalary)
+                << std::setw(16) << signedAmount(d.overtimeSalary)
+                << std::setw(16) << signedAmount(d.holidaySalary)
+                << std::setw(16) << signedAmount(d.bonuses)
+                << std::setw(16) << signedAmount(d.allowances)
+                << std::setw(16) << signedAmount(d.deductions)
+                << std::setw(16) << signedAmount(d.totalSalary) << "\n";
+    };
+
+    outFile << "CHENH LECH LUONG CAC KY DA CHI TRA NAM " << year << "\n";
+    outFile << "So ky: " << stats.periods << ", so dong da xet: " << stats.checked
+            << ", tinh lai: " << stats.recalculated << ", co chenh lech: " << stats.adjusted;
+    if (stats.missingEmployees > 0) outFile << ", nhan vien khong con trong danh sach: " << stats.missingEmployees;
+    outFile << "\n";
+
+    const std::string line(9 + 8 + 16 * 7, '-');
+    outFile << line << "\n";
+    outFile << std::left << std::setw(9) << "Ky" << std::setw(8) << "MaNV"
+            << std::setw(16) << "L.Lam Viec BT" << std::setw(16) << "L.Tang Ca" << std::setw(16) << "L.Ngay Le"
+            << std::setw(16) << "Thuong" << std::setw(16) << "Phu Cap" << std::setw(16) << "Khau Tru"
+            << std::setw(16) << "LUONG RONG" << "\n";
+    outFile << line << "\n";
+    char period[16];
+    for (const PayAdjustment& adjustment : adjustments) {
+        if (!adjustment.hasDifference()) continue;
+        std::snprintf(period, sizeof(period), "%04d-%02d", adjustment.year, adjustment.month);
+        printRow(period, adjustment.employeeId, adjustment.difference());
+    }
+    outFile << line << "\n";
+    printRow("TONG", "", stats.totalDifference);
+}
@@ -9,6 +9,13 @@
 #include <memory>
 #include "utils.h"
 
+struct PayrollYear;
+struct PayScenario;
+struct ScenarioResult;
+struct PayAdjustment;
+struct RetroPayStats;
+struct AttendanceTotals;
+
 /**
  * @file PayrollPrinter.h
  * @brief Định nghĩa lớp PayrollPrinter, chuyên dụng để hiển thị và xuất thông tin lương.
@@ -49,17 +56,21 @@ public:
      * bắt đầu từ các tọa độ nội bộ cố định (ví dụ: dòng 5 hoặc 6).
      * @param emp Con trỏ chia sẻ (shared_ptr) đến đối tượng nhân viên.
      * @param details Đối tượng SalaryDetails chứa thông tin lương chi tiết đã được tính toán.
+     * @param attendance Số giờ/số ngày chấm công của kỳ lương.
+     * @return Dòng (Y) đầu tiên còn trống bên dưới phiếu lương.
      */
-    void printPaySlip(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details) const;
+    int printPaySlip(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details, const AttendanceTotals& attendance) const;
 
     /**
      * @brief Ghi nội dung phiếu lương chi tiết của một nhân viên ra file văn bản (TXT).
      * Định dạng file tương tự như hiển thị ra console nhưng không dùng gotoXY.
      * @param emp Con trỏ chia sẻ (shared_ptr) đến đối tượng nhân viên.
      * @param details Đối tượng SalaryDetails chứa thông tin lương chi tiết.
+     * @param attendance Số giờ/số ngày chấm công của kỳ lương.
      * @param filename Tên file (bao gồm đường dẫn nếu cần) để ghi phiếu lương.
      */
-    void printPaySlipToFile(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details, const std::string& filename) const;
+    void printPaySlipToFile(const std::shared_ptr<IEmployee>& emp, const SalaryDetails& details, const AttendanceTotals& attendance,
+                            const std::string& filename) const;
 
     /**
      * @brief In bảng lương tổng hợp của tất cả nhân viên trong danh sách payrollData ra một file văn bản.
@@ -68,6 +79,45 @@ public:
      * @param filename Tên file để xuất bảng lương tổng hợp (ví dụ: "payroll_export.txt").
      */
     void printToFile(const std::vector<std::pair<std::shared_ptr<IEmployee>, SalaryDetails>>& payrollData, const std::string& filename) const;
+
+    /**
+     * @brief In ma trận lương ròng cả năm (mỗi nhân viên một dòng, 12 cột tháng và cột cả năm) ra file.
+     * @param payrollYear Bảng lương cả năm (PayrollEngine::calculateYear()).
+     * @param filename Tên file (ví dụ: "payroll_year_2025.txt").
+     */
+    void printYearToFile(const PayrollYear& payrollYear, const std::string& filename) const;
+
+    /**
+     * @brief In bản tổng hợp cả năm ra file: tổng từng thành phần lương của mỗi tháng và của cả năm.
+     * @param payrollYear Bảng lương cả năm.
+     * @param filename Tên file (ví dụ: "payroll_year_2025_summary.txt").
+     */
+    void printYearSummaryToFile(const PayrollYear& payrollYear, const std::string& filename) const;
+
+    /**
+     * @brief In kết quả mô phỏng chi phí lương ra file: với mỗi kịch bản, tổng lương ròng và chênh lệch
+     * so với kịch bản đầu tiên (kịch bản gốc), theo nhóm nhân viên và theo thành phần lương.
+     * @param scenarios Các kịch bản (phần tử đầu tiên là kịch bản gốc).
+     * @param results Kết quả của PayrollSimulator::evaluate(), cùng thứ tự.
+     * @param employeeCount Số nhân viên được mô phỏng.
+     * @param month Tháng của số liệu chấm công.
+     * @param year Năm của số liệu chấm công.
+     * @param filename Tên file (ví dụ: "payroll_simulation.txt").
+     */
+    void printSimulationToFile(const std::vector<PayScenario>& scenarios, const std::vector<ScenarioResult>& results,
+                               std::size_t employeeCount, int month, int year, const std::string& filename) const;
+
+    /**
+     * @brief In các khoản chênh lệch lương của các kỳ đã chi trả ra file: mỗi (nhân viên, kỳ) có chênh
+     * lệch một dòng với chênh lệch từng thành phần (tính lại - đã trả), cuối file là dòng tổng.
+     * Các dòng được tính lại nhưng không có chênh lệch không được in.
+     * @param adjustments Kết quả của RetroPayEngine::calculate().
+     * @param stats Số liệu của lần tính.
+     * @param year Năm được xét.
+     * @param filename Tên file (ví dụ: "payroll_adjustments_2025.txt").
+     */
+    void printAdjustmentsToFile(const std::vector<PayAdjustment>& adjustments, const RetroPayStats& stats,
+                                int year, const std::string& filename) const;
 };
 
 #endif // PAYROLL_PRINTER_H
\ No newline at end of file
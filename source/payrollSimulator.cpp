@@ -0,0 +1,335 @@
+﻿#include "PayrollSimulator.h"
+#include "AttendanceManager.h"
+#include "IEmployee.h"
+#include "PayPolicy.h"
+#include "SalaryKernel.h"
+#include "WelfareManager.h"
+#include "BonusWelfare.h"
+#include "SocialInsuranceWelfare.h"
+#include "TransportationWelfare.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+    /**
+     * @brief Lương cơ bản/khoản cố định của nhân viên theo chính sách của nhóm (Policy::basePay()).
+     */
+    Money basePayOf(const IEmployee& employee) {
+        Money pay;
+        forEachPayPolicy([&](auto policy) {
+            using Policy = decltype(policy);
+            if (employee.getCategory() == Policy::CATEGORY) {
+                pay = Policy::basePay(static_cast<const typename Policy::Employee&>(employee));
+            }
+        });
+        return pay;
+    }
+
+    /**
+     * @brief Nhóm có được trả lương theo giờ công không (Policy::PAYS_HOURS).
+     */
+    bool paysHours(std::size_t category) {
+        bool pays = false;
+        forEachPayPolicy([&](auto policy) {
+            using Policy = decltype(policy);
+            if (static_cast<std::size_t>(Policy::CATEGORY) == category) pays = Policy::PAYS_HOURS;
+        });
+        return pays;
+    }
+
+    /**
+     * @brief Làm tròn một số tiền không âm tới đồng (nửa đồng làm tròn lên, như Money::fromDouble()).
+     */
+    inline double roundDong(double amount) {
+        return std::floor(amount + 0.5);
+    }
+
+    /**
+     * @brief Cắt khoảng trắng ở hai đầu chuỗi.
+     */
+    std::string trim(const std::string& text) {
+        const std::size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return std::string();
+        const std::size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    /**
+     * @brief Gán một tham số đơn giá ("hourly", "overtime", "holiday") cho một nhóm.
+     * @return false nếu tên tham số không hợp lệ.
+     */
+    bool setRate(PayRates& rates, const std::string& key, double value) {
+        if (key == "hourly") rates.hourlyRate = value;
+        else if (key == "overtime") rates.overtimeMultiplier = value;
+        else if (key == "holiday") rates.holidayMultiplier = value;
+        else return false;
+        return true;
+    }
+
+    /**
+     * @brief Áp một tham số `key=value` vào kịch bản.
+     * @return false nếu tên tham số không hợp lệ.
+     */
+    bool applyParameter(PayScenario& scenario, const PayScenario& base, const std::string& key, double value) {
+        if (key == "insurance") { scenario.socialInsuranceRate = value; return true; }
+        if (key == "bonus") { scenario.revenueBonus = value; return true; }
+        if (key == "km") { scenario.transportRatePerKm = value; return true; }
+
+        const std::size_t dot = key.find('.');
+        if (dot != std::string::npos) {
+            for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+                if (key.compare(0, dot, PayRateTable::categoryKey(c)) == 0) {
+                    return setRate(scenario.rates[c], key.substr(dot + 1), value);
+                }
+            }
+            return false;
+        }
+
+        // Tham số chung: chỉ áp cho các nhóm đang được trả khoản tương ứng
+        if (key != "hourly" && key != "overtime" && key != "holiday") return false;
+        for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+            if (!paysHours(c)) continue;
+            if (key == "overtime" && base.rates[c].overtimeMultiplier <= 0.0) continue;
+            if (key == "holiday" && base.rates[c].holidayMultiplier <= 0.0) continue;
+            setRate(scenario.rates[c], key, value);
+        }
+        return true;
+    }
+
+} // namespace
+
+/**
+ * @brief Cấp phát lại các cột cho `count` nhân viên.
+ */
+void PayrollSimulator::Columns::resize(std::size_t count) {
+    for (std::vector<double>* column : { &normalSeconds, &overtimeSeconds, &holidaySeconds, &basePay, &bonusEligible,
+                                         &insuranceBase, &distanceKm, &fixedBonuses, &fixedAllowances, &fixedDeductions }) {
+        column->assign(count, 0.0);
+    }
+}
+
+/**
+ * @brief Tổng hợp số liệu của kỳ lương và dựng các cột dữ liệu.
+ */
+void PayrollSimulator::load(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+                            const WelfareManager& welfareManager, int month, int year) {
+    std::vector<AttendanceSummary> summaries;
+    attendance.summarizePeriod(month, year, summaries);
+    const EmployeeIdPool& ids = attendance.getEmployeeIds();
+
+    // 1. Phúc lợi được tham số hóa: phần tử đầu tiên của mỗi loại chuẩn
+    const BonusWelfare* bonus = nullptr;
+    const SocialInsuranceWelfare* insurance = nullptr;
+    const TransportationWelfare* transport = nullptr;
+    for (const auto& welfare : welfareManager.getWelfareList()) {
+        if (!bonus) bonus = dynamic_cast<const BonusWelfare*>(welfare.get());
+        if (!insurance) insurance = dynamic_cast<const SocialInsuranceWelfare*>(welfare.get());
+        if (!transport) transport = dynamic_cast<const TransportationWelfare*>(welfare.get());
+    }
+    _revenueBonus = bonus ? bonus->getRevenueBonusAmount().toDouble() : 0.0;
+    _socialInsuranceRate = insurance ? insurance->getEmployeeContributionRate() : 0.0;
+    _transportRatePerKm = transport ? transport->getRatePerKm() : 0.0;
+
+    // 2. Vị trí của từng nhóm trong các cột
+    std::array<std::size_t, PAY_CATEGORY_COUNT> counts = {};
+    _skipped = 0;
+    for (const auto& emp : employees) {
+        if (!emp) continue;
+        const std::size_t category = static_cast<std::size_t>(emp->getCategory());
+        if (category < PAY_CATEGORY_COUNT) ++counts[category];
+        else ++_skipped;
+    }
+    _groupBegin[0] = 0;
+    for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) _groupBegin[c + 1] = _groupBegin[c] + counts[c];
+    _columns.resize(_groupBegin[PAY_CATEGORY_COUNT]);
+
+    // 3. Mỗi nhân viên một hàng trong nhóm của mình
+    std::array<std::size_t, PAY_CATEGORY_COUNT> cursor = {};
+    for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) cursor[c] = _groupBegin[c];
+    const AttendanceSummary empty;
+    for (const auto& emp : employees) {
+        if (!emp) continue;
+        const std::size_t category = static_cast<std::size_t>(emp->getCategory());
+        if (category >= PAY_CATEGORY_COUNT) continue;
+        const std::size_t row = cursor[category]++;
+        const std::uint32_t key = ids.find(emp->getEmployeeId());
+        const AttendanceSummary& summary = (key != EmployeeIdPool::npos) ? summaries[key] : empty;
+
+        _columns.normalSeconds[row] = static_cast<double>(summary.paidNormalSeconds);
+        _columns.overtimeSeconds[row] = static_cast<double>(summary.paidOvertimeSeconds);
+        _columns.holidaySeconds[row] = static_cast<double>(summary.paidHolidaySeconds);
+        _columns.basePay[row] = basePayOf(*emp).toDouble();
+
+        for (const auto& welfare : welfareManager.getWelfareList()) {
+            if (!welfare) continue;
+            const bool eligible = welfare->isEligible(*emp, summary);
+            if (welfare.get() == bonus) {
+                _columns.bonusEligible[row] = eligible ? 1.0 : 0.0;
+            } else if (welfare.get() == insurance) {
+                _columns.insuranceBase[row] = eligible ? Money::fromDouble(emp->getBaseSalary()).toDouble() : 0.0;
+            } else if (welfare.get() == transport) {
+                _columns.distanceKm[row] = eligible ? transport->getDistanceKm(*emp) : 0.0;
+            } else if (eligible) {
+                // Phúc lợi khác: tác động không phụ thuộc kịch bản, phân loại như WelfareManager
+                const Money impact = welfare->calculateImpact(*emp);
+                if (impact > Money()) {
+                    (welfare->getDetails().type == WelfareType::Bonus ? _columns.fixedBonuses : _columns.fixedAllowances)[row] += impact.toDouble();
+                } else if (impact < Money()) {
+                    _columns.fixedDeductions[row] += impact.abs().toDouble();
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Kịch bản hiện hành.
+ */
+PayScenario PayrollSimulator::baseline() const {
+    PayScenario scenario;
+    scenario.name = "Hien hanh";
+    const PayRateTable& table = PayRateTable::active();
+    for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+        const CategoryPayRates& current = table.categories[c];
+        PayRates& rates = scenario.rates[c];
+        rates.hourlyRate = current.hourlyRate.toDouble();
+        if (current.hourlyRate > Money()) {
+            rates.overtimeMultiplier = current.overtimeRate.toDouble() / rates.hourlyRate;
+            rates.holidayMultiplier = current.holidayRate.toDouble() / rates.hourlyRate;
+        }
+    }
+    scenario.socialInsuranceRate = _socialInsuranceRate;
+    scenario.revenueBonus = _revenueBonus;
+    scenario.transportRatePerKm = _transportRatePerKm;
+    return scenario;
+}
+
+/**
+ * @brief Đánh giá các kịch bản.
+ */
+void PayrollSimulator::evaluate(const std::vector<PayScenario>& scenarios, std::vector<ScenarioResult>& results) {
+    results.assign(scenarios.size(), ScenarioResult());
+
+    const unsigned threads = ThreadPool::resolveThreadCount(_threadCount);
+    const bool parallel = threads > 1 && scenarios.size() > 1
+        && scenarios.size() * getEmployeeCount() >= PARALLEL_MIN_CELLS;
+    if (!parallel) {
+        for (std::size_t s = 0; s < scenarios.size(); ++s) evaluateScenario(scenarios[s], results[s]);
+        return;
+    }
+    if (!_pool || _pool->size() != threads) {
+        _pool.reset();
+        _pool = std::make_unique<ThreadPool>(threads);
+    }
+    _pool->parallelFor(scenarios.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t s = begin; s < end; ++s) evaluateScenario(scenarios[s], results[s]);
+    });
+}
+
+/**
+ * @brief Đánh giá một kịch bản trên mọi nhóm.
+ */
+void PayrollSimulator::evaluateScenario(const PayScenario& scenario, ScenarioResult& result) const {
+    SalaryKernelRates kernelRates;
+    kernelRates.bonusAmount = roundDong(scenario.revenueBonus);
+    kernelRates.ratePerKm = scenario.transportRatePerKm;
+    kernelRates.insuranceRate = scenario.socialInsuranceRate;
+
+    SalaryDetails total;
+    for (std::size_t c = 0; c < PAY_CATEGORY_COUNT; ++c) {
+        const PayRates& rates = scenario.rates[c];
+        kernelRates.normalRate = roundDong(rates.hourlyRate);
+        kernelRates.overtimeRate = roundDong(rates.hourlyRate * rates.overtimeMultiplier);
+        kernelRates.holidayRate = roundDong(rates.hourlyRate * rates.holidayMultiplier);
+        kernelRates.paysHours = paysHours(c);
+
+        // Các cột của nhóm nằm liền nhau: cả nhóm được tính bằng một lần gọi SalaryKernel (chỉ cần tổng)
+        const std::size_t begin = _groupBegin[c];
+        SalaryKernelInput input;
+        input.normalSeconds = _columns.normalSeconds.data() + begin;
+        input.overtimeSeconds = _columns.overtimeSeconds.data() + begin;
+        input.holidaySeconds = _columns.holidaySeconds.data() + begin;
+        input.basePay = _columns.basePay.data() + begin;
+        input.bonusEligible = _columns.bonusEligible.data() + begin;
+        input.fixedBonuses = _columns.fixedBonuses.data() + begin;
+        input.distanceKm = _columns.distanceKm.data() + begin;
+        input.fixedAllowances = _columns.fixedAllowances.data() + begin;
+        input.insuranceBase = _columns.insuranceBase.data() + begin;
+        input.fixedDeductions = _columns.fixedDeductions.data() + begin;
+        SalaryKernelTotals sums;
+        SalaryKernel::compute(input, _groupBegin[c + 1] - begin, kernelRates, nullptr, sums);
+
+        SalaryDetails& group = result.byCategory[c];
+        group.basicSalary = Money::fromDouble(sums.basicSalary);
+        group.overtimeSalary = Money::fromDouble(sums.overtimeSalary);
+        group.holidaySalary = Money::fromDouble(sums.holidaySalary);
+        group.bonuses = Money::fromDouble(sums.bonuses);
+        group.allowances = Money::fromDouble(sums.allowances);
+        group.deductions = Money::fromDouble(sums.deductions);
+        group.totalSalary = Money::fromDouble(sums.totalSalary);
+
+        total.basicSalary += group.basicSalary;
+        total.overtimeSalary += group.overtimeSalary;
+        total.holidaySalary += group.holidaySalary;
+        total.bonuses += group.bonuses;
+        total.allowances += group.allowances;
+        total.deductions += group.deductions;
+        total.totalSalary += group.totalSalary;
+    }
+    result.total = total;
+}
+
+/**
+ * @brief Đọc các kịch bản từ file văn bản.
+ */
+bool PayrollSimulator::loadScenarios(const std::string& filename, const PayScenario& base, std::vector<PayScenario>& scenarios) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Loi: Khong the mo file kich ban: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        PayScenario scenario = base;
+        bool valid = true;
+        std::size_t start = 0;
+        for (std::size_t field = 0; valid; ++field) {
+            const std::size_t comma = line.find(',', start);
+            const std::string token = trim(line.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+            if (field == 0) {
+                scenario.name = token;
+                valid = !token.empty();
+            } else {
+                const std::size_t equals = token.find('=');
+                if (equals == std::string::npos) {
+                    valid = false;
+                } else {
+                    const std::string key = trim(token.substr(0, equals));
+                    const std::string text = trim(token.substr(equals + 1));
+                    char* end = nullptr;
+                    const double value = std::strtod(text.c_str(), &end);
+                    valid = !text.empty() && *end == '\0' && std::isfinite(value) && value >= 0.0
+                         && applyParameter(scenario, base, key, value);
+                }
+            }
+            if (!valid) {
+                std::cerr << "CANH BAO: " << filename << " dong " << lineNumber << ": "
+                          << (field == 0 ? "thieu ten kich ban" : "tham so khong hop le '" + token + "'")
+                          << ", bo qua dong." << std::endl;
+            }
+            if (comma == std::string::npos) break;
+            start = comma + 1;
+        }
+        if (valid) scenarios.push_back(scenario);
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+﻿#ifndef PAYROLL_SIMULATOR_H
+#define PAYROLL_SIMULATOR_H
+
+#include "GlobalDefinitions.h"
+#include "ThreadPool.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class IEmployee;
+class AttendanceManager;
+class WelfareManager;
+
+/**
+ * @file PayrollSimulator.h
+ * @brief Định nghĩa lớp PayrollSimulator, mô phỏng chi phí lương khi thay đổi đơn giá, hệ số và tham số phúc lợi.
+ */
+
+/**
+ * @struct PayRates
+ * @brief Đơn giá giờ công của một nhóm nhân viên trong một kịch bản.
+ */
+struct PayRates {
+    double hourlyRate = 0.0;         ///< @brief Đơn giá giờ thường (đồng/giờ).
+    double overtimeMultiplier = 0.0; ///< @brief Hệ số giờ tăng ca so với giờ thường (0 = không trả).
+    double holidayMultiplier = 0.0;  ///< @brief Hệ số giờ ngày lễ so với giờ thường (0 = không trả).
+};
+
+/**
+ * @struct PayScenario
+ * @brief Một kịch bản "nếu thì": đơn giá theo nhóm nhân viên và tham số của các phúc lợi chuẩn.
+ * Đơn giá mỗi giờ được làm tròn tới đồng trước khi nhân với số giờ (giống PayRateTable::loadFromFile()).
+ */
+struct PayScenario {
+    std::string name;                                ///< @brief Tên kịch bản.
+    std::array<PayRates, PAY_CATEGORY_COUNT> rates;  ///< @brief Đơn giá theo EmployeeCategory.
+    double socialInsuranceRate = 0.0;                ///< @brief Tỷ lệ đóng BHXH của nhân viên (SocialInsuranceWelfare).
+    double revenueBonus = 0.0;                       ///< @brief Tiền thưởng doanh thu (BonusWelfare).
+    double transportRatePerKm = 0.0;                 ///< @brief Phụ cấp đi lại mỗi km (TransportationWelfare).
+};
+
+/**
+ * @struct ScenarioResult
+ * @brief Tổng chi phí lương của một kịch bản: tổng từng thành phần (SalaryDetails) của cả công ty và của từng nhóm.
+ */
+struct ScenarioResult {
+    SalaryDetails total;                                   ///< @brief Tổng của mọi nhân viên được mô phỏng.
+    std::array<SalaryDetails, PAY_CATEGORY_COUNT> byCategory; ///< @brief Tổng theo EmployeeCategory.
+};
+
+/**
+ * @class PayrollSimulator
+ * @brief Đánh giá hàng trăm kịch bản đơn giá/hệ số/phúc lợi trên số liệu giờ công đã tổng hợp một lần.
+ *
+ * load() tổng hợp chấm công của kỳ lương (AttendanceManager::summarizePeriod()) và lưu mọi thứ một
+ * kịch bản cần theo dạng cột (mỗi đại lượng một mảng double liên tiếp, nhân viên được xếp liền
+ * nhau theo nhóm): số giây giờ thường/tăng ca/ngày lễ, lương cơ bản, điều kiện thưởng, lương đóng
+ * BHXH, khoảng cách đi lại, và tác động cố định của các phúc lợi khác. Mỗi kịch bản sau đó chỉ là
+ * một lần gọi SalaryKernel cho mỗi nhóm (số học trên các cột, AVX2 nếu CPU hỗ trợ), không tra cứu
+ * chấm công, không gọi hàm ảo.
+ *
+ * Ba phúc lợi chuẩn (BonusWelfare, SocialInsuranceWelfare, TransportationWelfare; phần tử đầu
+ * tiên của mỗi loại trong WelfareManager) được tham số hóa theo kịch bản; các phúc lợi khác giữ
+ * nguyên tác động đã tính lúc load(). Mọi thành phần được làm tròn tới đồng như khi tính lương
+ * thật, nên kịch bản baseline() cho đúng tổng bảng lương của PayrollEngine cho cùng kỳ.
+ * Nhân viên có nhóm ngoài EmployeeCategory không được mô phỏng (xem getSkippedCount()).
+ *
+ * Với nhiều kịch bản, các kịch bản được đánh giá song song trên ThreadPool; mỗi kịch bản ghi vào
+ * đúng phần tử kết quả của mình nên kết quả không phụ thuộc số luồng.
+ */
+class PayrollSimulator {
+public:
+    /**
+     * @brief Tổng hợp số liệu của kỳ lương và dựng các cột dữ liệu (thay cho dữ liệu của lần load() trước).
+     * @param employees Danh sách nhân viên (con trỏ null bị bỏ qua).
+     * @param attendance Dữ liệu chấm công đã tải.
+     * @param welfareManager Danh sách phúc lợi đang áp dụng.
+     * @param month Tháng (1-12).
+     * @param year Năm.
+     */
+    void load(const std::vector<std::shared_ptr<IEmployee>>& employees, const AttendanceManager& attendance,
+              const WelfareManager& welfareManager, int month, int year);
+
+    /**
+     * @brief Kịch bản hiện hành: đơn giá của bảng đơn giá đang áp dụng (PayRateTable::active()) và tham số của các phúc lợi chuẩn tìm thấy lúc load().
+     */
+    PayScenario baseline() const;
+
+    /**
+     * @brief Đánh giá các kịch bản.
+     * @param scenarios Các kịch bản.
+     * @param results Kết quả theo đúng thứ tự kịch bản (được gán lại).
+     */
+    void evaluate(const std::vector<PayScenario>& scenarios, std::vector<ScenarioResult>& results);
+
+    /**
+     * @brief Đọc các kịch bản từ file văn bản, mỗi dòng một kịch bản:
+     * `Ten kich ban, tham_so=gia_tri, ...`. Tham số không ghi giữ nguyên giá trị của `base`.
+     * - `hourly` (đồng/giờ): đơn giá giờ thường của các nhóm tính lương theo giờ;
+     * - `overtime`, `holiday`: hệ số tăng ca/ngày lễ của các nhóm đang được trả hệ số đó;
+     * - `fulltime.<tham_so>`, `contractual.<tham_so>`, `intern.<tham_so>`: chỉ cho một nhóm;
+     * - `insurance` (tỷ lệ BHXH), `bonus` (đồng), `km` (đồng/km).
+     * Dòng trống và dòng bắt đầu bằng '#' được bỏ qua; dòng lỗi được cảnh báo và bỏ qua.
+     * @param filename Tên file.
+     * @param base Kịch bản gốc (thường là baseline()).
+     * @param scenarios Các kịch bản đọc được được thêm vào cuối.
+     * @return false nếu không mở được file.
+     */
+    static bool loadScenarios(const std::string& filename, const PayScenario& base, std::vector<PayScenario>& scenarios);
+
+    /** @brief Số nhân viên được mô phỏng. */
+    std::size_t getEmployeeCount() const { return _groupBegin[PAY_CATEGORY_COUNT]; }
+
+    /** @brief Số nhân viên bị bỏ qua vì có nhóm ngoài EmployeeCategory. */
+    std::size_t getSkippedCount() const { return _skipped; }
+
+    /**
+     * @brief Đặt số luồng dùng để đánh giá kịch bản (0 = theo số lõi CPU, 1 = tuần tự).
+     */
+    void setThreadCount(unsigned threadCount) { _threadCount = threadCount; }
+
+    /** @brief Số ô (kịch bản x nhân viên) tối thiểu để đánh giá song song. */
+    static constexpr std::size_t PARALLEL_MIN_CELLS = 1 << 18;
+
+private:
+    /**
+     * @struct Columns
+     * @brief Dữ liệu của mọi nhân viên theo cột; nhân viên của nhóm c nằm ở [_groupBegin[c], _groupBegin[c + 1]).
+     * Mọi giá trị là số nguyên (giây hoặc đồng) biểu diễn chính xác bằng double.
+     */
+    struct Columns {
+        std::vector<double> normalSeconds;   ///< @brief Số giây tính lương giờ thường.
+        std::vector<double> overtimeSeconds; ///< @brief Số giây tính lương tăng ca.
+        std::vector<double> holidaySeconds;  ///< @brief Số giây tính lương ngày lễ.
+        std::vector<double> basePay;         ///< @brief Lương cơ bản/khoản cố định (đồng).
+        std::vector<double> bonusEligible;   ///< @brief 1 nếu đủ điều kiện thưởng doanh thu, 0 nếu không.
+        std::vector<double> insuranceBase;   ///< @brief Lương đóng BHXH (0 nếu không đủ điều kiện).
+        std::vector<double> distanceKm;      ///< @brief Khoảng cách đi lại (0 nếu không đủ điều kiện).
+        std::vector<double> fixedBonuses;    ///< @brief Thưởng từ các phúc lợi không được tham số hóa.
+        std::vector<double> fixedAllowances; ///< @brief Phụ cấp từ các phúc lợi không được tham số hóa.
+        std::vector<double> fixedDeductions; ///< @brief Khấu trừ từ các phúc lợi không được tham số hóa.
+
+        void resize(std::size_t count);
+    };
+
+    Columns _columns;                                      ///< @brief Dữ liệu theo cột của kỳ đã load().
+    std::array<std::size_t, PAY_CATEGORY_COUNT + 1> _groupBegin = {}; ///< @brief Vị trí bắt đầu của từng nhóm trong các cột.
+    std::size_t _skipped = 0;                              ///< @brief Số nhân viên không được mô phỏng.
+    double _socialInsuranceRate = 0.0;                     ///< @brief Tỷ lệ BHXH hiện hành.
+    double _revenueBonus = 0.0;                            ///< @brief Thưởng doanh thu hiện hành.
+    double _transportRatePerKm = 0.0;                      ///< @brief Phụ cấp mỗi km hiện hành.
+    unsigned _threadCount = 0;                             ///< @brief Số luồng đã cấu hình.
+    std::unique_ptr<ThreadPool> _pool;                     ///< @brief Nhóm luồng, tạo ở lần đánh giá song song đầu tiên.
+
+    /**
+     * @brief Đánh giá một kịch bản trên mọi nhóm.
+     */
+    void evaluateScenario(const PayScenario& scenario, ScenarioResult& result) const;
+};
+
+#endif // PAYROLL_SIMULATOR_H
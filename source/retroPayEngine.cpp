@@ -0,0 +1,146 @@
+﻿#include "RetroPayEngine.h"
+#include "PayrollHistory.h"
+#include "AttendanceManager.h"
+#include "IEmployee.h"
+#include "WelfareManager.h"
+#include "PayRateTable.h"
+#include <unordered_map>
+
+namespace {
+
+    /**
+     * @struct EmployeeEntry
+     * @brief Nhân viên hiện tại và dấu vân tay hồ sơ (tính một lần, khi cần).
+     */
+    struct EmployeeEntry {
+        const IEmployee* employee = nullptr;
+        std::uint64_t recordFingerprint = 0;
+        bool hasFingerprint = false;
+    };
+
+} // namespace
+
+/**
+ * @brief Chênh lệch từng thành phần.
+ */
+SalaryDetails PayAdjustment::difference() const {
+    SalaryDetails d;
+    d.basicSalary = recalculated.basicSalary - paid.basicSalary;
+    d.overtimeSalary = recalculated.overtimeSalary - paid.overtimeSalary;
+    d.holidaySalary = recalculated.holidaySalary - paid.holidaySalary;
+    d.bonuses = recalculated.bonuses - paid.bonuses;
+    d.allowances = recalculated.allowances - paid.allowances;
+    d.deductions = recalculated.deductions - paid.deductions;
+    d.totalSalary = recalculated.totalSalary - paid.totalSalary;
+    return d;
+}
+
+/**
+ * @brief Có khoản nào khác với số đã trả không.
+ */
+bool PayAdjustment::hasDifference() const {
+    return recalculated.basicSalary != paid.basicSalary || recalculated.overtimeSalary != paid.overtimeSalary
+        || recalculated.holidaySalary != paid.holidaySalary || recalculated.bonuses != paid.bonuses
+        || recalculated.allowances != paid.allowances || recalculated.deductions != paid.deductions
+        || recalculated.totalSalary != paid.totalSalary;
+}
+
+/**
+ * @brief Tính chênh lệch của các kỳ đã chi trả trong một năm.
+ */
+RetroPayStats RetroPayEngine::calculate(const PayrollHistory& history, const std::vector<std::shared_ptr<IEmployee>>& employees,
+                                        const AttendanceManager& attendance, const WelfareManager& welfareManager, int year,
+                                        std::vector<PayAdjustment>& adjustments) {
+    RetroPayStats stats;
+    adjustments.clear();
+
+    // 1. Một lần duyệt số liệu chấm công của cả năm
+    attendance.summarizeYear(year, _summaries);
+    const EmployeeIdPool& ids = attendance.getEmployeeIds();
+    const std::size_t stride = ids.size();
+    const std::uint64_t rateFingerprint = PayrollHistory::rateFingerprint(PayRateTable::active());
+
+    // 2. Tra nhân viên theo mã
+    std::unordered_map<std::string, EmployeeEntry> current;
+    current.reserve(employees.size());
+    for (const auto& emp : employees) {
+        if (emp) current[emp->getEmployeeId()].employee = emp.get();
+    }
+
+    const AttendanceSummary empty;
+    for (int month = 1; month <= 12; ++month) {
+        const std::vector<PaidPayroll>* paid = history.findPeriod(month, year);
+        if (!paid) continue;
+        ++stats.periods;
+        const AttendanceSummary* monthSummaries = _summaries.data() + static_cast<std::size_t>(month - 1) * stride;
+
+        for (std::size_t i = 0; i < paid->size(); ++i) {
+            const PaidPayroll& entry = (*paid)[i];
+            ++stats.checked;
+            auto it = current.find(entry.employeeId);
+            if (it == current.end()) {
+                ++stats.missingEmployees;
+                continue;
+            }
+            EmployeeEntry& employee = it->second;
+
+            // 3. So dấu vân tay: cùng dữ liệu đầu vào thì cùng lương, không cần tính lại
+            const std::uint32_t key = ids.find(entry.employeeId);
+            const AttendanceSummary& summary = (key != EmployeeIdPool::npos) ? monthSummaries[key] : empty;
+            const std::uint64_t attendanceFingerprint = PayrollHistory::attendanceFingerprint(summary);
+            if (!employee.hasFingerprint) {
+                employee.recordFingerprint = PayrollHistory::recordFingerprint(*employee.employee);
+                employee.hasFingerprint = true;
+            }
+            if (attendanceFingerprint == entry.attendanceFingerprint && employee.recordFingerprint == entry.recordFingerprint
+                && rateFingerprint == entry.rateFingerprint) {
+                continue;
+            }
+
+            // 4. Tính lại (giống PayrollEngine) và so với số đã trả
+            PayAdjustment adjustment;
+            adjustment.employeeId = entry.employeeId;
+            adjustment.month = month;
+            adjustment.year = year;
+            adjustment.paid = entry.details;
+            adjustment.attendanceFingerprint = attendanceFingerprint;
+            adjustment.recordFingerprint = employee.recordFingerprint;
+            adjustment.rateFingerprint = rateFingerprint;
+            adjustment.historyIndex = i;
+            Money bonuses, allowances, deductions;
+            welfareManager.calculateAllWelfareForEmployee(*employee.employee, summary, bonuses, allowances, deductions);
+            adjustment.recalculated = employee.employee->calculateSalary(summary, bonuses, allowances, deductions);
+
+            ++stats.recalculated;
+            if (adjustment.hasDifference()) {
+                ++stats.adjusted;
+                const SalaryDetails d = adjustment.difference();
+                stats.totalDifference.basicSalary += d.basicSalary;
+                stats.totalDifference.overtimeSalary += d.overtimeSalary;
+                stats.totalDifference.holidaySalary += d.holidaySalary;
+                stats.totalDifference.bonuses += d.bonuses;
+                stats.totalDifference.allowances += d.allowances;
+                stats.totalDifference.deductions += d.deductions;
+                stats.totalDifference.totalSalary += d.totalSalary;
+            }
+            adjustments.push_back(std::move(adjustment));
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief Ghi nhận các khoản tính lại là đã chi trả.
+ */
+void RetroPayEngine::accept(PayrollHistory& history, const std::vector<PayAdjustment>& adjustments) {
+    for (const PayAdjustment& adjustment : adjustments) {
+        std::vector<PaidPayroll>* paid = history.findPeriod(adjustment.month, adjustment.year);
+        if (!paid || adjustment.historyIndex >= paid->size()) continue;
+        PaidPayroll& entry = (*paid)[adjustment.historyIndex];
+        if (entry.employeeId != adjustment.employeeId) continue;
+        entry.details = adjustment.recalculated;
+        entry.attendanceFingerprint = adjustment.attendanceFingerprint;
+        entry.recordFingerprint = adjustment.recordFingerprint;
+        entry.rateFingerprint = adjustment.rateFingerprint;
+    }
+}
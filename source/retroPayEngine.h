@@ -0,0 +1,96 @@
+﻿#ifndef RETRO_PAY_ENGINE_H
+#define RETRO_PAY_ENGINE_H
+
+#include "GlobalDefinitions.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class IEmployee;
+class AttendanceManager;
+class WelfareManager;
+class PayrollHistory;
+
+/**
+ * @file RetroPayEngine.h
+ * @brief Định nghĩa lớp RetroPayEngine, tính chênh lệch lương truy lĩnh/truy thu của các kỳ đã chi trả.
+ */
+
+/**
+ * @struct PayAdjustment
+ * @brief Một (nhân viên, kỳ) đã chi trả được tính lại vì dữ liệu đầu vào thay đổi.
+ */
+struct PayAdjustment {
+    std::string employeeId;                  ///< @brief Mã nhân viên.
+    int month = 0;                           ///< @brief Tháng của kỳ lương.
+    int year = 0;                            ///< @brief Năm của kỳ lương.
+    SalaryDetails paid;                      ///< @brief Các khoản đã chi trả.
+    SalaryDetails recalculated;              ///< @brief Các khoản tính lại theo dữ liệu hiện tại.
+    std::uint64_t attendanceFingerprint = 0; ///< @brief Dấu vân tay chấm công hiện tại.
+    std::uint64_t recordFingerprint = 0;     ///< @brief Dấu vân tay hồ sơ hiện tại.
+    std::uint64_t rateFingerprint = 0;       ///< @brief Dấu vân tay bảng đơn giá đang áp dụng.
+    std::size_t historyIndex = 0;            ///< @brief Vị trí của dòng trong PayrollHistory::findPeriod(month, year).
+
+    /** @brief Chênh lệch từng thành phần (tính lại - đã trả). */
+    SalaryDetails difference() const;
+
+    /** @brief Có khoản nào khác với số đã trả không. */
+    bool hasDifference() const;
+};
+
+/**
+ * @struct RetroPayStats
+ * @brief Số liệu của một lần tính chênh lệch.
+ */
+struct RetroPayStats {
+    std::size_t periods = 0;          ///< @brief Số kỳ đã chi trả được xét.
+    std::size_t checked = 0;          ///< @brief Số dòng (nhân viên x kỳ) đã chi trả được xét.
+    std::size_t recalculated = 0;     ///< @brief Số dòng có dữ liệu đầu vào thay đổi, phải tính lại.
+    std::size_t adjusted = 0;         ///< @brief Số dòng có chênh lệch khác 0.
+    std::size_t missingEmployees = 0; ///< @brief Số dòng của nhân viên không còn trong danh sách (bỏ qua).
+    SalaryDetails totalDifference;    ///< @brief Tổng chênh lệch từng thành phần.
+};
+
+/**
+ * @class RetroPayEngine
+ * @brief Tính chênh lệch giữa lương đã chi trả (PayrollHistory) và lương tính lại theo dữ liệu chấm công,
+ * hồ sơ hiện tại, chỉ cho các (nhân viên, kỳ) có dữ liệu đầu vào thay đổi.
+ *
+ * Số liệu chấm công của cả năm được tổng hợp bằng một lần duyệt (AttendanceManager::summarizeYear()).
+ * Với mỗi dòng đã chi trả, dấu vân tay số liệu tổng hợp, hồ sơ hiện tại và bảng đơn giá đang áp dụng
+ * được so với dấu vân tay lúc chi trả; chỉ khi khác mới tính lại lương (cùng cách tính với PayrollEngine,
+ * theo bảng đơn giá đang áp dụng). Đổi bảng đơn giá (EmployeeManager::reloadPayRates()) vì vậy có hiệu lực
+ * hồi tố: mọi dòng đã trả theo bảng cũ đều được tính lại, không chỉ các dòng có chấm công thay đổi. Nhờ vậy xử lý lại một năm chấm công điều chỉnh chỉ tốn một lần quét dữ liệu và một phép
+ * băm cho mỗi dòng, cộng với chi phí tính lương của các dòng thực sự thay đổi.
+ */
+class RetroPayEngine {
+public:
+    /**
+     * @brief Tính chênh lệch của các kỳ đã chi trả trong một năm.
+     * @param history Lịch sử chi trả.
+     * @param employees Danh sách nhân viên hiện tại.
+     * @param attendance Dữ liệu chấm công đã tải (phải có dữ liệu của cả năm).
+     * @param welfareManager Danh sách phúc lợi đang áp dụng.
+     * @param year Năm cần xét.
+     * @param adjustments Các dòng đã tính lại (kể cả dòng không có chênh lệch), theo kỳ rồi theo thứ tự trong lịch sử (được gán lại).
+     * @return Số liệu của lần tính.
+     */
+    RetroPayStats calculate(const PayrollHistory& history, const std::vector<std::shared_ptr<IEmployee>>& employees,
+                            const AttendanceManager& attendance, const WelfareManager& welfareManager, int year,
+                            std::vector<PayAdjustment>& adjustments);
+
+    /**
+     * @brief Ghi nhận các khoản tính lại là đã chi trả: cập nhật số tiền và dấu vân tay trong lịch sử,
+     * để lần tính sau chỉ còn các thay đổi mới.
+     * @param history Lịch sử chi trả.
+     * @param adjustments Kết quả của calculate() trên cùng lịch sử.
+     */
+    static void accept(PayrollHistory& history, const std::vector<PayAdjustment>& adjustments);
+
+private:
+    std::vector<AttendanceSummary> _summaries; ///< @brief Vùng nhớ dùng lại cho số liệu tổng hợp của năm.
+};
+
+#endif // RETRO_PAY_ENGINE_H
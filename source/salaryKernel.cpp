@@ -0,0 +1,246 @@
+﻿#include "SalaryKernel.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SALARY_KERNEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define SALARY_KERNEL_X86 0
+#endif
+
+// GCC/Clang chỉ sinh lệnh AVX2 trong hàm được đánh dấu; MSVC cho dùng intrinsic AVX2 ở mọi hàm
+#if SALARY_KERNEL_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SALARY_KERNEL_AVX2 __attribute__((target("avx2")))
+#else
+#define SALARY_KERNEL_AVX2
+#endif
+
+namespace {
+
+    /**
+     * @brief Làm tròn một số không âm tới số nguyên, nửa đơn vị làm tròn lên.
+     */
+    inline double roundHalfUp(double value) {
+        return std::floor(value + 0.5);
+    }
+
+    /**
+     * @brief Vòng lặp vô hướng, biên dịch riêng cho từng tổ hợp (trả theo giờ, ghi kết quả theo cột).
+     */
+    template <bool PaysHours, bool WriteRows>
+    void scalarLoop(const SalaryKernelInput& in, std::size_t begin, std::size_t end, const SalaryKernelRates& rates,
+                    const SalaryKernelOutput* out, SalaryKernelTotals& totals) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const double bonuses = in.bonusEligible[i] * rates.bonusAmount + in.fixedBonuses[i];
+            const double allowances = roundHalfUp(in.distanceKm[i] * rates.ratePerKm) + in.fixedAllowances[i];
+            const double deductions = roundHalfUp(in.insuranceBase[i] * rates.insuranceRate) + in.fixedDeductions[i];
+            double basic, overtime, holiday, net;
+            if constexpr (PaysHours) {
+                basic = roundHalfUp(in.normalSeconds[i] * rates.normalRate / 3600.0);
+                overtime = roundHalfUp(in.overtimeSeconds[i] * rates.overtimeRate / 3600.0);
+                holiday = roundHalfUp(in.holidaySeconds[i] * rates.holidayRate / 3600.0);
+                net = in.basePay[i] + basic + overtime + holiday + bonuses + allowances - deductions;
+            } else {
+                basic = in.basePay[i];
+                overtime = 0.0;
+                holiday = 0.0;
+                net = basic + bonuses + allowances - deductions;
+            }
+            if constexpr (WriteRows) {
+                out->basicSalary[i] = basic;
+                out->overtimeSalary[i] = overtime;
+                out->holidaySalary[i] = holiday;
+                out->bonuses[i] = bonuses;
+                out->allowances[i] = allowances;
+                out->deductions[i] = deductions;
+                out->totalSalary[i] = net;
+            }
+            totals.basicSalary += basic;
+            totals.overtimeSalary += overtime;
+            totals.holidaySalary += holiday;
+            totals.bonuses += bonuses;
+            totals.allowances += allowances;
+            totals.deductions += deductions;
+            totals.totalSalary += net;
+        }
+    }
+
+    /**
+     * @brief Chọn đúng bản biên dịch của scalarLoop().
+     */
+    void scalarRange(const SalaryKernelInput& in, std::size_t begin, std::size_t end, const SalaryKernelRates& rates,
+                     const SalaryKernelOutput* out, SalaryKernelTotals& totals) {
+        if (rates.paysHours) {
+            if (out) scalarLoop<true, true>(in, begin, end, rates, out, totals);
+            else scalarLoop<true, false>(in, begin, end, rates, out, totals);
+        } else {
+            if (out) scalarLoop<false, true>(in, begin, end, rates, out, totals);
+            else scalarLoop<false, false>(in, begin, end, rates, out, totals);
+        }
+    }
+
+#if SALARY_KERNEL_X86
+
+    /**
+     * @brief Làm tròn 4 số không âm tới số nguyên, nửa đơn vị làm tròn lên (giống roundHalfUp()).
+     */
+    SALARY_KERNEL_AVX2 inline __m256d roundHalfUp4(__m256d value) {
+        return _mm256_floor_pd(_mm256_add_pd(value, _mm256_set1_pd(0.5)));
+    }
+
+    /**
+     * @brief Tổng 4 phần tử của một thanh ghi.
+     */
+    SALARY_KERNEL_AVX2 inline double horizontalSum(__m256d value) {
+        const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+
+    /**
+     * @brief Vòng lặp AVX2: 4 nhân viên mỗi bước; phần dư (< 4) do scalarLoop() tính.
+     */
+    template <bool PaysHours, bool WriteRows>
+    SALARY_KERNEL_AVX2 void avx2Loop(const SalaryKernelInput& in, std::size_t count, const SalaryKernelRates& rates,
+                                     const SalaryKernelOutput* out, SalaryKernelTotals& totals) {
+        const __m256d hourSeconds = _mm256_set1_pd(3600.0);
+        const __m256d normalRate = _mm256_set1_pd(rates.normalRate);
+        const __m256d overtimeRate = _mm256_set1_pd(rates.overtimeRate);
+        const __m256d holidayRate = _mm256_set1_pd(rates.holidayRate);
+        const __m256d bonusAmount = _mm256_set1_pd(rates.bonusAmount);
+        const __m256d ratePerKm = _mm256_set1_pd(rates.ratePerKm);
+        const __m256d insuranceRate = _mm256_set1_pd(rates.insuranceRate);
+
+        __m256d sumBasic = _mm256_setzero_pd(), sumOvertime = _mm256_setzero_pd(), sumHoliday = _mm256_setzero_pd();
+        __m256d sumBonuses = _mm256_setzero_pd(), sumAllowances = _mm256_setzero_pd(), sumDeductions = _mm256_setzero_pd();
+        __m256d sumNet = _mm256_setzero_pd();
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m256d bonuses = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(in.bonusEligible + i), bonusAmount),
+                                                  _mm256_loadu_pd(in.fixedBonuses + i));
+            const __m256d allowances = _mm256_add_pd(roundHalfUp4(_mm256_mul_pd(_mm256_loadu_pd(in.distanceKm + i), ratePerKm)),
+                                                     _mm256_loadu_pd(in.fixedAllowances + i));
+            const __m256d deductions = _mm256_add_pd(roundHalfUp4(_mm256_mul_pd(_mm256_loadu_pd(in.insuranceBase + i), insuranceRate)),
+                                                     _mm256_loadu_pd(in.fixedDeductions + i));
+            const __m256d basePay = _mm256_loadu_pd(in.basePay + i);
+            __m256d basic, overtime, holiday, net;
+            if constexpr (PaysHours) {
+                basic = roundHalfUp4(_mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(in.normalSeconds + i), normalRate), hourSeconds));
+                overtime = roundHalfUp4(_mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(in.overtimeSeconds + i), overtimeRate), hourSeconds));
+                holiday = roundHalfUp4(_mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(in.holidaySeconds + i), holidayRate), hourSeconds));
+                net = _mm256_add_pd(_mm256_add_pd(basePay, basic), _mm256_add_pd(overtime, holiday));
+            } else {
+                basic = basePay;
+                overtime = _mm256_setzero_pd();
+                holiday = _mm256_setzero_pd();
+                net = basic;
+            }
+            net = _mm256_sub_pd(_mm256_add_pd(net, _mm256_add_pd(bonuses, allowances)), deductions);
+
+            if constexpr (WriteRows) {
+                _mm256_storeu_pd(out->basicSalary + i, basic);
+                _mm256_storeu_pd(out->overtimeSalary + i, overtime);
+                _mm256_storeu_pd(out->holidaySalary + i, holiday);
+                _mm256_storeu_pd(out->bonuses + i, bonuses);
+                _mm256_storeu_pd(out->allowances + i, allowances);
+                _mm256_storeu_pd(out->deductions + i, deductions);
+                _mm256_storeu_pd(out->totalSalary + i, net);
+            }
+            sumBasic = _mm256_add_pd(sumBasic, basic);
+            sumOvertime = _mm256_add_pd(sumOvertime, overtime);
+            sumHoliday = _mm256_add_pd(sumHoliday, holiday);
+            sumBonuses = _mm256_add_pd(sumBonuses, bonuses);
+            sumAllowances = _mm256_add_pd(sumAllowances, allowances);
+            sumDeductions = _mm256_add_pd(sumDeductions, deductions);
+            sumNet = _mm256_add_pd(sumNet, net);
+        }
+
+        totals.basicSalary += horizontalSum(sumBasic);
+        totals.overtimeSalary += horizontalSum(sumOvertime);
+        totals.holidaySalary += horizontalSum(sumHoliday);
+        totals.bonuses += horizontalSum(sumBonuses);
+        totals.allowances += horizontalSum(sumAllowances);
+        totals.deductions += horizontalSum(sumDeductions);
+        totals.totalSalary += horizontalSum(sumNet);
+        scalarLoop<PaysHours, WriteRows>(in, i, count, rates, out, totals);
+    }
+
+    /**
+     * @brief Kiểm tra AVX2 (CPU) và trạng thái YMM được hệ điều hành lưu (XCR0).
+     */
+    bool detectAvx2() {
+#ifdef _MSC_VER
+        int info[4] = {};
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        // __builtin_cpu_supports kiểm tra cả cờ CPU lẫn XCR0
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+#endif // SALARY_KERNEL_X86
+
+} // namespace
+
+/**
+ * @brief Tính các thành phần lương bằng nhánh nhanh nhất được hỗ trợ.
+ */
+void SalaryKernel::compute(const SalaryKernelInput& input, std::size_t count, const SalaryKernelRates& rates,
+                           const SalaryKernelOutput* output, SalaryKernelTotals& totals) {
+    if (hasAvx2()) {
+        computeAvx2(input, count, rates, output, totals);
+    } else {
+        computeScalar(input, count, rates, output, totals);
+    }
+}
+
+/**
+ * @brief Phiên bản vô hướng.
+ */
+void SalaryKernel::computeScalar(const SalaryKernelInput& input, std::size_t count, const SalaryKernelRates& rates,
+                                 const SalaryKernelOutput* output, SalaryKernelTotals& totals) {
+    totals = SalaryKernelTotals();
+    scalarRange(input, 0, count, rates, output, totals);
+}
+
+/**
+ * @brief Phiên bản AVX2.
+ */
+void SalaryKernel::computeAvx2(const SalaryKernelInput& input, std::size_t count, const SalaryKernelRates& rates,
+                               const SalaryKernelOutput* output, SalaryKernelTotals& totals) {
+    totals = SalaryKernelTotals();
+#if SALARY_KERNEL_X86
+    if (rates.paysHours) {
+        if (output) avx2Loop<true, true>(input, count, rates, output, totals);
+        else avx2Loop<true, false>(input, count, rates, output, totals);
+    } else {
+        if (output) avx2Loop<false, true>(input, count, rates, output, totals);
+        else avx2Loop<false, false>(input, count, rates, output, totals);
+    }
+#else
+    scalarRange(input, 0, count, rates, output, totals);
+#endif
+}
+
+/**
+ * @brief Kiểm tra AVX2 (kết quả được tính một lần).
+ */
+bool SalaryKernel::hasAvx2() {
+#if SALARY_KERNEL_X86
+    static const bool supported = detectAvx2();
+    return supported;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,119 @@
+﻿#ifndef SALARY_KERNEL_H
+#define SALARY_KERNEL_H
+
+#include <cstddef>
+
+/**
+ * @file SalaryKernel.h
+ * @brief Định nghĩa lớp SalaryKernel, tính các thành phần lương của cả một nhóm nhân viên trên dữ liệu dạng cột.
+ */
+
+/**
+ * @struct SalaryKernelInput
+ * @brief Dữ liệu đầu vào theo cột (mỗi con trỏ trỏ tới `count` phần tử liên tiếp).
+ * Mọi giá trị là số nguyên (giây hoặc đồng) biểu diễn chính xác bằng double.
+ */
+struct SalaryKernelInput {
+    const double* normalSeconds = nullptr;   ///< @brief Số giây tính lương giờ thường.
+    const double* overtimeSeconds = nullptr; ///< @brief Số giây tính lương tăng ca.
+    const double* holidaySeconds = nullptr;  ///< @brief Số giây tính lương ngày lễ.
+    const double* basePay = nullptr;         ///< @brief Lương cơ bản/khoản cố định (đồng).
+    const double* bonusEligible = nullptr;   ///< @brief 1 nếu được thưởng, 0 nếu không.
+    const double* fixedBonuses = nullptr;    ///< @brief Thưởng cố định cộng thêm (đồng).
+    const double* distanceKm = nullptr;      ///< @brief Khoảng cách được phụ cấp đi lại (km).
+    const double* fixedAllowances = nullptr; ///< @brief Phụ cấp cố định cộng thêm (đồng).
+    const double* insuranceBase = nullptr;   ///< @brief Lương đóng BHXH (đồng).
+    const double* fixedDeductions = nullptr; ///< @brief Khấu trừ cố định cộng thêm (đồng).
+};
+
+/**
+ * @struct SalaryKernelRates
+ * @brief Tham số chung của cả nhóm.
+ */
+struct SalaryKernelRates {
+    double normalRate = 0.0;    ///< @brief Đơn giá giờ thường (đồng/giờ, số nguyên).
+    double overtimeRate = 0.0;  ///< @brief Đơn giá giờ tăng ca (đồng/giờ, số nguyên).
+    double holidayRate = 0.0;   ///< @brief Đơn giá giờ ngày lễ (đồng/giờ, số nguyên).
+    bool paysHours = true;      ///< @brief false: lương chỉ là khoản cố định, hiển thị ở cột lương làm việc.
+    double bonusAmount = 0.0;   ///< @brief Tiền thưởng khi đủ điều kiện (đồng, số nguyên).
+    double ratePerKm = 0.0;     ///< @brief Phụ cấp mỗi km (đồng).
+    double insuranceRate = 0.0; ///< @brief Tỷ lệ BHXH.
+};
+
+/**
+ * @struct SalaryKernelOutput
+ * @brief Kết quả theo cột (mỗi con trỏ trỏ tới `count` phần tử), cùng ý nghĩa với các trường của SalaryDetails.
+ */
+struct SalaryKernelOutput {
+    double* basicSalary = nullptr;
+    double* overtimeSalary = nullptr;
+    double* holidaySalary = nullptr;
+    double* bonuses = nullptr;
+    double* allowances = nullptr;
+    double* deductions = nullptr;
+    double* totalSalary = nullptr;
+};
+
+/**
+ * @struct SalaryKernelTotals
+ * @brief Tổng từng thành phần lương của cả nhóm (số nguyên đồng, chính xác khi nhỏ hơn 2^53).
+ */
+struct SalaryKernelTotals {
+    double basicSalary = 0.0;
+    double overtimeSalary = 0.0;
+    double holidaySalary = 0.0;
+    double bonuses = 0.0;
+    double allowances = 0.0;
+    double deductions = 0.0;
+    double totalSalary = 0.0;
+};
+
+/**
+ * @class SalaryKernel
+ * @brief Tính lương theo giờ công, phúc lợi và lương ròng cho cả một nhóm nhân viên cùng đơn giá.
+ *
+ * Với mỗi nhân viên i (các phép làm tròn giống Money::forSeconds() và Money::fromDouble()):
+ * - lương giờ thường/tăng ca/ngày lễ = làm tròn(giây * đơn giá / 3600) (0 nếu !paysHours);
+ * - thưởng = bonusEligible * bonusAmount + fixedBonuses;
+ * - phụ cấp = làm tròn(distanceKm * ratePerKm) + fixedAllowances;
+ * - khấu trừ = làm tròn(insuranceBase * insuranceRate) + fixedDeductions;
+ * - lương ròng = lương cơ bản + các phần theo giờ + thưởng + phụ cấp - khấu trừ
+ *   (khi !paysHours: lương làm việc = lương cơ bản, không có phần theo giờ).
+ *
+ * compute() chọn lúc chạy nhánh AVX2 (4 nhân viên mỗi lệnh) nếu CPU và hệ điều hành hỗ trợ,
+ * nếu không thì dùng computeScalar(). Hai nhánh dùng đúng các phép toán IEEE như nhau (nhân,
+ * chia, cộng, làm tròn xuống; không dùng FMA) nên kết quả giống hệt từng bit; các tổng là tổng
+ * các số nguyên chính xác nên không phụ thuộc thứ tự cộng.
+ */
+class SalaryKernel {
+public:
+    /**
+     * @brief Tính các thành phần lương của `count` nhân viên bằng nhánh nhanh nhất được hỗ trợ.
+     * @param input Dữ liệu đầu vào theo cột.
+     * @param count Số nhân viên.
+     * @param rates Tham số của nhóm.
+     * @param output Kết quả theo cột; truyền nullptr nếu chỉ cần tổng.
+     * @param totals Tổng của nhóm (được ghi đè).
+     */
+    static void compute(const SalaryKernelInput& input, std::size_t count, const SalaryKernelRates& rates,
+                        const SalaryKernelOutput* output, SalaryKernelTotals& totals);
+
+    /**
+     * @brief Phiên bản vô hướng (từng nhân viên) của compute(), dùng làm chuẩn đối chiếu.
+     */
+    static void computeScalar(const SalaryKernelInput& input, std::size_t count, const SalaryKernelRates& rates,
+                              const SalaryKernelOutput* output, SalaryKernelTotals& totals);
+
+    /**
+     * @brief Phiên bản AVX2 của compute(). Chỉ được gọi khi hasAvx2() là true.
+     */
+    static void computeAvx2(const SalaryKernelInput& input, std::size_t count, const SalaryKernelRates& rates,
+                            const SalaryKernelOutput* output, SalaryKernelTotals& totals);
+
+    /**
+     * @brief Kiểm tra (một lần, lúc chạy) CPU có AVX2 và hệ điều hành lưu thanh ghi YMM khi chuyển luồng.
+     */
+    static bool hasAvx2();
+};
+
+#endif // SALARY_KERNEL_H
@@ -35,13 +35,13 @@ const WelfareDetails& SocialInsuranceWelfare::getDetails() const
  * @param employee Tham chiếu hằng đến đối tượng IEmployee.
  * @return Giá trị tác động lên lương (thường là số âm).
  */
-double SocialInsuranceWelfare::calculateImpact(const IEmployee& employee) const
+Money SocialInsuranceWelfare::calculateImpact(const IEmployee& employee) const
 {
     // Sử dụng getBaseSalary() để lấy lương cơ bản của nhân viên để tính BHXH
-    double salaryForSI = employee.getBaseSalary();
+    Money salaryForSI = Money::fromDouble(employee.getBaseSalary());
 
-    // Tác động đến lương nhân viên là khoản trừ đi
-    double impact = -(salaryForSI * employeeContributionRate);
+    // Tác động đến lương nhân viên là khoản trừ đi (làm tròn tới đồng, nửa đồng ra xa số 0)
+    Money impact = -salaryForSI.scaled(employeeContributionRate);
 
     return impact; // Trả về tác động đến lương nhân viên
 }
@@ -65,4 +65,13 @@ bool SocialInsuranceWelfare::isEligible(const IEmployee& employee, const Attenda
     return (monthsWorked >= 6); //
     // Hoặc nếu bạn muốn một ngưỡng khác, ví dụ 3 tháng:
     // return (monthsWorked >= 3);
+}
+
+/**
+ * @brief Kiểm tra điều kiện tham gia BHXH từ số liệu chấm công tổng hợp.
+ *
+ * Điều kiện không phụ thuộc vào chấm công nên giống hệt hàm isEligible ở trên.
+ */
+bool SocialInsuranceWelfare::isEligible(const IEmployee& employee, const AttendanceSummary&) const {
+    return (employee.getMonthsWorked() >= 6);
 }
\ No newline at end of file
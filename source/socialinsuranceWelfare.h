@@ -30,6 +30,18 @@ public:
      */
     SocialInsuranceWelfare(double employeeRate);
 
+    /**
+     * @brief Lấy tỷ lệ đóng góp BHXH của nhân viên.
+     * @return Tỷ lệ (ví dụ: 0.105 cho 10.5%).
+     */
+    double getEmployeeContributionRate() const { return employeeContributionRate; }
+
+    /**
+     * @brief Đặt lại tỷ lệ đóng góp BHXH của nhân viên (khi tải lại bảng đơn giá).
+     * @param employeeRate Tỷ lệ (ví dụ: 0.105 cho 10.5%).
+     */
+    void setEmployeeContributionRate(double employeeRate) { employeeContributionRate = employeeRate; }
+
     /**
      * @brief Lấy thông tin chi tiết (tên, mô tả, loại) của phúc lợi Bảo hiểm xã hội.
      * @return Tham chiếu hằng đến đối tượng WelfareDetails.
@@ -43,7 +55,7 @@ public:
      * @param employee Tham chiếu hằng đến đối tượng IEmployee để lấy thông tin lương cơ bản.
      * @return Số tiền khấu trừ BHXH (giá trị này sẽ là số âm).
      */
-    double calculateImpact(const IEmployee& employee) const override;
+    Money calculateImpact(const IEmployee& employee) const override;
 
     /**
      * @brief Kiểm tra xem nhân viên có đủ điều kiện tham gia/đóng BHXH hay không cho một kỳ lương cụ thể.
@@ -55,6 +67,15 @@ public:
      * @return true nếu nhân viên đủ điều kiện, false nếu ngược lại.
      */
     bool isEligible(const IEmployee& employee, const AttendanceManager& attendanceManager, int month, int year) const override;
+
+    /**
+     * @brief Kiểm tra điều kiện tham gia BHXH khi đã có số liệu chấm công tổng hợp.
+     * Điều kiện chỉ phụ thuộc vào thâm niên nên giống hệt hàm trên.
+     * @param employee Tham chiếu hằng đến đối tượng IEmployee cần kiểm tra.
+     * @param summary Số liệu chấm công tổng hợp (không được sử dụng trong logic này).
+     * @return true nếu nhân viên đủ điều kiện, false nếu ngược lại.
+     */
+    bool isEligible(const IEmployee& employee, const AttendanceSummary& summary) const override;
 };
 
 #endif // _SOCIAL_INSURANCE_WELFARE_H_
\ No newline at end of file
@@ -0,0 +1,140 @@
+﻿#include "ThreadPool.h"
+#include <exception>
+
+namespace {
+
+    /// @brief Nhóm luồng mà luồng hiện tại thuộc về (nullptr nếu không phải luồng làm việc).
+    thread_local const void* t_currentPool = nullptr;
+
+    /// @brief Chỉ số của luồng hiện tại trong nhóm của nó.
+    thread_local unsigned t_currentIndex = 0;
+
+} // namespace
+
+/**
+ * @brief Tính số luồng thực tế từ giá trị cấu hình.
+ */
+unsigned ThreadPool::resolveThreadCount(unsigned requested) {
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested == 0 ? 1 : requested;
+}
+
+/**
+ * @brief Khởi tạo các hàng đợi và các luồng làm việc.
+ */
+ThreadPool::ThreadPool(unsigned threadCount) {
+    threadCount = resolveThreadCount(threadCount);
+    _queues.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        _queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    _workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Chờ các công việc còn lại rồi dừng các luồng.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Đưa một công việc vào hàng đợi của luồng hiện tại hoặc hàng đợi kế tiếp.
+ */
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> result = packaged->get_future();
+
+    const unsigned index = (t_currentPool == this)
+        ? t_currentIndex
+        : _nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned>(_queues.size());
+    {
+        // Tăng bộ đếm dưới khóa ngủ trước khi thêm công việc: luồng đang chờ không thể bỏ lỡ tín hiệu,
+        // và bộ đếm không bao giờ nhỏ hơn số công việc thực có trong các hàng đợi.
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.emplace_back([packaged] { (*packaged)(); });
+    }
+    _condition.notify_one();
+    return result;
+}
+
+/**
+ * @brief Chạy song song một vòng lặp chia đoạn và chờ hoàn tất.
+ */
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body) {
+    if (grain == 0) grain = 1;
+    std::vector<std::future<void>> futures;
+    futures.reserve((count + grain - 1) / grain);
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+        const std::size_t end = (count - begin > grain) ? begin + grain : count;
+        futures.push_back(submit([&body, begin, end] { body(begin, end); }));
+    }
+    // Chờ hết mọi đoạn trước khi ném lại ngoại lệ (các đoạn còn chạy đang tham chiếu tới body)
+    std::exception_ptr firstError;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!firstError) firstError = std::current_exception();
+        }
+    }
+    if (firstError) std::rethrow_exception(firstError);
+}
+
+/**
+ * @brief Lấy công việc của chính luồng, nếu hết thì lấy trộm từ luồng khác.
+ */
+bool ThreadPool::takeTask(unsigned index, std::function<void()>& task) {
+    const unsigned count = static_cast<unsigned>(_queues.size());
+    for (unsigned offset = 0; offset < count; ++offset) {
+        WorkerQueue& queue = *_queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        if (offset == 0) { // Hàng đợi của mình: lấy công việc mới nhất
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {           // Lấy trộm: lấy công việc cũ nhất
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Vòng lặp lấy và thực thi công việc của mỗi luồng.
+ */
+void ThreadPool::workerLoop(unsigned index) {
+    t_currentPool = this;
+    t_currentIndex = index;
+    while (true) {
+        std::function<void()> task;
+        if (takeTask(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _condition.wait(lock, [this] { return _stopping || _pending.load(std::memory_order_relaxed) > 0; });
+        if (_stopping && _pending.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+﻿#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ThreadPool.h
+ * @brief Định nghĩa lớp ThreadPool, một nhóm luồng cố định dùng để chạy song song các công việc.
+ */
+
+/**
+ * @class ThreadPool
+ * @brief Nhóm luồng làm việc theo kiểu "work stealing": mỗi luồng có một hàng đợi riêng.
+ *
+ * Công việc đưa vào từ bên ngoài được chia vòng tròn cho các hàng đợi; công việc được đưa vào
+ * từ chính một luồng của nhóm nằm trong hàng đợi của luồng đó. Mỗi luồng lấy công việc mới
+ * nhất trong hàng đợi của mình (LIFO, dữ liệu còn "nóng" trong cache); khi hết việc, nó "lấy
+ * trộm" công việc cũ nhất (FIFO) từ hàng đợi của các luồng khác, nên các phần việc có thời gian
+ * chạy chênh lệch vẫn được chia đều mà không tranh chấp một khóa chung.
+ *
+ * Các công việc được đưa vào bằng submit() và trả về std::future để chờ kết quả
+ * (ngoại lệ phát sinh trong công việc được chuyển tiếp qua future). Destructor chờ
+ * mọi công việc còn lại hoàn tất rồi mới dừng các luồng.
+ */
+class ThreadPool {
+private:
+    /**
+     * @struct WorkerQueue
+     * @brief Hàng đợi công việc riêng của một luồng (có khóa riêng).
+     */
+    struct WorkerQueue {
+        std::mutex mutex;                           ///< @brief Khóa bảo vệ hàng đợi.
+        std::deque<std::function<void()>> tasks;    ///< @brief Công việc chờ xử lý (chủ lấy ở cuối, luồng khác lấy ở đầu).
+    };
+
+    std::vector<std::thread> _workers;                  ///< @brief Các luồng làm việc.
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;  ///< @brief Hàng đợi của từng luồng (cùng chỉ số với _workers).
+    std::atomic<std::size_t> _pending{ 0 };             ///< @brief Số công việc đã đưa vào nhưng chưa được lấy ra.
+    std::atomic<unsigned> _nextQueue{ 0 };              ///< @brief Hàng đợi nhận công việc tiếp theo từ bên ngoài (vòng tròn).
+    std::mutex _sleepMutex;                             ///< @brief Khóa đi kèm _condition.
+    std::condition_variable _condition;                 ///< @brief Báo hiệu có công việc mới hoặc yêu cầu dừng.
+    bool _stopping = false;                             ///< @brief Cờ yêu cầu dừng nhóm luồng.
+
+    /**
+     * @brief Vòng lặp của mỗi luồng: lấy công việc (của mình hoặc lấy trộm) và thực thi.
+     * @param index Chỉ số của luồng (và hàng đợi riêng của nó).
+     */
+    void workerLoop(unsigned index);
+
+    /**
+     * @brief Lấy một công việc: trước hết ở cuối hàng đợi của luồng `index`, sau đó ở đầu hàng đợi các luồng khác.
+     * @return true nếu lấy được công việc.
+     */
+    bool takeTask(unsigned index, std::function<void()>& task);
+
+public:
+    /**
+     * @brief Constructor, khởi tạo nhóm luồng.
+     * @param threadCount Số luồng. Giá trị 0 nghĩa là dùng std::thread::hardware_concurrency().
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    /**
+     * @brief Destructor, chờ các công việc còn lại và dừng toàn bộ luồng.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Lấy số luồng làm việc của nhóm.
+     */
+    unsigned size() const { return static_cast<unsigned>(_workers.size()); }
+
+    /**
+     * @brief Đưa một công việc vào hàng đợi.
+     * @param task Công việc cần thực thi.
+     * @return std::future để chờ công việc hoàn tất.
+     */
+    std::future<void> submit(std::function<void()> task);
+
+    /**
+     * @brief Chạy `body(begin, end)` song song trên các đoạn [begin, end) liên tiếp của [0, count).
+     * Mỗi đoạn có `grain` phần tử (đoạn cuối có thể ít hơn); các đoạn được chia cho các luồng và
+     * cân bằng bằng cơ chế lấy trộm. Hàm chờ mọi đoạn hoàn tất; ngoại lệ đầu tiên (theo thứ tự đoạn)
+     * được ném lại. Không gọi hàm này từ bên trong một công việc của chính nhóm luồng.
+     * @param count Số phần tử.
+     * @param grain Số phần tử mỗi đoạn (0 được coi là 1).
+     * @param body Hàm xử lý một đoạn.
+     */
+    void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+
+    /**
+     * @brief Tính số luồng thực tế từ giá trị cấu hình (0 = theo số lõi CPU, tối thiểu 1).
+     */
+    static unsigned resolveThreadCount(unsigned requested);
+};
+
+#endif // THREAD_POOL_H
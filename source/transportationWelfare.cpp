@@ -47,37 +47,40 @@ const WelfareDetails& TransportationWelfare::getDetails() const
  * @param employee Tham chiếu hằng đến đối tượng IEmployee.
  * @return Giá trị tác động lên lương (số tiền phụ cấp).
  */
-double TransportationWelfare::calculateImpact(const IEmployee& employee) const
+Money TransportationWelfare::calculateImpact(const IEmployee& employee) const
+{
+    // Tác động đến lương nhân viên là khoản cộng thêm
+    // Công thức tính phúc lợi: tỷ lệ trên mỗi km * khoảng cách (0 nếu không tìm thấy khoảng cách)
+    // (làm tròn tới đồng, nửa đồng ra xa số 0)
+    Money impact = Money::fromDouble(ratePerKm * getDistanceKm(employee));
+
+    return impact; // Trả về giá trị phúc lợi
+}
+
+/**
+ * @brief Tra khoảng cách từ địa chỉ của nhân viên đến công ty.
+ *
+ * @param employee Tham chiếu hằng đến đối tượng IEmployee.
+ * @return Khoảng cách (km); 0 nếu địa chỉ không thuộc khu vực nào đã biết.
+ */
+double TransportationWelfare::getDistanceKm(const IEmployee& employee) const
 {
     // Giả sử công ty ở Thành phố Thủ Đức (Tp.HCM)
-    double employeeDistance = 0.0;
     std::string employeeAddress = employee.getAddress(); // Lấy địa chỉ của nhân viên
 
     // Tìm kiếm khoảng cách dựa trên địa chỉ của nhân viên
     // Hàm này sẽ kiểm tra xem địa chỉ của nhân viên có chứa tên của bất kỳ vùng lân cận nào không.
-    bool found = false;
     for (const auto& pair : distancesToThuDuc)
     {
         // Kiểm tra xem địa chỉ nhân viên có chứa tên vùng lân cận không
         // Sử dụng find để tìm kiếm chuỗi con, không phân biệt hoa thường nếu cần
         if (employeeAddress.find(pair.first) != std::string::npos)
         {
-            employeeDistance = pair.second;
-            found = true;
-            break; // Tìm thấy khớp, thoát vòng lặp
+            return pair.second; // Tìm thấy khớp
         }
     }
 
-    if (!found)
-    {
-        return 0.0; // Trả về 0 nếu không tìm thấy khoảng cách
-    }
-
-    // Tác động đến lương nhân viên là khoản cộng thêm
-    // Công thức tính phúc lợi: tỷ lệ trên mỗi km * khoảng cách
-    double impact = ratePerKm * employeeDistance;
-
-    return impact; // Trả về giá trị phúc lợi
+    return 0.0; // Trả về 0 nếu không tìm thấy khoảng cách
 }
 
 /**
@@ -94,4 +97,13 @@ bool TransportationWelfare::isEligible(const IEmployee& employee, const Attendan
     // (void)month;
     // (void)year;
     return true; // Giả sử mọi nhân viên đều được
+}
+
+/**
+ * @brief Kiểm tra điều kiện nhận Phụ cấp đi lại từ số liệu chấm công tổng hợp.
+ *
+ * @return true (giống hàm isEligible ở trên, mọi nhân viên đều được).
+ */
+bool TransportationWelfare::isEligible(const IEmployee&, const AttendanceSummary&) const {
+    return true;
 }
\ No newline at end of file
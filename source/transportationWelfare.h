@@ -35,6 +35,25 @@ public:
      */
     TransportationWelfare(double rate);
 
+    /**
+     * @brief Lấy mức phụ cấp trên mỗi km.
+     * @return Số tiền trên mỗi km (đồng).
+     */
+    double getRatePerKm() const { return ratePerKm; }
+
+    /**
+     * @brief Đặt lại mức phụ cấp trên mỗi km (khi tải lại bảng đơn giá).
+     * @param rate Số tiền trên mỗi km (đồng).
+     */
+    void setRatePerKm(double rate) { ratePerKm = rate; }
+
+    /**
+     * @brief Tra khoảng cách từ địa chỉ của nhân viên đến công ty.
+     * @param employee Tham chiếu hằng đến đối tượng IEmployee.
+     * @return Khoảng cách (km) của khu vực đầu tiên có tên nằm trong địa chỉ; 0 nếu không tìm thấy.
+     */
+    double getDistanceKm(const IEmployee& employee) const;
+
     /**
      * @brief Lấy thông tin chi tiết (tên, mô tả, loại) của phúc lợi Phụ cấp đi lại.
      * @return Tham chiếu hằng đến đối tượng WelfareDetails.
@@ -51,7 +70,7 @@ public:
      * @param employee Tham chiếu hằng đến đối tượng IEmployee.
      * @return Giá trị tác động lên lương (thường là số dương).
      */
-    double calculateImpact(const IEmployee& employee) const override;
+    Money calculateImpact(const IEmployee& employee) const override;
 
     /**
      * @brief Kiểm tra xem nhân viên có đủ điều kiện nhận Phụ cấp đi lại hay không.
@@ -60,6 +79,15 @@ public:
      * @return true nếu nhân viên đủ điều kiện, false ngược lại.
      */
     bool isEligible(const IEmployee& employee, const AttendanceManager& attendanceManager, int month, int year) const override;
+
+    /**
+     * @brief Kiểm tra điều kiện nhận Phụ cấp đi lại khi đã có số liệu chấm công tổng hợp.
+     *
+     * @param employee Tham chiếu hằng đến đối tượng IEmployee.
+     * @param summary Số liệu chấm công tổng hợp (không được sử dụng).
+     * @return true nếu nhân viên đủ điều kiện, false ngược lại.
+     */
+    bool isEligible(const IEmployee& employee, const AttendanceSummary& summary) const override;
 };
 
 #endif // _TRANSPORTATION_WELFARE_H_
\ No newline at end of file
@@ -1,7 +1,6 @@
 ﻿#include "WelfareManager.h"
 #include "IEmployee.h"
 #include <stdexcept>
-#include <cmath> // Để dùng std::abs
 
 /**
  * @brief Thêm một phúc lợi mới vào danh sách quản lý.
@@ -18,24 +17,74 @@ void WelfareManager::addWelfare(std::unique_ptr<IWelfare> welfare) {
 /**
  * @brief Tính toán và phân loại tất cả các phúc lợi cho một nhân viên.
  */
-void WelfareManager::calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceManager& attendanceManager, int targetMonth, int targetYear, double& outBonuses, double& outAllowances, double& outDeductions) const {
-    outBonuses = 0.0; //
-    outAllowances = 0.0; //
-    outDeductions = 0.0; //
+void WelfareManager::calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceManager& attendanceManager, int targetMonth, int targetYear, Money& outBonuses, Money& outAllowances, Money& outDeductions) const {
+    outBonuses = Money(); //
+    outAllowances = Money(); //
+    outDeductions = Money(); //
 
     for (const auto& welfare : _welfareList) { //
         // Truyền targetMonth, targetYear vào isEligible
         if (welfare && welfare->isEligible(employee, attendanceManager, targetMonth, targetYear)) { //
-            double impact = welfare->calculateImpact(employee); //
-            if (impact > 0) { //
-                if (welfare->getDetails().type == WelfareType::Bonus) { //
-                    outBonuses += impact; //
-                } else {
-                    outAllowances += impact; //
-                }
-            } else if (impact < 0) { //
-                outDeductions += std::abs(impact); //
+            addImpact(*welfare, welfare->calculateImpact(employee), outBonuses, outAllowances, outDeductions);
+        }
+    }
+}
+
+/**
+ * @brief Tính toán và phân loại tất cả các phúc lợi cho một nhân viên từ số liệu chấm công tổng hợp.
+ */
+void WelfareManager::calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceSummary& summary, Money& outBonuses, Money& outAllowances, Money& outDeductions) const {
+    outBonuses = Money();
+    outAllowances = Money();
+    outDeductions = Money();
+
+    // Cùng thứ tự phúc lợi với hàm trên nên các tổng được cộng theo cùng thứ tự (kết quả giống hệt)
+    for (const auto& welfare : _welfareList) {
+        if (welfare && welfare->isEligible(employee, summary)) {
+            addImpact(*welfare, welfare->calculateImpact(employee), outBonuses, outAllowances, outDeductions);
+        }
+    }
+}
+
+/**
+ * @brief Tính phúc lợi từ số liệu tổng hợp, dùng lại các tác động đã tính.
+ */
+void WelfareManager::calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceSummary& summary, WelfareImpactCache& cache, Money& outBonuses, Money& outAllowances, Money& outDeductions) const {
+    outBonuses = Money();
+    outAllowances = Money();
+    outDeductions = Money();
+
+    for (std::size_t i = 0; i < _welfareList.size(); ++i) {
+        const auto& welfare = _welfareList[i];
+        if (welfare && welfare->isEligible(employee, summary)) {
+            if (!cache.known[i]) {
+                cache.impacts[i] = welfare->calculateImpact(employee);
+                cache.known[i] = 1;
             }
+            addImpact(*welfare, cache.impacts[i], outBonuses, outAllowances, outDeductions);
+        }
+    }
+}
+
+/**
+ * @brief Làm rỗng bộ nhớ tác động.
+ */
+void WelfareManager::resetImpactCache(WelfareImpactCache& cache) const {
+    cache.impacts.resize(_welfareList.size());
+    cache.known.assign(_welfareList.size(), 0);
+}
+
+/**
+ * @brief Cộng tác động của một phúc lợi vào đúng loại.
+ */
+void WelfareManager::addImpact(const IWelfare& welfare, Money impact, Money& outBonuses, Money& outAllowances, Money& outDeductions) {
+    if (impact > Money()) { //
+        if (welfare.getDetails().type == WelfareType::Bonus) { //
+            outBonuses += impact; //
+        } else {
+            outAllowances += impact; //
         }
+    } else if (impact < Money()) { //
+        outDeductions += impact.abs(); //
     }
 }
\ No newline at end of file
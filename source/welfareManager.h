@@ -8,6 +8,19 @@
 // Khai báo chuyển tiếp để tránh include vòng lặp
 class IEmployee;
 
+/**
+ * @struct WelfareImpactCache
+ * @brief Tác động đã tính của từng phúc lợi cho một nhân viên, dùng lại qua nhiều kỳ lương.
+ *
+ * IWelfare::calculateImpact() chỉ phụ thuộc vào nhân viên (không phụ thuộc kỳ lương), nên khi tính
+ * nhiều tháng liên tiếp cho cùng một nhân viên (PayrollEngine::calculateYear()) mỗi tác động chỉ
+ * cần tính một lần, ở tháng đầu tiên nhân viên đủ điều kiện.
+ */
+struct WelfareImpactCache {
+    std::vector<Money> impacts;      ///< @brief Tác động theo vị trí phúc lợi trong danh sách.
+    std::vector<unsigned char> known; ///< @brief 1 nếu tác động ở vị trí tương ứng đã được tính.
+};
+
 /**
  * @class WelfareManager
  * @brief Lớp quản lý danh sách các phúc lợi và tính toán tác động của chúng.
@@ -21,6 +34,12 @@ private:
     // Sử dụng con trỏ thông minh để tự động quản lý bộ nhớ của các đối tượng phúc lợi
     std::vector<std::unique_ptr<IWelfare>> _welfareList;
 
+    /**
+     * @brief Cộng tác động của một phúc lợi (nhân viên đã đủ điều kiện) vào đúng loại:
+     * thưởng, phụ cấp (giá trị dương) hoặc khấu trừ (giá trị âm).
+     */
+    static void addImpact(const IWelfare& welfare, Money impact, Money& outBonuses, Money& outAllowances, Money& outDeductions);
+
 public:
     /**
      * @brief Constructor mặc định.
@@ -33,6 +52,12 @@ public:
      */
     void addWelfare(std::unique_ptr<IWelfare> welfare);
 
+    /**
+     * @brief Lấy danh sách phúc lợi (theo thứ tự được thêm vào).
+     * @return Tham chiếu hằng đến danh sách phúc lợi.
+     */
+    const std::vector<std::unique_ptr<IWelfare>>& getWelfareList() const { return _welfareList; }
+
     /**
      * @brief Tính toán tổng các khoản thưởng, phụ cấp, và khấu trừ cho một nhân viên.
      *
@@ -44,7 +69,39 @@ public:
      * @param outAllowances Tham chiếu đến biến để lưu tổng tiền phụ cấp.
      * @param outDeductions Tham chiếu đến biến để lưu tổng tiền khấu trừ.
      */
-    void calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceManager& attendanceManager, int month, int year, double& outBonuses, double& outAllowances, double& outDeductions) const;
+    void calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceManager& attendanceManager, int month, int year, Money& outBonuses, Money& outAllowances, Money& outDeductions) const;
+
+    /**
+     * @brief Tính toán tổng các khoản thưởng, phụ cấp, và khấu trừ cho một nhân viên
+     * từ số liệu chấm công tổng hợp của kỳ lương (dùng khi tính lương hàng loạt).
+     * Kết quả giống hệt hàm trên với summary = attendanceManager.summarize(...) của cùng kỳ.
+     *
+     * @param employee Nhân viên cần tính phúc lợi.
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @param outBonuses Tham chiếu đến biến để lưu tổng tiền thưởng.
+     * @param outAllowances Tham chiếu đến biến để lưu tổng tiền phụ cấp.
+     * @param outDeductions Tham chiếu đến biến để lưu tổng tiền khấu trừ.
+     */
+    void calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceSummary& summary, Money& outBonuses, Money& outAllowances, Money& outDeductions) const;
+
+    /**
+     * @brief Như hàm trên nhưng dùng lại các tác động đã tính trong `cache` (kết quả giống hệt).
+     * Gọi resetImpactCache() trước khi chuyển sang nhân viên khác.
+     *
+     * @param employee Nhân viên cần tính phúc lợi.
+     * @param summary Số liệu chấm công tổng hợp của nhân viên trong kỳ lương.
+     * @param cache Tác động đã tính của nhân viên này (được bổ sung khi cần).
+     * @param outBonuses Tham chiếu đến biến để lưu tổng tiền thưởng.
+     * @param outAllowances Tham chiếu đến biến để lưu tổng tiền phụ cấp.
+     * @param outDeductions Tham chiếu đến biến để lưu tổng tiền khấu trừ.
+     */
+    void calculateAllWelfareForEmployee(const IEmployee& employee, const AttendanceSummary& summary, WelfareImpactCache& cache, Money& outBonuses, Money& outAllowances, Money& outDeductions) const;
+
+    /**
+     * @brief Làm rỗng bộ nhớ tác động (đủ chỗ cho mọi phúc lợi hiện có).
+     * @param cache Bộ nhớ tác động cần làm rỗng.
+     */
+    void resetImpactCache(WelfareImpactCache& cache) const;
 };
 
 #endif // WELFARE_MANAGER_H
\ No newline at end of file
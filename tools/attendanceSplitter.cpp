@@ -0,0 +1,38 @@
+﻿/**
+ * @file attendanceSplitter.cpp
+ * @brief Công cụ chuyển đổi một lần: chia file attendance.csv thành các file theo tháng
+ * (`attendance/YYYY-MM.csv`) để ứng dụng chỉ đọc dữ liệu của kỳ lương cần tính.
+ *
+ * Cách dùng (chạy trong thư mục chứa attendance.csv):
+ *   attendanceSplitter [attendance.csv] [thu_muc_dich]
+ *
+ * Sau khi chia, ứng dụng tự dùng thư mục `attendance/` nếu thư mục này tồn tại; dữ liệu chấm công
+ * mới cần được ghi vào file của tháng tương ứng thay vì attendance.csv. Nếu attendance.csv vẫn bị sửa
+ * sau lần chia (khác kích thước/thời điểm sửa đổi ghi trong `attendance/source.stamp`), ứng dụng cảnh báo
+ * và quay lại đọc attendance.csv cho tới khi công cụ này được chạy lại.
+ *
+ * Biên dịch cùng các file trong thư mục source/, ví dụ:
+ *   cl /O2 /std:c++17 /EHsc /I..\source attendanceSplitter.cpp ..\source\attendancePartitions.cpp
+ *      ..\source\attendanceParser.cpp ..\source\mappedFile.cpp
+ */
+
+#include "../source/attendancePartitions.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string sourceFile = (argc >= 2) ? argv[1] : "attendance.csv";
+    std::string directory = (argc >= 3) ? argv[2] : AttendancePartitions::DEFAULT_DIRECTORY;
+
+    PartitionSplitReport report;
+    if (!AttendancePartitions::split(sourceFile, directory, report)) {
+        return 1;
+    }
+    std::cout << "Da chia " << report.recordCount << " dong cua " << sourceFile << " thanh "
+              << report.partitionCount << " file theo thang trong thu muc " << directory << "\n";
+    if (report.invalidCount > 0) {
+        std::cout << "CANH BAO: " << report.invalidCount << " dong co ngay khong hop le duoc ghi vao "
+                  << directory << "/" << AttendancePartitions::INVALID_FILE << "\n";
+    }
+    return 0;
+}